@@ -0,0 +1,772 @@
+/* Copyright (C) 2018 Matthias Vogelgesang <matthias.vogelgesang@kit.edu>
+   (Karlsruhe Institute of Technology)
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+   FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+   details.
+
+   You should have received a copy of the GNU Lesser General Public License along
+   with this library; if not, write to the Free Software Foundation, Inc., 51
+   Franklin St, Fifth Floor, Boston, MA 02110, USA */
+
+/**
+ * @file
+ * @brief Differential test and throughput benchmark of the unpacking kernels.
+ *
+ * First every unpacking kernel supported by the CPU (see "UNPACKING KERNELS" in the plugin) is compared with a plain
+ * bit by bit decoder, which does not share any code with the kernels:
+ *
+ * - Every amount of groups up to CHECK_MAX_GROUPS, with random data and with edge case patterns (all bits cleared,
+ *   all bits set, alternating bits, a walking bit and counting bytes).
+ * - Whole frames of every ROI, unpacked the way the 10G unpack thread does it (unpack_image_p10, unpack_image_p12l),
+ *   which includes the incomplete last group of ROIs, whose amount of pixels is not a multiple of 8. Also with the
+ *   correction, which is applied to a few groups at a time, with both outputs, and with a decode pool of 3 threads,
+ *   which unpack the frame in stripes.
+ * - The dark/flat correction kernels, with 16 bit and float output, for every amount of pixels up to
+ *   CHECK_MAX_GROUPS. These have to match the scalar kernels exactly, rounding and clamping included.
+ * - The conversion of float frames for "grab", which has to deliver exactly the 16 bit corrected frame.
+ *
+ * The input is placed directly in front of a page without any access rights and the output directly behind the end of
+ * its buffer in front of another one. Thus a kernel, which reads beyond the end of the data (like a 16 byte load of
+ * the last 10 byte group) or writes more pixels than requested, crashes the program instead of passing unnoticed.
+ *
+ * Afterwards the unpacking of whole frames is timed for every ROI, format and kernel, optionally with the correction
+ * ("--correction u16" or "--correction f32", with random reference frames) and for every amount of decode threads
+ * ("--decode-threads", see "PARALLEL DECODING"), to measure how the decoding scales with the cores. The data rate
+ * refers to the packed input. The pixels per cycle are measured with the CPU cycle counter of perf, if the kernel allows it
+ * (perf_event_paranoid), and otherwise with the time stamp counter, which counts at the nominal frequency.
+ *
+ * The plugin source is being included directly, because the kernels are not part of the public interface. The program
+ * exits with 1, if any kernel does not match the reference.
+ *
+ * Example:
+ *
+ *      unpack-kernels --roi 2048x1952 --format p10 --unpack-kernel avx2 --unpack-kernel scalar
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Added the correction kernels.
+ *
+ * Changed 17.10.2026
+ * Added the decode pool.
+ *
+ * Changed 17.10.2026
+ * Added the conversion of float frames for "grab".
+ */
+
+#define _GNU_SOURCE
+
+#include "uca-phantom-camera.c"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+
+// The amount of groups of 8 pixels, up to which every single length is being checked. This covers every remainder,
+// which the vectorized kernels leave to the next smaller kernel, several times.
+#define CHECK_MAX_GROUPS        300
+
+/**
+ * @brief A buffer, which ends directly in front of an inaccessible page
+ */
+struct guarded_buffer {
+    guint8 *map;
+    gsize map_size;
+    guint8 *data;
+};
+
+/**
+ * @brief The cycle counter used for the pixels per cycle
+ */
+struct cycle_counter {
+    gint fd;
+    const gchar *name;
+};
+
+/**
+ * @brief A pattern of input bytes for the differential test
+ */
+struct pattern {
+    const gchar *name;
+    guint8 (*byte) (gsize index);
+};
+
+
+static gchar **roi_strings = NULL;
+static gchar **format_strings = NULL;
+static gchar **kernel_strings = NULL;
+static gdouble duration = 0.5;
+static gint seed = 1;
+static gboolean check_only = FALSE;
+static gchar *correction_string = NULL;
+static gchar **thread_strings = NULL;
+
+static GOptionEntry entries[] = {
+    { "roi", 0, 0, G_OPTION_ARG_STRING_ARRAY, &roi_strings, "ROI to test, can be repeated (default: 2048x1952, 1280x800, 640x480, 1001x601, 127x3)", "WxH" },
+    { "format", 0, 0, G_OPTION_ARG_STRING_ARRAY, &format_strings, "p10, p12l or p8, can be repeated (default: all)", "FORMAT" },
+    { "unpack-kernel", 'k', 0, G_OPTION_ARG_STRING_ARRAY, &kernel_strings, "avx512, avx2, ssse3 or scalar, can be repeated (default: all supported)", "KERNEL" },
+    { "time", 't', 0, G_OPTION_ARG_DOUBLE, &duration, "Seconds per measurement (default: 0.5)", "SECONDS" },
+    { "seed", 0, 0, G_OPTION_ARG_INT, &seed, "Seed of the random test data (default: 1)", "N" },
+    { "check-only", 'c', 0, G_OPTION_ARG_NONE, &check_only, "Only compare the kernels with the reference", NULL },
+    { "correction", 0, 0, G_OPTION_ARG_STRING, &correction_string, "Measure with the dark/flat correction, u16 or f32 (default: none)", "OUTPUT" },
+    { "decode-threads", 'j', 0, G_OPTION_ARG_STRING_ARRAY, &thread_strings, "Threads decoding each frame, can be repeated (default: 1)", "N" },
+    { NULL }
+};
+
+static GRand *random_bytes = NULL;
+
+static guint8 pattern_random (gsize index)      { (void) index; return g_rand_int (random_bytes) & 0xff; }
+static guint8 pattern_zeros (gsize index)       { (void) index; return 0x00; }
+static guint8 pattern_ones (gsize index)        { (void) index; return 0xff; }
+static guint8 pattern_alternating (gsize index) { (void) index; return 0xaa; }
+static guint8 pattern_inverted (gsize index)    { (void) index; return 0x55; }
+static guint8 pattern_walking (gsize index)     { return 0x80 >> (index % 7); }
+static guint8 pattern_counting (gsize index)    { return index & 0xff; }
+
+static const struct pattern patterns[] = {
+    { "random", pattern_random },
+    { "zeros", pattern_zeros },
+    { "ones", pattern_ones },
+    { "0xaa", pattern_alternating },
+    { "0x55", pattern_inverted },
+    { "walking bit", pattern_walking },
+    { "counting", pattern_counting },
+};
+
+
+/**
+ * @brief Allocates a buffer of @p size bytes, which is directly followed by an inaccessible page
+ *
+ * @param buffer
+ * @param size
+ * @return
+ */
+static gboolean
+guarded_buffer_alloc (struct guarded_buffer *buffer, gsize size)
+{
+    gsize page_size = sysconf (_SC_PAGESIZE);
+    gsize data_pages = (size + page_size - 1) / page_size;
+
+    buffer->map_size = (data_pages + 1) * page_size;
+    buffer->map = mmap (NULL, buffer->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (buffer->map == MAP_FAILED) {
+        g_printerr ("Could not allocate %" G_GSIZE_FORMAT " bytes: %s\n", size, g_strerror (errno));
+        return FALSE;
+    }
+
+    mprotect (buffer->map + data_pages * page_size, page_size, PROT_NONE);
+    buffer->data = buffer->map + data_pages * page_size - size;
+    return TRUE;
+}
+
+static void
+guarded_buffer_free (struct guarded_buffer *buffer)
+{
+    munmap (buffer->map, buffer->map_size);
+}
+
+/**
+ * @brief Decodes the pixels of a transfer format bit by bit, as the reference for the kernels
+ *
+ * P10 and P12L are a continuous stream of big endian pixels, P8 a byte per pixel. Bits beyond @p length are zero,
+ * which is what the plugin does with the last pixel, if the size of the frame is not a whole amount of bytes.
+ *
+ * @param input
+ * @param length
+ * @param output
+ * @param pixels
+ * @param bits The bits per pixel, which are the bytes of a group of 8 pixels
+ */
+static void
+unpack_reference (const guint8 *input, gsize length, guint16 *output, gsize pixels, guint bits)
+{
+    for (gsize i = 0; i < pixels; i++) {
+        guint16 value = 0;
+
+        for (gsize bit = i * bits; bit < (i + 1) * bits; bit++) {
+            guint8 byte = bit / 8 < length ? input[bit / 8] : 0;
+
+            value = (value << 1) | ((byte >> (7 - bit % 8)) & 1);
+        }
+
+        output[i] = value;
+    }
+}
+
+/**
+ * @brief Compares the kernels with the reference for every amount of groups up to CHECK_MAX_GROUPS
+ *
+ * @param kernels
+ * @param format
+ * @return
+ */
+static gboolean
+check_groups (const UnpackKernels *kernels, ImageFormat format)
+{
+    UcaPhantomCameraPrivate priv = { .format = format, .xg_unpack = kernels };
+    UnpackKernel kernel = get_unpack_kernel (&priv);
+    gsize group_size = get_unpack_group_size (format);
+    struct guarded_buffer input;
+    struct guarded_buffer output;
+    guint16 *expected;
+    guint failures = 0;
+
+    if (!guarded_buffer_alloc (&input, CHECK_MAX_GROUPS * group_size) ||
+        !guarded_buffer_alloc (&output, CHECK_MAX_GROUPS * UNPACK_GROUP_PIXELS * sizeof (guint16)))
+        return FALSE;
+
+    expected = g_new (guint16, CHECK_MAX_GROUPS * UNPACK_GROUP_PIXELS);
+
+    for (guint p = 0; p < G_N_ELEMENTS (patterns); p++) {
+        for (gsize groups = 0; groups <= CHECK_MAX_GROUPS; groups++) {
+            gsize size = groups * group_size;
+            gsize pixels = groups * UNPACK_GROUP_PIXELS;
+            // The data is moved to the end of the buffers, right in front of the inaccessible pages
+            guint8 *in = input.data + CHECK_MAX_GROUPS * group_size - size;
+            guint16 *out = (guint16 *) (output.data + (CHECK_MAX_GROUPS - groups) * UNPACK_GROUP_PIXELS * sizeof (guint16));
+
+            for (gsize i = 0; i < size; i++)
+                in[i] = patterns[p].byte (i);
+
+            memset (out, 0x5a, pixels * sizeof (guint16));
+            unpack_reference (in, size, expected, pixels, group_size);
+            kernel (in, out, groups);
+
+            if (memcmp (out, expected, pixels * sizeof (guint16)) != 0) {
+                if (failures++ < 5)
+                    g_print ("\n    %s pattern differs with %" G_GSIZE_FORMAT " groups", patterns[p].name, groups);
+            }
+        }
+    }
+
+    g_free (expected);
+    guarded_buffer_free (&input);
+    guarded_buffer_free (&output);
+    return failures == 0;
+}
+
+/**
+ * @brief Fills the reference frames of a correction with random values
+ *
+ * With @p extremes, the values cover pixels, which cannot be corrected (gain 0), ones which are darker than the dark
+ * frame and ones, which are amplified beyond 16 bits, to check the clamping. Otherwise they are like those of a real
+ * detector, where the clamping is rare, for the measurements.
+ *
+ * @param dark
+ * @param gain
+ * @param pixels
+ * @param extremes
+ */
+static void
+fill_correction (gfloat *dark, gfloat *gain, gsize pixels, gboolean extremes)
+{
+    for (gsize i = 0; i < pixels; i++) {
+        dark[i] = g_rand_double_range (random_bytes, 0.0, extremes ? 1024.0 : 32.0);
+        gain[i] = extremes ? (i % 17 == 0 ? 0.0 : g_rand_double_range (random_bytes, 0.0, 4.0)) :
+                  g_rand_double_range (random_bytes, 0.8, 1.25);
+    }
+}
+
+/**
+ * @brief Compares the correction kernels with the scalar ones for every amount of pixels up to CHECK_MAX_GROUPS
+ *
+ * @param kernels
+ * @return
+ */
+static gboolean
+check_correction (const UnpackKernels *kernels)
+{
+    gsize max_pixels = CHECK_MAX_GROUPS;
+    struct guarded_buffer output;
+    guint16 *raw = g_new (guint16, max_pixels);
+    gfloat *dark = g_new (gfloat, max_pixels);
+    gfloat *gain = g_new (gfloat, max_pixels);
+    gfloat *expected = g_new (gfloat, max_pixels);
+    guint failures = 0;
+
+    if (!guarded_buffer_alloc (&output, max_pixels * sizeof (gfloat)))
+        return FALSE;
+
+    fill_correction (dark, gain, max_pixels, TRUE);
+
+    for (gsize i = 0; i < max_pixels; i++)
+        raw[i] = i % 5 == 0 ? 0xffff : g_rand_int (random_bytes) & 0xffff;
+
+    for (gsize pixels = 0; pixels <= max_pixels; pixels++) {
+        // The output is moved to the end of the buffer, right in front of the inaccessible page
+        guint8 *out_u16 = output.data + (max_pixels - pixels) * sizeof (gfloat) + pixels * sizeof (guint16);
+        guint8 *out_f32 = output.data + (max_pixels - pixels) * sizeof (gfloat);
+
+        correct_u16_scalar (raw, dark, gain, expected, pixels);
+        kernels->correct_u16 (raw, dark, gain, out_u16, pixels);
+
+        if (memcmp (out_u16, expected, pixels * sizeof (guint16)) != 0 && failures++ < 5)
+            g_print ("\n    16 bit correction differs with %" G_GSIZE_FORMAT " pixels", pixels);
+
+        correct_f32_scalar (raw, dark, gain, expected, pixels);
+        kernels->correct_f32 (raw, dark, gain, out_f32, pixels);
+
+        if (memcmp (out_f32, expected, pixels * sizeof (gfloat)) != 0 && failures++ < 5)
+            g_print ("\n    float correction differs with %" G_GSIZE_FORMAT " pixels", pixels);
+    }
+
+    g_free (raw);
+    g_free (dark);
+    g_free (gain);
+    g_free (expected);
+    guarded_buffer_free (&output);
+    return failures == 0;
+}
+
+/**
+ * @brief Sets up the frame state of @p priv the way the 10G receive thread leaves it, after a whole frame has arrived
+ *
+ * @param priv
+ * @param input
+ * @param output
+ */
+static void
+set_received_frame (UcaPhantomCameraPrivate *priv, guint8 *input, guint16 *output)
+{
+    struct ximg_parser *parser = priv->xg_parser;
+    struct ximg_decoder *decoder = priv->xg_decoder;
+
+    decoder->in = input;
+    decoder->out = output;
+    parser->expected = get_buffer_size (priv);
+    parser->total = parser->expected;
+    parser->started_frames = decoder->unpack_frame + 1;
+    parser->received_frames = decoder->unpack_frame + 1;
+}
+
+/**
+ * @brief Unpacks the received frame with the function of the 10G unpack thread
+ *
+ * @param priv
+ */
+static void
+unpack_frame (UcaPhantomCameraPrivate *priv)
+{
+    switch (priv->format) {
+        case IMAGE_FORMAT_P10:
+            unpack_image_p10 (priv);
+            break;
+        case IMAGE_FORMAT_P12L:
+            unpack_image_p12l (priv);
+            break;
+        default:
+            unpack_image_groups (priv->xg_decoder, get_unpack_kernel (priv), get_unpack_group_size (priv->format));
+    }
+}
+
+/**
+ * @brief Compares a whole unpacked frame with the reference
+ *
+ * @param priv The ROI, format and kernels to check
+ * @return
+ */
+static gboolean
+check_frame (UcaPhantomCameraPrivate *priv)
+{
+    gsize pixels = priv->roi_width * priv->roi_height;
+    gsize size = get_buffer_size (priv);
+    struct guarded_buffer input;
+    struct guarded_buffer output;
+    guint16 *expected;
+    gboolean success;
+
+    if (!guarded_buffer_alloc (&input, size) || !guarded_buffer_alloc (&output, pixels * sizeof (guint16)))
+        return FALSE;
+
+    for (gsize i = 0; i < size; i++)
+        input.data[i] = g_rand_int (random_bytes) & 0xff;
+
+    expected = g_new (guint16, pixels);
+    unpack_reference (input.data, size, expected, pixels, get_unpack_group_size (priv->format));
+
+    set_received_frame (priv, input.data, (guint16 *) output.data);
+    unpack_frame (priv);
+
+    success = memcmp (output.data, expected, pixels * sizeof (guint16)) == 0;
+    if (!success)
+        g_print ("\n    frame %ux%u differs", priv->roi_width, priv->roi_height);
+
+    g_free (expected);
+    guarded_buffer_free (&input);
+    guarded_buffer_free (&output);
+    return success;
+}
+
+/**
+ * @brief Compares a whole unpacked and corrected frame with the reference and the scalar correction
+ *
+ * @param priv The ROI, format and kernels to check
+ * @param float_output
+ * @return
+ */
+static gboolean
+check_corrected_frame (UcaPhantomCameraPrivate *priv, gboolean float_output)
+{
+    gsize pixels = priv->roi_width * priv->roi_height;
+    gsize size = get_buffer_size (priv);
+    gsize pixel_size = float_output ? sizeof (gfloat) : sizeof (guint16);
+    struct guarded_buffer input;
+    struct guarded_buffer output;
+    guint16 *raw;
+    gpointer expected;
+    gboolean success;
+
+    if (!guarded_buffer_alloc (&input, size) || !guarded_buffer_alloc (&output, pixels * pixel_size))
+        return FALSE;
+
+    for (gsize i = 0; i < size; i++)
+        input.data[i] = g_rand_int (random_bytes) & 0xff;
+
+    priv->correction_dark = g_new (gfloat, pixels);
+    priv->correction_gain = g_new (gfloat, pixels);
+    priv->correction_float = float_output;
+    fill_correction (priv->correction_dark, priv->correction_gain, pixels, TRUE);
+
+    raw = g_new (guint16, pixels);
+    expected = g_malloc (pixels * pixel_size);
+    unpack_reference (input.data, size, raw, pixels, get_unpack_group_size (priv->format));
+
+    if (float_output)
+        correct_f32_scalar (raw, priv->correction_dark, priv->correction_gain, expected, pixels);
+    else
+        correct_u16_scalar (raw, priv->correction_dark, priv->correction_gain, expected, pixels);
+
+    set_received_frame (priv, input.data, (guint16 *) output.data);
+    unpack_frame (priv);
+
+    success = memcmp (output.data, expected, pixels * pixel_size) == 0;
+    if (!success)
+        g_print ("\n    corrected frame %ux%u (%s) differs", priv->roi_width, priv->roi_height,
+                 float_output ? "f32" : "u16");
+
+    // "grab" delivers float frames as 16 bit, into a buffer sized by "sensor-bitdepth". This has to be exactly the
+    // 16 bit correction, converted in place like for the grab callback.
+    if (float_output) {
+        correct_u16_scalar (raw, priv->correction_dark, priv->correction_gain, expected, pixels);
+        copy_frame (priv, output.data, output.data);
+
+        if (memcmp (output.data, expected, pixels * sizeof (guint16)) != 0) {
+            g_print ("\n    float frame %ux%u differs from the 16 bit correction after the conversion for grab",
+                     priv->roi_width, priv->roi_height);
+            success = FALSE;
+        }
+    }
+
+    stop_correction (priv);
+    g_free (raw);
+    g_free (expected);
+    guarded_buffer_free (&input);
+    guarded_buffer_free (&output);
+    return success;
+}
+
+/**
+ * @brief Opens the CPU cycle counter of the calling thread or falls back to the time stamp counter
+ *
+ * @param counter
+ */
+static void
+cycle_counter_open (struct cycle_counter *counter)
+{
+    struct perf_event_attr attr;
+
+    memset (&attr, 0, sizeof (attr));
+    attr.size = sizeof (attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    counter->fd = syscall (SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    counter->name = counter->fd >= 0 ? "cycles" : (UNPACK_X86 ? "TSC cycles" : NULL);
+}
+
+static guint64
+cycle_counter_read (struct cycle_counter *counter)
+{
+    guint64 value = 0;
+
+    if (counter->fd >= 0) {
+        if (read (counter->fd, &value, sizeof (value)) != sizeof (value))
+            return 0;
+        return value;
+    }
+
+#if UNPACK_X86
+    value = __builtin_ia32_rdtsc ();
+#endif
+    return value;
+}
+
+/**
+ * @brief Unpacks the same frame over and over again for the configured duration and prints the throughput
+ *
+ * @param priv The ROI, format and kernels to measure
+ * @param counter
+ * @param format_name
+ */
+static void
+measure_frame (UcaPhantomCameraPrivate *priv, struct cycle_counter *counter, const gchar *format_name)
+{
+    gsize pixels = priv->roi_width * priv->roi_height;
+    gsize size = get_buffer_size (priv);
+    guint8 *input = g_malloc (size);
+    // Large enough for float output
+    guint16 *output = g_malloc (pixels * sizeof (gfloat));
+    guint64 frames = 0;
+    guint64 batch = MAX (1, (1 << 20) / pixels);
+    guint64 cycles;
+    gint64 start;
+    gdouble seconds;
+    gchar roi[32];
+
+    for (gsize i = 0; i < size; i++)
+        input[i] = g_rand_int (random_bytes) & 0xff;
+
+    set_received_frame (priv, input, output);
+
+    // One frame to get the buffers into the page tables and caches, like they are in a running readout
+    unpack_frame (priv);
+
+    start = g_get_monotonic_time ();
+    cycles = cycle_counter_read (counter);
+
+    // The time is only checked after a batch of about a million pixels, so that it does not distort small ROIs
+    do {
+        for (guint64 i = 0; i < batch; i++)
+            unpack_frame (priv);
+        frames += batch;
+    } while (g_get_monotonic_time () - start < duration * G_USEC_PER_SEC);
+
+    cycles = cycle_counter_read (counter) - cycles;
+    seconds = (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC;
+
+    g_snprintf (roi, sizeof (roi), "%ux%u", priv->roi_width, priv->roi_height);
+    if (priv->correction_dark != NULL)
+        g_strlcat (roi, priv->correction_float ? " f32" : " u16", sizeof (roi));
+    g_print ("%-16s %-5s %-7s %3u %9.2f %10.2f %10.3f %12.1f\n", roi, format_name, priv->xg_unpack->name,
+             priv->xg_decode_pool != NULL ? priv->xg_decode_pool->thread_amount + 1 : 1,
+             frames * size / seconds / 1e9, frames * pixels / seconds / 1e9,
+             counter->name != NULL ? (gdouble) frames * pixels / cycles : 0.0, frames / seconds);
+
+    g_free (input);
+    g_free (output);
+}
+
+static gboolean
+parse_format (const gchar *string, ImageFormat *format)
+{
+    if (g_ascii_strcasecmp (string, "p10") == 0)
+        *format = IMAGE_FORMAT_P10;
+    else if (g_ascii_strcasecmp (string, "p12l") == 0)
+        *format = IMAGE_FORMAT_P12L;
+    else if (g_ascii_strcasecmp (string, "p8") == 0)
+        *format = IMAGE_FORMAT_P8;
+    else {
+        g_printerr ("Invalid format '%s'\n", string);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+int
+main (int argc, char *argv[])
+{
+    GOptionContext *context;
+    GError *error = NULL;
+    UcaPhantomCameraPrivate *priv;
+    struct cycle_counter counter;
+    gchar *default_rois[] = { "2048x1952", "1280x800", "640x480", "1001x601", "127x3", NULL };
+    gchar *default_formats[] = { "p10", "p12l", "p8", NULL };
+    gchar *default_threads[] = { "1", NULL };
+    guint threads;
+    GPtrArray *kernels;
+    ImageFormat format;
+    guint width;
+    guint height;
+    gboolean success = TRUE;
+
+    context = g_option_context_new ("- unpacking kernel test and benchmark");
+    g_option_context_add_main_entries (context, entries, NULL);
+
+    if (!g_option_context_parse (context, &argc, &argv, &error)) {
+        g_printerr ("%s\n", error->message);
+        return 1;
+    }
+
+    if (roi_strings == NULL)
+        roi_strings = g_strdupv (default_rois);
+    if (format_strings == NULL)
+        format_strings = g_strdupv (default_formats);
+
+    for (guint i = 0; roi_strings[i] != NULL; i++) {
+        if (sscanf (roi_strings[i], "%ux%u", &width, &height) != 2 || width == 0 || height == 0) {
+            g_printerr ("Invalid ROI '%s'\n", roi_strings[i]);
+            return 1;
+        }
+    }
+
+    for (guint i = 0; format_strings[i] != NULL; i++) {
+        if (!parse_format (format_strings[i], &format))
+            return 1;
+    }
+
+    if (thread_strings == NULL)
+        thread_strings = g_strdupv (default_threads);
+
+    for (guint i = 0; thread_strings[i] != NULL; i++) {
+        if (sscanf (thread_strings[i], "%u", &threads) != 1 || threads == 0 || threads > 64) {
+            g_printerr ("Invalid amount of decode threads '%s'\n", thread_strings[i]);
+            return 1;
+        }
+    }
+
+    for (guint i = 0; kernel_strings != NULL && kernel_strings[i] != NULL; i++) {
+        gboolean known = FALSE;
+
+        for (guint k = 0; k < G_N_ELEMENTS (unpack_kernels); k++)
+            known = known || g_strcmp0 (kernel_strings[i], unpack_kernels[k].name) == 0;
+
+        if (!known) {
+            g_printerr ("Unknown unpack kernel '%s'\n", kernel_strings[i]);
+            return 1;
+        }
+    }
+
+    // Every kernel, which the CPU supports, unless they are given explicitly
+    kernels = g_ptr_array_new ();
+    for (guint i = 0; i < G_N_ELEMENTS (unpack_kernels); i++) {
+        const UnpackKernels *found = find_unpack_kernels (unpack_kernels[i].name);
+
+        if (kernel_strings != NULL && !g_strv_contains ((const gchar * const *) kernel_strings, unpack_kernels[i].name))
+            continue;
+
+        if (found == NULL)
+            g_print ("Skipping %s, which is not supported by this CPU\n", unpack_kernels[i].name);
+        else
+            g_ptr_array_add (kernels, (gpointer) found);
+    }
+
+    random_bytes = g_rand_new_with_seed (seed);
+    priv = g_new0 (UcaPhantomCameraPrivate, 1);
+    priv->xg_progress = g_new0 (struct progress, 1);
+    ximg_stages_setup (priv);
+    priv->wait_spin_time = PROGRESS_SPIN_TIME;
+
+    g_print ("Comparing the kernels with the reference\n");
+
+    for (guint k = 0; k < kernels->len; k++) {
+        const UnpackKernels *current = g_ptr_array_index (kernels, k);
+
+        for (guint j = 0; format_strings[j] != NULL; j++) {
+            gboolean passed;
+
+            // The name is printed beforehand, so that it is known which kernel has crashed on a guard page
+            g_print ("  %-7s %-5s ", current->name, format_strings[j]);
+            fflush (stdout);
+
+            parse_format (format_strings[j], &format);
+            passed = check_groups (current, format);
+
+            if (j == 0)
+                passed = check_correction (current) && passed;
+
+            for (guint i = 0; roi_strings[i] != NULL; i++) {
+                sscanf (roi_strings[i], "%ux%u", &width, &height);
+                priv->roi_width = width;
+                priv->roi_height = height;
+                priv->format = format;
+                priv->xg_unpack = current;
+                passed = check_frame (priv) && passed;
+                passed = check_corrected_frame (priv, FALSE) && passed;
+                passed = check_corrected_frame (priv, TRUE) && passed;
+
+                priv->xg_decode_pool = decode_pool_setup (priv, 2);
+                passed = check_frame (priv) && passed;
+                passed = check_corrected_frame (priv, FALSE) && passed;
+                decode_pool_teardown (priv->xg_decode_pool);
+                priv->xg_decode_pool = NULL;
+            }
+
+            g_print ("%s%s\n", passed ? "" : "\n  ", passed ? "ok" : "FAILED");
+            success = success && passed;
+        }
+    }
+
+    if (!check_only) {
+        cycle_counter_open (&counter);
+
+        if (correction_string != NULL) {
+            if (g_strcmp0 (correction_string, "u16") != 0 && g_strcmp0 (correction_string, "f32") != 0) {
+                g_printerr ("Invalid correction output '%s'\n", correction_string);
+                return 1;
+            }
+        }
+
+        g_print ("\n%-16s %-5s %-7s %3s %9s %10s %10s %12s\n", "ROI", "FORMAT", "KERNEL", "THR", "GB/s", "Gpixel/s",
+                 counter.name != NULL ? "pixel/cyc" : "-", "frames/s");
+        if (counter.fd < 0 && counter.name != NULL)
+            g_print ("(perf cycle counter not available, pixel/cyc refers to the time stamp counter)\n");
+
+        for (guint i = 0; roi_strings[i] != NULL; i++) {
+            sscanf (roi_strings[i], "%ux%u", &width, &height);
+
+            for (guint j = 0; format_strings[j] != NULL; j++) {
+                parse_format (format_strings[j], &format);
+
+                if (correction_string != NULL) {
+                    priv->correction_dark = g_new (gfloat, width * height);
+                    priv->correction_gain = g_new (gfloat, width * height);
+                    priv->correction_float = g_strcmp0 (correction_string, "f32") == 0;
+                    fill_correction (priv->correction_dark, priv->correction_gain, width * height, FALSE);
+                }
+
+                for (guint k = 0; k < kernels->len; k++) {
+                    priv->roi_width = width;
+                    priv->roi_height = height;
+                    priv->format = format;
+                    priv->xg_unpack = g_ptr_array_index (kernels, k);
+
+                    for (guint t = 0; thread_strings[t] != NULL; t++) {
+                        sscanf (thread_strings[t], "%u", &threads);
+                        priv->xg_decode_pool = threads > 1 ? decode_pool_setup (priv, threads - 1) : NULL;
+                        measure_frame (priv, &counter, format_strings[j]);
+
+                        if (priv->xg_decode_pool != NULL)
+                            decode_pool_teardown (priv->xg_decode_pool);
+                        priv->xg_decode_pool = NULL;
+                    }
+                }
+
+                stop_correction (priv);
+            }
+        }
+    }
+
+    if (!success)
+        g_print ("\nAt least one kernel does not match the reference\n");
+
+    g_ptr_array_unref (kernels);
+    g_rand_free (random_bytes);
+    ximg_stages_teardown (priv);
+    g_free (priv->xg_progress);
+    g_free (priv);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,978 @@
+/* Copyright (C) 2018 Matthias Vogelgesang <matthias.vogelgesang@kit.edu>
+   (Karlsruhe Institute of Technology)
+
+   This library is free software; you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by the
+   Free Software Foundation; either version 2.1 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+   FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+   details.
+
+   You should have received a copy of the GNU Lesser General Public License along
+   with this library; if not, write to the Free Software Foundation, Inc., 51
+   Franklin St, Fifth Floor, Boston, MA 02110, USA */
+
+/**
+ * @file
+ * @brief Throughput benchmark of the 10G (ximg) receive path without a camera.
+ *
+ * A generator thread sends synthetic P10 or P12L frames over a veth pair (or any two connected interfaces) using a
+ * PACKET_TX_RING. On the other end the actual receive and unpack threads of the plugin (accept_ximg_data and
+ * unpack_ximg_data) are running, the same way they would with the camera. For every combination of ROI and transfer
+ * format the achieved frame rate, the data rate, the dropped packets and the CPU time of every stage are reported.
+ *
+ * The plugin source is being included directly, because the receive threads are not part of the public interface.
+ * Creating the veth pair and sending raw packets needs CAP_NET_ADMIN and CAP_NET_RAW.
+ *
+ * Example:
+ *
+ *      ximg-traffic --roi 1280x800 --roi 2048x1952 --format p10 --format p12l --frames 2000 --rate 0
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Added P8 frames and the 8 bit output.
+ *
+ * Changed 17.10.2026
+ * Added the float output, which runs every pixel through the dark/flat correction (without reference frames, so that
+ * the pixels stay the same).
+ *
+ * Changed 17.10.2026
+ * Added the decode threads.
+ *
+ * Changed 17.10.2026
+ * Added the frame slots, with which the frames are requested ahead like in memread mode.
+ *
+ * Changed 17.10.2026
+ * Added the soak test, which tracks the RSS and the heap allocations over a million frames:
+ *
+ *      ximg-traffic --soak --roi 256x64 --format p10
+ *
+ * Changed 17.10.2026
+ * Added the spin time of the unpack thread. With a limited frame rate the CPU time of "ximg-unpack" shows how much of
+ * the waiting for data is spent spinning.
+ *
+ * Changed 17.10.2026
+ * The receiver is set up in memread mode, as the automatic size of the ring depends on it.
+ *
+ * Changed 17.10.2026
+ * The packets carry the offset of their payload in the ximg header.
+ */
+
+#define _GNU_SOURCE
+
+#include "uca-phantom-camera.c"
+
+#include <dirent.h>
+#include <fcntl.h>
+
+
+#define BENCHMARK_RX_INTERFACE      "ximgbench0"
+#define BENCHMARK_TX_INTERFACE      "ximgbench1"
+
+// The source MAC address of the generated packets. It is a locally administered address, which is also being set as
+// the "ximg-source-mac" of the receiver, so that the kernel filter only lets the generated traffic through.
+#define BENCHMARK_SOURCE_MAC        "02:70:68:61:6e:74"
+
+// The geometry of the transmit ring. Every frame of the ring holds one packet (up to a 9000 MTU)
+#define GENERATOR_FRAME_SIZE        16384
+#define GENERATOR_FRAME_AMOUNT      1024
+
+// The soak test receives this many frames by default. The RSS and the allocations are sampled SOAK_SAMPLES times, the
+// first interval is the warm up. Afterwards the RSS may not grow by more than SOAK_MAX_RSS_GROWTH and nothing may be
+// allocated, except for the errors of the incomplete frames (at most SOAK_ERROR_ALLOCATIONS each).
+#define SOAK_FRAME_AMOUNT           1000000
+#define SOAK_SAMPLES                10
+#define SOAK_MAX_RSS_GROWTH         (1024 * 1024)
+#define SOAK_ERROR_ALLOCATIONS      8
+
+// The heap allocations of the whole process are counted by wrapping the allocation functions of glibc, which g_malloc
+// and friends end up in as well.
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t amount, size_t size);
+extern void *__libc_realloc (void *pointer, size_t size);
+
+static guint64 allocation_count = 0;
+
+void *
+malloc (size_t size)
+{
+    __atomic_add_fetch (&allocation_count, 1, __ATOMIC_RELAXED);
+    return __libc_malloc (size);
+}
+
+void *
+calloc (size_t amount, size_t size)
+{
+    __atomic_add_fetch (&allocation_count, 1, __ATOMIC_RELAXED);
+    return __libc_calloc (amount, size);
+}
+
+void *
+realloc (void *pointer, size_t size)
+{
+    __atomic_add_fetch (&allocation_count, 1, __ATOMIC_RELAXED);
+    return __libc_realloc (pointer, size);
+}
+
+
+/**
+ * @brief The state of the thread, which sends the synthetic ximg traffic.
+ *
+ * The data of a single frame is being prepared beforehand and then being sent over and over again. After the requested
+ * amount of frames has been sent, the generator keeps sending (at the same rate) until the receiver is done. That way
+ * a frame, whose tail has been dropped, is still being finished by the packets of the following frame.
+ */
+struct generator {
+    gint fd;
+    guint8 *map;
+    gsize map_size;
+    guint frame_index;
+    guint8 destination[ETH_ALEN];
+    guint8 source[ETH_ALEN];
+
+    const guint8 *data;
+    gsize size;
+    gsize payload_size;
+
+    gdouble rate;
+
+    volatile gint done;
+    guint64 sent_frames;
+    guint64 sent_packets;
+    guint64 full_ring;
+};
+
+
+static gchar *rx_interface = NULL;
+static gchar *tx_interface = NULL;
+static gchar **roi_strings = NULL;
+static gchar **format_strings = NULL;
+static gint frame_amount = 0;
+static gdouble frame_rate = 0;
+static gint mtu = 1500;
+static gint receive_threads = 1;
+static gint decode_threads = 1;
+static gint frame_slots = 1;
+static gint wait_spin_time = PROGRESS_SPIN_TIME;
+static gboolean zero_copy = FALSE;
+static gboolean use_xdp = FALSE;
+static gchar *unpack_kernel = NULL;
+static gboolean output_8bit = FALSE;
+static gboolean output_float = FALSE;
+static gboolean soak = FALSE;
+static gboolean lend = FALSE;
+
+static GOptionEntry entries[] = {
+    { "rx", 0, 0, G_OPTION_ARG_STRING, &rx_interface, "Receiving interface (default: create a veth pair)", "IFACE" },
+    { "tx", 0, 0, G_OPTION_ARG_STRING, &tx_interface, "Sending interface (default: create a veth pair)", "IFACE" },
+    { "roi", 0, 0, G_OPTION_ARG_STRING_ARRAY, &roi_strings, "ROI to test, can be repeated (default: 1280x800)", "WxH" },
+    { "format", 0, 0, G_OPTION_ARG_STRING_ARRAY, &format_strings, "p10, p12l or p8, can be repeated (default: p10 and p12l)", "FORMAT" },
+    { "frames", 'n', 0, G_OPTION_ARG_INT, &frame_amount, "Frames per test (default: 1000, 1000000 with --soak)", "N" },
+    { "rate", 'r', 0, G_OPTION_ARG_DOUBLE, &frame_rate, "Frames per second to send, 0 is as fast as possible", "FPS" },
+    { "mtu", 0, 0, G_OPTION_ARG_INT, &mtu, "MTU of the created veth pair (default: 1500)", "MTU" },
+    { "receive-threads", 't', 0, G_OPTION_ARG_INT, &receive_threads, "Value of the receive-threads property", "N" },
+    { "decode-threads", 'j', 0, G_OPTION_ARG_INT, &decode_threads, "Value of the decode-threads property", "N" },
+    { "frame-slots", 's', 0, G_OPTION_ARG_INT, &frame_slots, "Value of the frame-slots property", "N" },
+    { "wait-spin-time", 'w', 0, G_OPTION_ARG_INT, &wait_spin_time, "Value of the wait-spin-time property in us", "US" },
+    { "zero-copy", 'z', 0, G_OPTION_ARG_NONE, &zero_copy, "Enable zero copy decoding", NULL },
+    { "xdp", 0, 0, G_OPTION_ARG_NONE, &use_xdp, "Use the AF_XDP receive backend", NULL },
+    { "unpack-kernel", 'k', 0, G_OPTION_ARG_STRING, &unpack_kernel, "avx512, avx2, ssse3 or scalar (default: fastest)", "KERNEL" },
+    { "8bit-output", '8', 0, G_OPTION_ARG_NONE, &output_8bit, "Receive P8 frames with 8 bit output", NULL },
+    { "float-output", 'f', 0, G_OPTION_ARG_NONE, &output_float, "Receive the frames with float output", NULL },
+    { "soak", 0, 0, G_OPTION_ARG_NONE, &soak, "Track the RSS and the heap allocations while receiving", NULL },
+    { "lend", 0, 0, G_OPTION_ARG_NONE, &lend, "Lend the frames from the frame slots instead of copying them", NULL },
+    { NULL }
+};
+
+
+/**
+ * @brief Runs the given "ip" command and reports whether it has been successful.
+ *
+ * @param command
+ * @return
+ */
+static gboolean
+run_ip_command (const gchar *command)
+{
+    gchar *line;
+    gchar *error_output = NULL;
+    gint status;
+    GError *error = NULL;
+
+    line = g_strdup_printf ("ip %s", command);
+    if (!g_spawn_command_line_sync (line, NULL, &error_output, &status, &error)) {
+        g_printerr ("Could not run '%s': %s\n", line, error->message);
+        g_error_free (error);
+        g_free (line);
+        return FALSE;
+    }
+
+    if (status != 0)
+        g_printerr ("'%s' failed: %s", line, error_output);
+
+    g_free (error_output);
+    g_free (line);
+    return status == 0;
+}
+
+/**
+ * @brief Creates the veth pair, which is used, when no interfaces are given on the command line.
+ *
+ * @return
+ */
+static gboolean
+create_veth_pair (void)
+{
+    gchar *command;
+    gboolean success;
+
+    // An old pair might still exist, if a previous run has been killed
+    if (if_nametoindex (BENCHMARK_RX_INTERFACE) != 0)
+        run_ip_command ("link del " BENCHMARK_RX_INTERFACE);
+
+    command = g_strdup_printf ("link add %s mtu %d type veth peer name %s mtu %d",
+                               BENCHMARK_RX_INTERFACE, mtu, BENCHMARK_TX_INTERFACE, mtu);
+    success = run_ip_command (command) &&
+              run_ip_command ("link set " BENCHMARK_RX_INTERFACE " up") &&
+              run_ip_command ("link set " BENCHMARK_TX_INTERFACE " up");
+    g_free (command);
+
+    return success;
+}
+
+/**
+ * @brief Packs the given pixel values into the P10 transfer format (4 pixels into 5 bytes, big endian).
+ *
+ * @param pixels
+ * @param output
+ * @param amount
+ */
+static void
+pack_p10 (const guint16 *pixels, guint8 *output, gsize amount)
+{
+    guint64 group;
+
+    for (gsize i = 0; i < amount; i += 4, output += 5) {
+        group = ((guint64) pixels[i] << 30) | ((guint64) pixels[i + 1] << 20) |
+                ((guint64) pixels[i + 2] << 10) | pixels[i + 3];
+        for (gint k = 0; k < 5; k++)
+            output[k] = (group >> (8 * (4 - k))) & 0xff;
+    }
+}
+
+/**
+ * @brief Packs the given pixel values into the P12L transfer format (2 pixels into 3 bytes, big endian).
+ *
+ * @param pixels
+ * @param output
+ * @param amount
+ */
+static void
+pack_p12l (const guint16 *pixels, guint8 *output, gsize amount)
+{
+    for (gsize i = 0; i < amount; i += 2, output += 3) {
+        output[0] = pixels[i] >> 4;
+        output[1] = ((pixels[i] & 0xf) << 4) | (pixels[i + 1] >> 8);
+        output[2] = pixels[i + 1] & 0xff;
+    }
+}
+
+/**
+ * @brief The value of the synthetic test pattern at the given pixel index.
+ *
+ * @param index
+ * @param format
+ * @return
+ */
+static guint16
+pattern_value (gsize index, ImageFormat format)
+{
+    return (index * 7 + index / 4093) & ((1 << get_unpack_group_size (format)) - 1);
+}
+
+static const gchar *
+get_format_name (ImageFormat format)
+{
+    switch (format) {
+        case IMAGE_FORMAT_P10:
+            return "p10";
+        case IMAGE_FORMAT_P12L:
+            return "p12l";
+        default:
+            return "p8";
+    }
+}
+
+/**
+ * @brief Creates the TPACKET_V2 transmit ring of the generator, which is bound to the given interface.
+ *
+ * @param generator
+ * @param interface
+ * @return
+ */
+static gboolean
+generator_setup (struct generator *generator, const gchar *interface)
+{
+    struct sockaddr_ll address;
+    struct tpacket_req request;
+    gint version = TPACKET_V2;
+
+    generator->fd = socket (AF_PACKET, SOCK_RAW, 0);
+    if (generator->fd < 0) {
+        g_printerr ("Could not create the sending socket: %s\n", g_strerror (errno));
+        return FALSE;
+    }
+
+    request.tp_block_size = GENERATOR_FRAME_SIZE;
+    request.tp_block_nr = GENERATOR_FRAME_AMOUNT;
+    request.tp_frame_size = GENERATOR_FRAME_SIZE;
+    request.tp_frame_nr = GENERATOR_FRAME_AMOUNT;
+
+    if (setsockopt (generator->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof (version)) < 0 ||
+        setsockopt (generator->fd, SOL_PACKET, PACKET_TX_RING, &request, sizeof (request)) < 0) {
+        g_printerr ("Could not create the transmit ring: %s\n", g_strerror (errno));
+        return FALSE;
+    }
+
+    generator->map_size = (gsize) GENERATOR_FRAME_SIZE * GENERATOR_FRAME_AMOUNT;
+    generator->map = mmap (NULL, generator->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, generator->fd, 0);
+    if (generator->map == MAP_FAILED) {
+        g_printerr ("Could not map the transmit ring: %s\n", g_strerror (errno));
+        return FALSE;
+    }
+
+    memset (&address, 0, sizeof (address));
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons (ETH_P_XIMG);
+    address.sll_ifindex = if_nametoindex (interface);
+    if (bind (generator->fd, (struct sockaddr *) &address, sizeof (address)) < 0) {
+        g_printerr ("Could not bind to %s: %s\n", interface, g_strerror (errno));
+        return FALSE;
+    }
+
+    generator->frame_index = 0;
+    return TRUE;
+}
+
+/**
+ * @brief Puts a single ximg packet with the given payload into the transmit ring.
+ *
+ * The packet is only being marked as ready. The kernel sends all of the marked packets, once send() is called. If the
+ * ring is full, the packets queued so far are being sent first.
+ * The offset of the payload within the frame is put at the end of the ximg header, the way the receiver expects it.
+ *
+ * @param generator
+ * @param payload
+ * @param length
+ * @param offset
+ */
+static void
+generator_queue_packet (struct generator *generator, const guint8 *payload, gsize length, gsize offset)
+{
+    guint32 header_offset = GUINT32_TO_BE (offset);
+    struct tpacket2_hdr *header;
+    guint8 *packet;
+
+    header = (struct tpacket2_hdr *) (generator->map + (gsize) generator->frame_index * GENERATOR_FRAME_SIZE);
+
+    while (g_atomic_int_get ((gint *) &header->tp_status) != TP_STATUS_AVAILABLE) {
+        generator->full_ring++;
+        send (generator->fd, NULL, 0, 0);
+    }
+
+    // Without PACKET_TX_HAS_OFF, the kernel expects the packet directly behind the (aligned) header
+    packet = (guint8 *) header + TPACKET_ALIGN (sizeof (struct tpacket2_hdr));
+    memcpy (packet, generator->destination, ETH_ALEN);
+    memcpy (packet + ETH_ALEN, generator->source, ETH_ALEN);
+    packet[12] = ETH_P_XIMG >> 8;
+    packet[13] = ETH_P_XIMG & 0xff;
+    memset (packet + ETH_HLEN, 0, XIMG_OVERHEAD - ETH_HLEN);
+    memcpy (packet + XIMG_OVERHEAD - XIMG_OFFSET_POSITION, &header_offset, sizeof (header_offset));
+    memcpy (packet + XIMG_OVERHEAD, payload, length);
+
+    header->tp_len = length + XIMG_OVERHEAD;
+    g_atomic_int_set ((gint *) &header->tp_status, TP_STATUS_SEND_REQUEST);
+
+    generator->frame_index = (generator->frame_index + 1) % GENERATOR_FRAME_AMOUNT;
+    generator->sent_packets++;
+}
+
+/**
+ * @brief The generator thread. Sends the prepared frame at the requested rate until the receiver is done.
+ *
+ * @param generator
+ * @return
+ */
+static gpointer
+generator_thread (struct generator *generator)
+{
+    struct timespec start;
+    struct timespec deadline;
+    gdouble offset;
+    gsize length;
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+
+    while (!g_atomic_int_get (&generator->done)) {
+        for (gsize i = 0; i < generator->size; i += generator->payload_size) {
+            length = MIN (generator->payload_size, generator->size - i);
+            generator_queue_packet (generator, generator->data + i, length, i);
+        }
+
+        send (generator->fd, NULL, 0, 0);
+        generator->sent_frames++;
+
+        if (generator->rate > 0) {
+            offset = generator->sent_frames / generator->rate;
+            deadline.tv_sec = start.tv_sec + (time_t) offset;
+            deadline.tv_nsec = start.tv_nsec + (glong) ((offset - (time_t) offset) * 1e9);
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+            clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Adds the CPU time of all threads of this process to the given table, grouped by the thread name.
+ *
+ * The names are set by g_thread_new. The main thread (which calls finalize_receiving_image) is reported as "grab".
+ *
+ * @param table
+ */
+static void
+sample_cpu_time (GHashTable *table)
+{
+    DIR *directory;
+    struct dirent *entry;
+    gchar *path;
+    gchar *contents;
+    gchar *name_start;
+    gchar *name_end;
+    gchar *name;
+    gchar **fields;
+    guint64 *ticks;
+
+    directory = opendir ("/proc/self/task");
+    if (directory == NULL)
+        return;
+
+    while ((entry = readdir (directory)) != NULL) {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        path = g_strdup_printf ("/proc/self/task/%s/stat", entry->d_name);
+        if (g_file_get_contents (path, &contents, NULL, NULL)) {
+            // The name is in parentheses and may itself contain spaces, so the fields are only split after it
+            name_start = strchr (contents, '(');
+            name_end = strrchr (contents, ')');
+
+            if (name_start != NULL && name_end != NULL) {
+                if (atoi (entry->d_name) == getpid ())
+                    name = g_strdup ("grab");
+                else
+                    name = g_strndup (name_start + 1, name_end - name_start - 1);
+
+                // After the name follow the state (field 3), ..., utime (field 14) and stime (field 15)
+                fields = g_strsplit (name_end + 2, " ", 0);
+                if (g_strv_length (fields) > 12) {
+                    ticks = g_hash_table_lookup (table, name);
+                    if (ticks == NULL) {
+                        ticks = g_new0 (guint64, 1);
+                        g_hash_table_insert (table, g_strdup (name), ticks);
+                    }
+                    *ticks += g_ascii_strtoull (fields[11], NULL, 10) + g_ascii_strtoull (fields[12], NULL, 10);
+                }
+
+                g_strfreev (fields);
+                g_free (name);
+            }
+            g_free (contents);
+        }
+        g_free (path);
+    }
+
+    closedir (directory);
+}
+
+/**
+ * @brief Prints the CPU usage of every thread name as percentage of a single core over the given time.
+ *
+ * @param before
+ * @param after
+ * @param seconds
+ */
+static void
+print_cpu_usage (GHashTable *before, GHashTable *after, gdouble seconds)
+{
+    GHashTableIter iter;
+    gpointer key;
+    gpointer value;
+    gpointer previous;
+    guint64 ticks;
+    glong ticks_per_second;
+
+    ticks_per_second = sysconf (_SC_CLK_TCK);
+    g_hash_table_iter_init (&iter, after);
+
+    g_print ("    cpu:");
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+        previous = g_hash_table_lookup (before, key);
+        ticks = *(guint64 *) value - (previous != NULL ? *(guint64 *) previous : 0);
+        g_print (" %s %.0f%%", (gchar *) key, 100.0 * ticks / ticks_per_second / seconds);
+    }
+    g_print ("\n");
+}
+
+/**
+ * @brief The state of the soak test of a single run, taken at the end of the warm up.
+ */
+struct soak {
+    guint samples;
+    guint64 allocations;
+    guint64 own_allocations;
+    guint64 incomplete_frames;
+    gsize rss;
+};
+
+/**
+ * @brief Returns the resident set size of the process in bytes, without allocating anything.
+ *
+ * @return
+ */
+static gsize
+get_resident_size (void)
+{
+    gchar buffer[128];
+    gsize pages = 0;
+    gsize resident = 0;
+    gssize length;
+    gint fd;
+
+    fd = open ("/proc/self/statm", O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    length = read (fd, buffer, sizeof (buffer) - 1);
+    close (fd);
+    if (length <= 0)
+        return 0;
+
+    buffer[length] = '\0';
+    sscanf (buffer, "%zu %zu", &pages, &resident);
+    return resident * sysconf (_SC_PAGESIZE);
+}
+
+/**
+ * @brief Prints the RSS and the allocations since the warm up, after the given amount of frames.
+ *
+ * The allocations of the soak test itself (printing) are not counted.
+ *
+ * @param soak
+ * @param priv
+ * @param frames
+ */
+static void
+soak_sample (struct soak *soak, UcaPhantomCameraPrivate *priv, gint frames)
+{
+    guint64 allocations = __atomic_load_n (&allocation_count, __ATOMIC_RELAXED);
+    gsize rss = get_resident_size ();
+
+    if (soak->samples++ == 0) {
+        soak->allocations = allocations;
+        soak->incomplete_frames = priv->xg_incomplete_frames;
+        soak->rss = rss;
+    }
+
+    g_print ("    %8d frames  RSS %8zu KiB %+7zd KiB  %8" G_GUINT64_FORMAT " allocations  %6" G_GUINT64_FORMAT
+             " incomplete frames%s\n", frames, rss / 1024, ((gssize) rss - (gssize) soak->rss) / 1024,
+             allocations - soak->allocations - soak->own_allocations,
+             priv->xg_incomplete_frames - soak->incomplete_frames, soak->samples == 1 ? " (warm up)" : "");
+
+    soak->own_allocations += __atomic_load_n (&allocation_count, __ATOMIC_RELAXED) - allocations;
+}
+
+/**
+ * @brief Decides, whether the soak test has passed: The RSS has stayed the same and nothing has been allocated after
+ * the warm up, except for the errors of incomplete frames.
+ *
+ * @param soak
+ * @param priv
+ * @return
+ */
+static gboolean
+soak_passed (struct soak *soak, UcaPhantomCameraPrivate *priv)
+{
+    guint64 allocations = __atomic_load_n (&allocation_count, __ATOMIC_RELAXED) - soak->allocations -
+                          soak->own_allocations;
+    guint64 incomplete_frames = priv->xg_incomplete_frames - soak->incomplete_frames;
+    gssize growth = (gssize) get_resident_size () - (gssize) soak->rss;
+    gboolean passed;
+
+    passed = growth <= SOAK_MAX_RSS_GROWTH && allocations <= incomplete_frames * SOAK_ERROR_ALLOCATIONS;
+    g_print ("    soak test %s: %+zd KiB RSS, %.4f allocations per frame after the warm up\n",
+             passed ? "passed" : "FAILED", growth / 1024,
+             (gdouble) allocations / MAX (frame_amount - frame_amount / SOAK_SAMPLES, 1));
+    return passed;
+}
+
+/**
+ * @brief Receives the given amount of frames with the real receive threads, while the generator is sending them.
+ *
+ * @param priv
+ * @param generator
+ * @param width
+ * @param height
+ * @param format
+ * @return
+ */
+static gboolean
+run_benchmark (UcaPhantomCameraPrivate *priv, struct generator *generator,
+               guint width, guint height, ImageFormat format)
+{
+    Result result;
+    InternalMessage message = { .type = MESSAGE_STOP };
+    gboolean passed;
+    GThread *thread;
+    GHashTable *cpu_before;
+    GHashTable *cpu_after;
+    GError *error = NULL;
+    guint16 *pixels;
+    guint16 *output;
+    guint16 *frame = NULL;
+    guint8 *data;
+    guint8 *output_8bit_pixels;
+    gfloat *output_float_pixels;
+    gsize pixel_amount;
+    gsize mismatches;
+    gint started;
+    gint soak_interval;
+    struct soak soak_state;
+    gint64 start;
+    gdouble seconds;
+
+    priv->roi_width = width;
+    priv->roi_height = height;
+    priv->format = format;
+    priv->xg_zero_copy = priv->zero_copy && format != IMAGE_FORMAT_P16;
+    priv->xg_incomplete_frames = 0;
+    priv->xg_missing_total = 0;
+
+    // The synthetic frame, which is being sent over and over again
+    pixel_amount = (gsize) width * height;
+    // The packing functions work on whole groups of pixels, thus the array is padded with zeros
+    pixels = g_malloc0 ((pixel_amount + 4) * sizeof (guint16));
+    for (gsize i = 0; i < pixel_amount; i++)
+        pixels[i] = pattern_value (i, format);
+
+    data = g_malloc (get_buffer_size (priv));
+    if (format == IMAGE_FORMAT_P10)
+        pack_p10 (pixels, data, pixel_amount);
+    else if (format == IMAGE_FORMAT_P12L)
+        pack_p12l (pixels, data, pixel_amount);
+    else {
+        for (gsize i = 0; i < pixel_amount; i++)
+            data[i] = pixels[i];
+    }
+
+    // Large enough for float output
+    output = g_malloc (pixel_amount * sizeof (gfloat));
+    if (!start_correction (priv, &error)) {
+        g_printerr ("Could not set up the correction: %s\n", error->message);
+        return FALSE;
+    }
+
+    frame_slots_setup (priv);
+
+    if (!priv->xg_zero_copy && priv->decode_threads > 1)
+        priv->xg_decode_pool = decode_pool_setup (priv, priv->decode_threads - 1);
+
+    priv->accept_thread = g_thread_new ("ximg-accept", (GThreadFunc) accept_ximg_data, priv);
+    priv->unpack_thread = g_thread_new ("ximg-unpack", (GThreadFunc) unpack_ximg_data, priv);
+
+    handoff_pop (priv->result_queue, &result);
+    g_assert (result.type == RESULT_READY);
+    if (result.error != NULL) {
+        g_printerr ("Could not set up the receiver: %s\n", result.error->message);
+        return FALSE;
+    }
+
+    generator->data = data;
+    generator->size = get_buffer_size (priv);
+    generator->sent_frames = 0;
+    generator->sent_packets = 0;
+    generator->full_ring = 0;
+    g_atomic_int_set (&generator->done, 0);
+
+    cpu_before = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    cpu_after = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+    sample_cpu_time (cpu_before);
+
+    // The first frame is being requested before the generator starts, just like with the camera
+    start = g_get_monotonic_time ();
+    start_receiving_image (priv, output);
+    thread = g_thread_new ("ximg-generator", (GThreadFunc) generator_thread, generator);
+
+    // As many frames as there are slots are kept in flight, the way camera_grab_memread does it
+    started = 1;
+    soak_interval = MAX (frame_amount / SOAK_SAMPLES, 1);
+    memset (&soak_state, 0, sizeof (soak_state));
+    for (gint i = 0; i < frame_amount; i++) {
+        while (priv->xg_frames_in_flight < priv->xg_slot_amount && started < frame_amount) {
+            start_receiving_image (priv, output);
+            started++;
+        }
+
+        // The lent frames are given back right away, except for the last one, which is compared below
+        if (lend) {
+            if (frame != NULL)
+                buffer_pool_give (priv->buffer_pool, frame);
+
+            frame = buffer_pool_take (priv->buffer_pool, get_frame_buffer_size (priv), -1);
+        }
+
+        if (!finalize_receiving_image (priv, lend ? frame : output, lend ? (gpointer *) &frame : NULL, &error)) {
+            // Incomplete frames are being counted by the receive thread
+            g_clear_error (&error);
+        }
+
+        if (!lend)
+            frame = output;
+
+        if (soak && (i + 1) % soak_interval == 0)
+            soak_sample (&soak_state, priv, i + 1);
+    }
+
+    seconds = (g_get_monotonic_time () - start) / 1e6;
+    sample_cpu_time (cpu_after);
+
+    g_atomic_int_set (&generator->done, 1);
+    g_thread_join (thread);
+
+    // The last frame is being compared to the pattern to make sure, that the decoding is actually working. If the
+    // amount of pixels is not a multiple of 4, the last P10 pixel does not fit into the frame completely.
+    mismatches = 0;
+    output_8bit_pixels = (guint8 *) frame;
+    output_float_pixels = (gfloat *) frame;
+    for (gsize i = 0; i < get_buffer_size (priv) * 8 / get_unpack_group_size (format); i++) {
+        if (has_float_output (priv))
+            mismatches += output_float_pixels[i] != pixels[i];
+        else
+            mismatches += (has_8bit_output (priv) ? output_8bit_pixels[i] : frame[i]) != pixels[i];
+    }
+
+    g_print ("%5ux%-5u %-4s %6d frames %7.3f s %9.1f frames/s %8.1f MB/s %8" G_GUINT64_FORMAT " drops "
+             "%5lu incomplete %s\n",
+             width, height, get_format_name (format), frame_amount, seconds,
+             frame_amount / seconds, frame_amount * get_buffer_size (priv) / seconds / 1e6,
+             priv->xg_kernel_drops, priv->xg_incomplete_frames, mismatches == 0 ? "" : "(last frame CORRUPTED)");
+    g_print ("    sent %" G_GUINT64_FORMAT " frames, %" G_GUINT64_FORMAT " packets, transmit ring full %"
+             G_GUINT64_FORMAT " times\n", generator->sent_frames, generator->sent_packets, generator->full_ring);
+    print_cpu_usage (cpu_before, cpu_after, seconds);
+
+    passed = mismatches == 0;
+    if (soak)
+        passed = soak_passed (&soak_state, priv) && passed;
+
+    // Stopping the receive and the unpack thread, they both need their own message
+    handoff_push (priv->message_queue, &message);
+    handoff_push (priv->unpack_queue, &message);
+    g_thread_join (priv->accept_thread);
+    g_thread_join (priv->unpack_thread);
+    stop_correction (priv);
+
+    if (priv->xg_decode_pool != NULL)
+        decode_pool_teardown (priv->xg_decode_pool);
+    priv->xg_decode_pool = NULL;
+
+    g_hash_table_destroy (cpu_before);
+    g_hash_table_destroy (cpu_after);
+    frame_slots_teardown (priv);
+    if (lend)
+        buffer_pool_give (priv->buffer_pool, frame);
+    g_free (output);
+    g_free (data);
+    g_free (pixels);
+
+    return passed;
+}
+
+/**
+ * @brief Reads the MAC address and the MTU of the given interface.
+ *
+ * @param interface
+ * @param address
+ * @param interface_mtu
+ * @return
+ */
+static gboolean
+get_interface_info (const gchar *interface, guint8 *address, gint *interface_mtu)
+{
+    struct ifreq request;
+    gint fd;
+    gint status;
+
+    memset (&request, 0, sizeof (request));
+    g_strlcpy (request.ifr_name, interface, IFNAMSIZ);
+
+    fd = socket (AF_INET, SOCK_DGRAM, 0);
+    status = ioctl (fd, SIOCGIFHWADDR, &request);
+    if (status == 0) {
+        memcpy (address, request.ifr_hwaddr.sa_data, ETH_ALEN);
+        status = ioctl (fd, SIOCGIFMTU, &request);
+        *interface_mtu = request.ifr_mtu;
+    }
+    close (fd);
+
+    if (status < 0) {
+        g_printerr ("Could not get the address of %s: %s\n", interface, g_strerror (errno));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+int
+main (int argc, char *argv[])
+{
+    GOptionContext *context;
+    GError *error = NULL;
+    UcaPhantomCameraPrivate *priv;
+    struct generator generator;
+    gchar *default_rois[] = { "1280x800", NULL };
+    gchar *default_formats[] = { "p10", "p12l", NULL };
+    gboolean created_pair = FALSE;
+    gboolean success = TRUE;
+    guint width;
+    guint height;
+    ImageFormat format;
+
+    context = g_option_context_new ("- 10G receive throughput benchmark");
+    g_option_context_add_main_entries (context, entries, NULL);
+
+    if (!g_option_context_parse (context, &argc, &argv, &error)) {
+        g_printerr ("%s\n", error->message);
+        return 1;
+    }
+
+    if (roi_strings == NULL)
+        roi_strings = g_strdupv (default_rois);
+    if (format_strings == NULL)
+        format_strings = g_strdupv (default_formats);
+    if (frame_amount <= 0)
+        frame_amount = soak ? SOAK_FRAME_AMOUNT : 1000;
+
+    if (find_unpack_kernels (unpack_kernel) == NULL) {
+        g_printerr ("The unpack kernel '%s' is not supported by this CPU\n", unpack_kernel);
+        return 1;
+    }
+
+    // With zero copy decoding there are no frame slots, whose buffers could be lent
+    if (lend && zero_copy) {
+        g_printerr ("--lend cannot be combined with --zero-copy\n");
+        return 1;
+    }
+
+    if ((rx_interface == NULL) != (tx_interface == NULL)) {
+        g_printerr ("Either both or none of --rx and --tx have to be given\n");
+        return 1;
+    }
+
+    if (rx_interface == NULL) {
+        if (!create_veth_pair ())
+            return 1;
+        rx_interface = g_strdup (BENCHMARK_RX_INTERFACE);
+        tx_interface = g_strdup (BENCHMARK_TX_INTERFACE);
+        created_pair = TRUE;
+    }
+
+    // The receiver is being set up the same way uca_phantom_camera_init and the properties would do it
+    priv = g_new0 (UcaPhantomCameraPrivate, 1);
+    priv->enable_10ge = TRUE;
+    // The generator sends the frames back to back like a memread, so the ring is sized for that
+    priv->enable_memread = TRUE;
+    priv->iface = rx_interface;
+    priv->receive_threads = receive_threads;
+    priv->decode_threads = MAX (decode_threads, 1);
+    priv->frame_slots = CLAMP (frame_slots, 1, 16);
+    priv->xg_progress = g_new0 (struct progress, 1);
+    ximg_stages_setup (priv);
+    priv->wait_spin_time = MAX (wait_spin_time, 0);
+    priv->ring_retire_timeout = 1;
+    priv->zero_copy = zero_copy;
+    priv->receive_backend = use_xdp ? RECEIVE_BACKEND_AF_XDP : RECEIVE_BACKEND_PACKET_MMAP;
+    priv->ximg_source_mac = g_strdup (BENCHMARK_SOURCE_MAC);
+    priv->ximg_capture_file = g_strdup ("");
+    priv->xg_fd = -1;
+    priv->xg_unpack = find_unpack_kernels (unpack_kernel);
+    priv->enable_8bit_output = output_8bit;
+    priv->enable_float_output = output_float;
+    priv->message_queue = handoff_setup (sizeof (InternalMessage));
+    priv->result_queue = handoff_setup (sizeof (Result));
+    priv->unpack_queue = handoff_setup (sizeof (InternalMessage));
+    priv->buffer_pool = buffer_pool_setup ();
+    priv->xg_numa_node = get_interface_numa_node (rx_interface);
+
+    memset (&generator, 0, sizeof (generator));
+    generator.rate = frame_rate;
+    sscanf (BENCHMARK_SOURCE_MAC, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
+            &generator.source[0], &generator.source[1], &generator.source[2],
+            &generator.source[3], &generator.source[4], &generator.source[5]);
+
+    // The packets are as large as the receiving interface allows, just like the camera would send them
+    if (!get_interface_info (rx_interface, generator.destination, &mtu) || !generator_setup (&generator, tx_interface)) {
+        success = FALSE;
+        goto cleanup;
+    }
+    generator.payload_size = mtu + ETH_HLEN - XIMG_OVERHEAD;
+
+    g_print ("%s -> %s, MTU %d, %d receive threads, %d decode threads, %d frame slots, %u us spin%s%s%s%s%s, %s kernel, ",
+             tx_interface, rx_interface, mtu, receive_threads, priv->decode_threads, priv->frame_slots,
+             priv->wait_spin_time, zero_copy ? ", zero copy" : "", use_xdp ? ", AF_XDP" : "",
+             output_8bit ? ", 8 bit output" : "", output_float ? ", float output" : "", lend ? ", lending" : "",
+             priv->xg_unpack->name);
+    if (frame_rate > 0)
+        g_print ("%.1f frames/s\n", frame_rate);
+    else
+        g_print ("as fast as possible\n");
+
+    for (guint i = 0; roi_strings[i] != NULL; i++) {
+        if (sscanf (roi_strings[i], "%ux%u", &width, &height) != 2) {
+            g_printerr ("Invalid ROI '%s'\n", roi_strings[i]);
+            success = FALSE;
+            break;
+        }
+
+        for (guint j = 0; format_strings[j] != NULL; j++) {
+            if (g_ascii_strcasecmp (format_strings[j], "p10") == 0)
+                format = IMAGE_FORMAT_P10;
+            else if (g_ascii_strcasecmp (format_strings[j], "p12l") == 0)
+                format = IMAGE_FORMAT_P12L;
+            else if (g_ascii_strcasecmp (format_strings[j], "p8") == 0)
+                format = IMAGE_FORMAT_P8;
+            else {
+                g_printerr ("Invalid format '%s'\n", format_strings[j]);
+                success = FALSE;
+                break;
+            }
+
+            success = run_benchmark (priv, &generator, width, height, format) && success;
+        }
+    }
+
+cleanup:
+    if (created_pair)
+        run_ip_command ("link del " BENCHMARK_RX_INTERFACE);
+
+    return success ? 0 : 1;
+}
@@ -20,17 +20,22 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include <time.h>
+#include <errno.h>
 //#include <math.h>
 
 #include <gio/gio.h>
 #include <gmodule.h>
 #include <string.h>
 #include <unistd.h>
-#include <nmmintrin.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 #include <sys/socket.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
 
 #include <arpa/inet.h>
 //#include <netinet/if_ether.h>
@@ -39,6 +44,13 @@
 #include <linux/ip.h>
 #include <linux/if_packet.h>
 #include <linux/if_ether.h>
+#include <linux/filter.h>
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <linux/futex.h>
+#include <linux/mempolicy.h>
+#include <linux/capability.h>
 #include <netdb.h>
 #include <uca/uca-camera.h>
 #include "uca-phantom-camera.h"
@@ -75,14 +87,25 @@
 // HARDCODING CONFIGURATION OF THE CAMERA
 // **************************************
 
-#define PROTOCOL        ETH_P_ALL
-//#define PROTOCOL        0x88b7
+// 17.10.2026
+// The raw socket for the 10G reception used to be bound to ETH_P_ALL, which put every frame arriving at the interface
+// (ARP, IPv6, the control connection...) into the ring buffer. Now it is bound to the ethertype of the ximg packets and
+// a BPF filter additionally drops all frames, which do not originate from the camera (see "attach_ximg_filter").
+#define ETH_P_XIMG      0x88b7
+#define PROTOCOL        ETH_P_XIMG
 
 // 26.06.2019
 // Changed the Chunk size from 400 to 100, because after testing with the 2048 pixel width image settings. 400 images
 // cause the ring buffer to overflow.
+// 17.10.2026
+// By default the chunk size is now derived from the ring and adapted at runtime (see "MEMREAD FLOW CONTROL"). This
+// value is only used as the chunk size for the 1G interface.
 #define MEMREAD_CHUNK_SIZE  100
 
+// 17.10.2026
+// The maximum amount of live frames, which are requested ahead (see "REQUEST PIPELINING")
+#define PIPELINE_MAX_DEPTH  16
+
 // 04.11.2019
 // This macro will define the index which will be used as the start index for the very first packet request of the
 // memread requests
@@ -122,11 +145,212 @@ struct ring {
     struct tpacket_req3 req;
 };
 
+// 17.10.2026
+// The geometry of the TPACKET_V3 ring buffer(s) used for the 10G reception. "block_amount" is the total amount of blocks,
+// which is split between the rings of a PACKET_FANOUT group. "mtu" is the MTU of the interface at the time the
+// geometry was computed, it is only kept to be reported back.
+struct ring_geometry {
+    guint    block_size;
+    guint    block_amount;
+    guint    frame_size;
+    guint    retire_timeout;
+    guint    ring_amount;
+    guint    mtu;
+};
+
+// 17.10.2026
+// The following structs are used for the multi threaded 10G reception. Several rings are joined into one PACKET_FANOUT
+// group, so that the kernel distributes the incoming packets over all of them. Each ring is drained by its own receiver
+// thread, which indexes the ximg packets of every block it gets from the kernel. The reassembly then merges the packets
+// of all rings back into the original order, using the kernel receive timestamp of each packet.
+struct fanout_packet {
+    guint64  timestamp;
+    guint8  *data;
+    gsize    length;
+};
+
+// 17.10.2026
+// The descriptors of all the blocks of a ring are allocated together with the ring. The packet array of a descriptor is
+// only enlarged, if a block holds more packets than the geometry suggests.
+struct fanout_block {
+    struct fanout_ring  *owner;
+    guint                index;
+    guint                packet_amount;
+    guint                packet_index;
+    guint                packet_capacity;
+    struct fanout_packet *packets;
+};
+
+struct fanout_ring {
+    struct ring          ring;
+    gint                 fd;
+    GThread             *thread;
+    GAsyncQueue         *queue;
+    volatile gint       *outstanding;
+    struct fanout_block *descriptors;
+    volatile gint        next_block;
+    volatile gint        indexed;
+    volatile gint        stop;
+    GQueue               pending;
+    guint                received;
+
+    guint64              packets;
+    guint64              bytes;
+    guint64              blocks;
+    guint64              skipped;
+    guint64              kernel_packets;
+    guint64              kernel_drops;
+    guint64              kernel_freezes;
+    guint64              losing_blocks;
+    struct fanout       *fanout;
+};
+
+struct fanout {
+    guint                ring_amount;
+    struct fanout_ring  *rings;
+    GAsyncQueue         *queue;
+    guint                last_ring;
+    // The amount of blocks of all rings, which are currently owned by the plugin and the highest amount so far
+    volatile gint        user_blocks;
+    volatile gint        user_blocks_max;
+};
+
+// 17.10.2026
+// The following structs are used by the AF_XDP receive backend. An XDP program redirects the ximg packets of the
+// interface into a XDP socket, which is receiving them into a memory area shared with the kernel (the UMEM). The UMEM
+// is divided into frames of equal size. Their addresses are passed back and forth between the kernel and the plugin
+// using single producer / single consumer rings: The fill ring contains the free frames, the rx ring the frames
+// holding a received packet. The completion ring is only used for sending, but the kernel requires it nonetheless.
+struct xdp_ring {
+    volatile guint32    *producer;
+    volatile guint32    *consumer;
+    void                *descriptors;
+    guint32              size;
+    void                *map;
+    gsize                map_size;
+};
+
+struct xdp_receiver {
+    gint                 fd;
+    gint                 map_fd;
+    gint                 program_fd;
+    gint                 link_fd;
+    guint                queue_id;
+    gboolean             native;
+    gboolean             zero_copy;
+    guint8              *umem;
+    gsize                umem_size;
+    guint                frame_size;
+    guint                frame_amount;
+    struct xdp_ring      fill;
+    struct xdp_ring      completion;
+    struct xdp_ring      rx;
+    guint64              packets;
+    guint64              bytes;
+    guint64              skipped;
+};
+
+// 17.10.2026
+// The replay backend reads the ximg packets from a pcap file instead of a socket. The packets are written into the
+// blocks of a ring buffer in memory, in the same layout the kernel uses for a TPACKET_V3 ring, so that they pass
+// through "read_ximg_data" exactly like received packets.
+struct replay {
+    GMappedFile         *file;
+    const guint8        *data;
+    gsize                size;
+    gsize                offset;
+    gboolean             nanoseconds;
+    struct ring          ring;
+    guint64              packets;
+    guint64              bytes;
+    guint64              skipped;
+};
+
 typedef union {
     uint8_t *in;
     uint64_t *out;
 } xbuffer;
 
+// 17.10.2026
+// A kernel unpacks the given amount of groups of 8 pixels of a transfer format (see "UNPACKING KERNELS"). The kernels
+// for P10, P12L and P8, which use the same instruction set, are kept together.
+typedef void (*UnpackKernel) (const guint8 *input, guint16 *output, gsize groups);
+
+#define UNPACK_GROUP_PIXELS     8
+
+// 17.10.2026
+// A correction kernel applies the dark/flat correction to the given amount of unpacked pixels (see "DARK/FLAT
+// CORRECTION"). There is one for 16 bit and one for float output.
+typedef void (*CorrectKernel) (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output,
+                               gsize pixels);
+
+typedef struct {
+    const gchar         *name;
+    gboolean           (*supported) (void);
+    UnpackKernel         p10;
+    UnpackKernel         p12l;
+    UnpackKernel         p8;
+    CorrectKernel        correct_u16;
+    CorrectKernel        correct_f32;
+} UnpackKernels;
+
+// 17.10.2026
+// The state of the 10G pipeline, which is written for every packet or every unpacked chunk, is kept in one struct per
+// stage instead of in "priv": the receiving thread owns the parser, the unpack thread the decoder. Both are allocated
+// on cache lines of their own (see "ximg_stages_setup"), so that the two threads no longer invalidate each other's
+// cache lines with every write, as they did with the neighbouring fields of "priv". The configuration is read through
+// the "priv" pointer, it does not change during a readout.
+#define CACHE_LINE_SIZE             64
+
+struct ximg_parser {
+    UcaPhantomCameraPrivate *priv;
+    // The position within the ring buffer of the classic single ring (see "read_ximg_data"). The amount of packets of
+    // the current block is kept here, because it is used in several different functions.
+    struct block_desc   *current_block;
+    gboolean             block_finished;
+    gint                 block_index;
+    gsize                packet_index;
+    gsize                packet_amount;
+    struct tpacket3_hdr *packet_header;
+    guint8              *packet_data;
+    gsize                packet_length;
+    gsize                remaining_length;
+    guint8               remaining_data[40];
+    // The frame being received. "total" and the frame counters are read by the unpack thread (see "FRAME SLOTS").
+    // Lost packets are detected using the length of the packets (see "receive_ximg_packet"), "max_payload" is the
+    // largest payload received so far, "missing" the amount of bytes missing from the current frame.
+    gsize                total;
+    gsize                expected;
+    gsize                missing;
+    gsize                max_payload;
+    // 17.10.2026
+    // Once the offsets in the ximg headers have proven to be consistent, they are used to place the packets (see
+    // "get_ximg_offset"). "offset_matches" counts the consistent packets in a row until then.
+    gboolean             offset_trusted;
+    guint                offset_matches;
+    guint8              *data_in;
+    volatile gint        started_frames;
+    volatile gint        received_frames;
+    // With zero copy decoding, the buffer of the current frame. Groups of P10/P12L/P8 bytes, which straddle two
+    // packets, are kept in "carry".
+    guint16             *output;
+    gsize                output_index;
+    guint8               carry[16];
+    gsize                carry_length;
+} __attribute__ ((aligned (CACHE_LINE_SIZE)));
+
+struct ximg_decoder {
+    UcaPhantomCameraPrivate *priv;
+    // The parser, which receives the frames being unpacked
+    struct ximg_parser  *parser;
+    // The raw data and the image of the frame, which is being unpacked, and how far it has been unpacked
+    guint8              *in;
+    guint16             *out;
+    gsize                unpack_index;
+    gsize                buffer_index;
+    guint                unpack_frame;
+} __attribute__ ((aligned (CACHE_LINE_SIZE)));
+
 
 // ***************************
 // STRUCT AND ENUM DEFINITIONS
@@ -221,6 +445,46 @@ enum {
     // 11.11.2019
     // This is the property, which holds the numeric index for which acquisition mode is currently active
     PROP_ACQUISITION_MODE_INDEX,
+    // 17.10.2026
+    // The amount of receiver threads (one PACKET_FANOUT ring each) for the 10G reception and a string summary of the
+    // statistics of each of these rings.
+    PROP_RECEIVE_THREADS,
+    PROP_RECEIVE_STATISTICS,
+    PROP_RING_BLOCK_SIZE,
+    PROP_RING_BLOCK_COUNT,
+    PROP_RING_RETIRE_TIMEOUT,
+    PROP_RING_GEOMETRY,
+    PROP_RING_LOCKED_MEMORY,
+    PROP_ZERO_COPY,
+    PROP_XIMG_SOURCE_MAC,
+    PROP_RECEIVE_BACKEND,
+    PROP_XDP_QUEUE,
+    // 17.10.2026
+    // The kernel statistics of the 10G reception
+    PROP_RING_PACKETS,
+    PROP_RING_DROPS,
+    PROP_RING_FREEZE_COUNT,
+    PROP_RING_LOSING_BLOCKS,
+    PROP_RING_USER_BLOCKS_MAX,
+    PROP_XIMG_CAPTURE_FILE,
+    PROP_UNPACK_KERNEL,
+    PROP_ENABLE_8BIT_OUTPUT,
+    PROP_DARK_FRAME_FILE,
+    PROP_FLAT_FRAME_FILE,
+    PROP_ENABLE_FLOAT_OUTPUT,
+    PROP_HAS_FLOAT_OUTPUT,
+    PROP_DECODE_THREADS,
+    PROP_FRAME_SLOTS,
+    PROP_WAIT_SPIN_TIME,
+    PROP_ENABLE_STREAMING,
+    PROP_STREAMING_QUEUE_LENGTH,
+    PROP_STREAMING_POLICY,
+    PROP_STREAMING_DROPPED_FRAMES,
+    PROP_REQUEST_PIPELINE_DEPTH,
+    PROP_MEMREAD_CHUNK_SIZE,
+    PROP_MEMREAD_PREFETCH,
+    PROP_STATUS_POLL_INTERVAL,
+    PROP_STATUS_POLL_MAX_INTERVAL,
 
     N_PROPERTIES
 };
@@ -247,6 +511,16 @@ static gint base_overrideables[] = {
 
 static GParamSpec *phantom_properties[N_PROPERTIES] = { NULL, };
 
+// 17.10.2026
+// "packets-dropped" is emitted once per 10G readout, when the kernel has dropped packets for the first time
+enum {
+    SIGNAL_PACKETS_DROPPED,
+
+    N_SIGNALS
+};
+
+static guint phantom_signals[N_SIGNALS] = { 0, };
+
 typedef enum {
     SYNC_MODE_FREE_RUN = 0,
     SYNC_MODE_FSYNC,
@@ -288,6 +562,37 @@ static GEnumValue image_format_values[] = {
     { 0, NULL, NULL }
 };
 
+// 17.10.2026
+// The backends, which can be used to receive the 10G packets. Packet mmap is the TPACKET_V3 ring buffer (optionally
+// several of them in a PACKET_FANOUT group), AF_XDP uses a XDP socket. Replay reads previously captured packets from
+// the file "ximg-capture-file".
+typedef enum {
+    RECEIVE_BACKEND_PACKET_MMAP = 0,
+    RECEIVE_BACKEND_AF_XDP,
+    RECEIVE_BACKEND_REPLAY,
+} ReceiveBackend;
+
+static GEnumValue receive_backend_values[] = {
+    { RECEIVE_BACKEND_PACKET_MMAP,  "RECEIVE_BACKEND_PACKET_MMAP",  "receive_backend_packet_mmap" },
+    { RECEIVE_BACKEND_AF_XDP,       "RECEIVE_BACKEND_AF_XDP",       "receive_backend_af_xdp" },
+    { RECEIVE_BACKEND_REPLAY,       "RECEIVE_BACKEND_REPLAY",       "receive_backend_replay" },
+    { 0, NULL, NULL }
+};
+
+// 17.10.2026
+// What the streaming mode does with a new frame, when the frame queue is full. Either the oldest frame in the queue is
+// dropped or the streaming thread waits until "grab" has taken one.
+typedef enum {
+    STREAMING_POLICY_DROP_OLDEST = 0,
+    STREAMING_POLICY_BLOCK,
+} StreamingPolicy;
+
+static GEnumValue streaming_policy_values[] = {
+    { STREAMING_POLICY_DROP_OLDEST, "STREAMING_POLICY_DROP_OLDEST", "streaming_policy_drop_oldest" },
+    { STREAMING_POLICY_BLOCK,       "STREAMING_POLICY_BLOCK",       "streaming_policy_block" },
+    { 0, NULL, NULL }
+};
+
 static GEnumValue acquisition_mode_values[] = {
     { ACQUISITION_MODE_STANDARD,        "ACQUISITION_MODE_STANDARD",        "acquisition_mode_standard" },
     { ACQUISITION_MODE_STANDARD_BINNED, "ACQUISITION_MODE_STANDARD_BINNED", "acquisition_mode_standard_binned" },
@@ -308,8 +613,14 @@ struct _UcaPhantomCameraPrivate {
     GCancellable        *accept;
     GThread             *accept_thread;
     GThread             *unpack_thread;
-    GAsyncQueue         *message_queue;
-    GAsyncQueue         *result_queue;
+    // 17.10.2026
+    // The queues are handoff rings now (see "HANDING OVER BETWEEN THE THREADS").
+    struct handoff      *message_queue;
+    struct handoff      *result_queue;
+    // 17.10.2026
+    // The 10G unpack thread has a queue of its own. With several frames in flight, it would otherwise keep taking the
+    // messages for the receiving thread out of the shared queue and putting them back.
+    struct handoff      *unpack_queue;
     GRegex              *response_pattern;
     GRegex              *res_pattern;
 
@@ -323,6 +634,18 @@ struct _UcaPhantomCameraPrivate {
     gchar               *ip_address;
     guint8               mac_address[6];
     ImageFormat          format;
+    // 17.10.2026
+    // With P8 the pixels can be delivered with one byte each instead of two (see "has_8bit_output")
+    gboolean             enable_8bit_output;
+    // 17.10.2026
+    // The reference frames and the float output of the dark/flat correction (see "DARK/FLAT CORRECTION"). The
+    // correction_* fields are set up from these for the duration of a readout.
+    gchar               *dark_frame_file;
+    gchar               *flat_frame_file;
+    gboolean             enable_float_output;
+    gfloat              *correction_dark;
+    gfloat              *correction_gain;
+    gboolean             correction_float;
     AcquisitionMode      acquisition_mode;
 
     UcaCameraTriggerSource uca_trigger_source;
@@ -331,32 +654,10 @@ struct _UcaPhantomCameraPrivate {
     // camera
     gboolean             connected;
 
-    struct block_desc   *xg_current_block;
-    gsize                xg_total;
-    gsize                xg_expected;
-    gboolean             xg_block_finished;
-    gboolean             xg_packet_skipped;
-    gint                 xg_block_index;
-    gint                 xg_packet_index;
-    gint                 xg_data_index;
-    struct tpacket3_hdr *xg_packet_header;
-    
-    xbuffer              xg_data_buffer;
-    uint8_t             *xg_data_in;
-    uint16_t            *xg_buffer;
-    gint                 xg_buffer_index;
-    guint8              *xg_packet_data;
-    guint8               xg_remaining_data[40];
-    gsize                xg_packet_length;
-    gsize                xg_remaining_length;
-    
-    // 29.05.2019
-    // We need to keep track of the amount of packages inside a block of the ring buffer as an attribute of the camera
-    // object, because it is used in several different methods.
-    gsize                xg_packet_amount;
-
-    gint                 xg_unpack_length;
-    gint                 xg_unpack_index;
+    // 17.10.2026
+    // The state of the receiving and the unpack thread, which used to be kept here, see "struct ximg_parser"
+    struct ximg_parser  *xg_parser;
+    struct ximg_decoder *xg_decoder;
 
     // 10.05.2019
     // These are the attributes needed for the "memread" mode.
@@ -385,6 +686,126 @@ struct _UcaPhantomCameraPrivate {
     // be used the "rec" command, which has to be sent in preparation of a trigger, will be sent during the
     // "start_recording" process.. Otherwise the "rec" command will be sent together with the software trigger command
     gboolean             triggered_externally;
+    // 17.10.2026
+    // With more than one receive thread, the 10G packets are distributed over several rings of a PACKET_FANOUT group.
+    // "xg_fanout" is only valid while the readout is running. "xg_fd" is the socket of the classic single ring.
+    guint                receive_threads;
+    struct fanout       *xg_fanout;
+    gint                 xg_fd;
+    // 17.10.2026
+    // The receiving thread publishes and withdraws "xg_fanout", "xg_xdp" and "xg_replay" while holding this mutex, so
+    // that their statistics can be read from any thread.
+    GMutex               xg_backend_mutex;
+    // 17.10.2026
+    // The requested geometry of the 10G ring buffer. A block size or block count of 0 means, that the value is derived
+    // from the image size, the memread chunk size and the MTU of the interface. "xg_geometry" is the geometry actually
+    // used by the running readout, its block amount is 0 while no readout is running.
+    guint                ring_block_size;
+    guint                ring_block_amount;
+    guint                ring_retire_timeout;
+    struct ring_geometry xg_geometry;
+    // 17.10.2026
+    // With zero copy decoding the 10G packets are decoded by the receiving thread directly from the ring buffer into
+    // the buffer passed to "grab". "xg_zero_copy" is the mode used by the running readout.
+    gboolean             zero_copy;
+    gboolean             xg_zero_copy;
+    // 17.10.2026
+    // The MAC address of the camera's 10G port as "aa:bb:cc:dd:ee:ff". If it is empty, the address is looked up in the
+    // ARP table using the address of the control connection.
+    gchar               *ximg_source_mac;
+    // 17.10.2026
+    // The backend used to receive the 10G packets and the rx queue of the interface, which is served by the AF_XDP
+    // backend. "xg_xdp" is only valid while a readout with the AF_XDP backend is running.
+    ReceiveBackend       receive_backend;
+    guint                xdp_queue;
+    struct xdp_receiver *xg_xdp;
+    // 17.10.2026
+    // Lost packets are detected using the length of the packets (see "receive_ximg_packet"). These count the
+    // incomplete frames and missing bytes of the whole readout.
+    guint64              xg_incomplete_frames;
+    guint64              xg_missing_total;
+    // 17.10.2026
+    // The kernel statistics of the 10G socket(s), sampled by the receiving thread after every frame (see
+    // "sample_ring_statistics"). "xg_drop_state" is 1, once the first drop has been seen and 2, once the signal
+    // "packets-dropped" has been emitted for it.
+    guint64              xg_kernel_packets;
+    guint64              xg_kernel_drops;
+    guint64              xg_kernel_freezes;
+    guint64              xg_losing_blocks;
+    guint                xg_user_blocks_max;
+    volatile gint        xg_drop_state;
+    // 17.10.2026
+    // The pcap file, into which the blocks of the ring are written, or from which the packets are replayed with the
+    // replay backend.
+    gchar               *ximg_capture_file;
+    FILE                *xg_capture;
+    struct replay       *xg_replay;
+    // 17.10.2026
+    // The kernels, which unpack P10 and P12L. By default the fastest ones supported by the CPU.
+    const UnpackKernels *xg_unpack;
+    // 17.10.2026
+    // The amount of threads, which unpack a 10G frame together (see "PARALLEL DECODING"). "xg_decode_pool" holds the
+    // worker threads besides the unpack thread and is only valid while a readout with more than one is running.
+    guint                decode_threads;
+    struct decode_pool  *xg_decode_pool;
+    // 17.10.2026
+    // The amount of 10G frames, which can be in flight at the same time (see "FRAME SLOTS"). "xg_slots" is only
+    // allocated while a readout without zero copy decoding is running. "memread_pending" is the amount of frames of the
+    // memread chunks, which have been requested but not started yet.
+    guint                frame_slots;
+    struct frame_slot   *xg_slots;
+    guint                xg_slot_amount;
+    guint                xg_delivered_frames;
+    guint                xg_frames_in_flight;
+    guint                memread_pending;
+    // 17.10.2026
+    // The progress of the receiving thread, which the unpack thread and the decode pool wait for (see "WAITING FOR
+    // PROGRESS"), and how long they spin before going to sleep, in microseconds.
+    struct progress     *xg_progress;
+    guint                wait_spin_time;
+    // 17.10.2026
+    // The frame buffers, which are kept across the readouts (see "FRAME BUFFER POOL"), and the NUMA node of the 10G
+    // interface they are placed on.
+    struct buffer_pool  *buffer_pool;
+    gint                 xg_numa_node;
+    // 17.10.2026
+    // The streaming mode (see "STREAMING"). "stream" is only valid while a recording with streaming is running. As the
+    // streaming thread talks to the camera as well, the control connection is protected by "talk_mutex".
+    gboolean             enable_streaming;
+    guint                streaming_queue_length;
+    StreamingPolicy      streaming_policy;
+    guint64              streaming_dropped_frames;
+    struct stream       *stream;
+    GMutex               talk_mutex;
+    // 17.10.2026
+    // The amount of live frames requested ahead (see "REQUEST PIPELINING"). "xg_pipeline_depth" is fixed for a readout.
+    // "xg_pipeline" is a ring of the buffers, which the pipelined frames are received into without frame slots.
+    guint                request_pipeline_depth;
+    guint                xg_pipeline_depth;
+    gboolean             xg_pipeline_buffered;
+    gpointer             xg_pipeline[PIPELINE_MAX_DEPTH];
+    guint                xg_pipeline_head;
+    guint                xg_pipeline_amount;
+    // 17.10.2026
+    // The amount of frames requested by a memread chunk. With a "memread_chunk_size" of 0 it is derived from the ring
+    // and adapted to its fill level and the drops (see "MEMREAD FLOW CONTROL"). "xg_memread_chunk" is the size of the
+    // next chunk, "xg_memread_drops" the drop count when the last chunk was requested and "xg_ring_fill_peak" the
+    // highest fill level of the ring in per mille since then. "memread_prefetch" is the watermark, at which the next
+    // chunk is requested, 0 chooses it automatically.
+    guint                memread_chunk_size;
+    guint                memread_prefetch;
+    guint                xg_memread_chunk;
+    guint64              xg_memread_drops;
+    volatile gint        xg_ring_fill_peak;
+    // 17.10.2026
+    // The frame count and the state of the cine are queried with a rate limit (see "WATCHING THE RECORDING"). The
+    // intervals are in microseconds, a time of 0 means, that the value has not been queried yet.
+    guint                status_poll_interval;
+    guint                status_poll_max_interval;
+    guint                watch_frames;
+    gint64               watch_frames_time;
+    gboolean             watch_released;
+    gint64               watch_released_time;
 };
 
 typedef struct  {
@@ -460,6 +881,10 @@ typedef struct {
     } type;
     gboolean success;
     GError *error;
+    // 17.10.2026
+    // The lost and the expected bytes of a 10G frame, taken after the receiving thread has finished it
+    gsize missing;
+    gsize expected;
 } Result;
 
 #define DEFINE_CAST(suffix, trans_func)                 \
@@ -489,6 +914,260 @@ DEFINE_CAST (enum,      atoi)   /* not super type safe */
 DEFINE_CAST (boolean,   str_to_boolean)
 
 
+// ********************
+// WAITING FOR PROGRESS
+// ********************
+
+// 17.10.2026
+// The unpack thread (and the decode pool) waits for the data of a frame, which is being received by another thread. The
+// receiving thread publishes its progress ("parser->total", the frame counters) with release semantics and then calls
+// "progress_signal", the waiting thread reads it with acquire semantics in "progress_wait". The waiting thread first
+// spins for "wait-spin-time" microseconds, since the next packet usually is only a few microseconds away and going to
+// sleep would add the latency of a wake up. After that it sleeps on a futex, so that a stalled or slow stream does not
+// burn a core. The futex word is a sequence, which is only increased when somebody actually sleeps, thus the receiving
+// thread does not make a system call per packet.
+
+// The default spin time in microseconds, a few packets at 10G
+#define PROGRESS_SPIN_TIME          20
+
+struct progress {
+    // Increased by "progress_signal", whenever there are waiting threads. The sleeping threads wait for it to change.
+    volatile gint        sequence;
+    // The amount of threads, which have stopped spinning and are going to sleep
+    volatile gint        waiters;
+};
+
+/**
+ * @brief Returns TRUE, once the progress, which the caller of "progress_wait" is waiting for, has been made
+ */
+typedef gboolean (*ProgressCondition) (gpointer data);
+
+/**
+ * @brief Wakes up the threads sleeping in "progress_wait", after new progress has been published
+ *
+ * The progress has to be published (with an atomic store) before calling this. The full barrier orders that store
+ * before reading "waiters", the waiting thread does it the other way around. Thus either the waiting thread sees the
+ * progress, before it goes to sleep, or this sees the waiting thread and wakes it up.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param progress
+ */
+static inline void
+progress_signal (struct progress *progress)
+{
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n (&progress->waiters, __ATOMIC_RELAXED) > 0) {
+        g_atomic_int_inc (&progress->sequence);
+        syscall (SYS_futex, &progress->sequence, FUTEX_WAKE_PRIVATE, G_MAXINT, NULL, NULL, 0);
+    }
+}
+
+/**
+ * @brief Waits until the @p condition is met, by spinning for @p spin_time microseconds and then sleeping
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param progress
+ * @param spin_time The time to spin in microseconds, 0 to go to sleep right away
+ * @param condition
+ * @param data The argument of @p condition
+ */
+static void
+progress_wait (struct progress *progress, gint64 spin_time, ProgressCondition condition, gpointer data)
+{
+    gint64 deadline;
+    gint sequence;
+
+    if (condition (data))
+        return;
+
+    // Reading the clock is a lot more expensive than a pause, it is only done every 64 iterations
+    if (spin_time > 0) {
+        deadline = g_get_monotonic_time () + spin_time;
+
+        for (guint i = 1; ; i++) {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause ();
+#endif
+
+            if (condition (data))
+                return;
+
+            if (i % 64 == 0 && g_get_monotonic_time () >= deadline)
+                break;
+        }
+    }
+
+    // The increment is a full barrier, see "progress_signal". The sequence is read before checking the condition for
+    // the last time, so that the futex does not go to sleep, if it has been signalled in between.
+    g_atomic_int_inc (&progress->waiters);
+
+    while (TRUE) {
+        sequence = g_atomic_int_get (&progress->sequence);
+
+        if (condition (data))
+            break;
+
+        syscall (SYS_futex, &progress->sequence, FUTEX_WAIT_PRIVATE, sequence, NULL, NULL, 0);
+    }
+
+    g_atomic_int_add (&progress->waiters, -1);
+}
+
+
+// ********************************
+// HANDING OVER BETWEEN THE THREADS
+// ********************************
+
+// 17.10.2026
+// The messages for the receiving and the unpack thread and the results for "grab" are handed over through rings of
+// fixed size, each of which has exactly one producing and one consuming thread: the messages are sent by the thread
+// calling "grab" (and start/stop_readout), the results by the receiving thread (during setup, with zero copy decoding
+// and with 1G) or by the unpack thread. The items are copied into the ring by value, so nothing is allocated per
+// frame. The producer only ever writes "tail" and the consumer only "head", neither of them takes a lock as long as
+// there is something to do. Only a consumer, which finds the ring empty, goes to sleep on the condition and is then
+// woken up by the producer.
+
+// More than the frames, which can be in flight (at most 16 frame slots), plus the messages to stop the threads
+#define HANDOFF_CAPACITY            64
+
+struct handoff {
+    guint8              *items;
+    gsize                item_size;
+    // The amount of items pushed and popped so far, written by the producer and the consumer respectively
+    volatile gint        tail;
+    volatile gint        head;
+    // Set by the consumer, while it is waiting for the next item
+    volatile gint        waiting;
+    GMutex               mutex;
+    GCond                cond;
+};
+
+/**
+ * @brief Creates an empty handoff ring for items of the given size
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param item_size
+ * @return
+ */
+static struct handoff *
+handoff_setup (gsize item_size)
+{
+    struct handoff *handoff = g_new0 (struct handoff, 1);
+
+    handoff->items = g_malloc0 (item_size * HANDOFF_CAPACITY);
+    handoff->item_size = item_size;
+    g_mutex_init (&handoff->mutex);
+    g_cond_init (&handoff->cond);
+    return handoff;
+}
+
+/**
+ * @brief Frees the handoff ring, the items left in it are discarded
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param handoff
+ */
+static void
+handoff_teardown (struct handoff *handoff)
+{
+    g_mutex_clear (&handoff->mutex);
+    g_cond_clear (&handoff->cond);
+    g_free (handoff->items);
+    g_free (handoff);
+}
+
+/**
+ * @brief Copies the @p item into the ring and wakes up the consumer, if it is waiting
+ *
+ * The ring never fills up, since the frames in flight are limited. Should it happen anyway, this waits for the
+ * consumer.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param handoff
+ * @param item
+ */
+static void
+handoff_push (struct handoff *handoff, gconstpointer item)
+{
+    guint tail = (guint) handoff->tail;
+
+    while (tail - (guint) g_atomic_int_get (&handoff->head) >= HANDOFF_CAPACITY)
+        g_thread_yield ();
+
+    memcpy (handoff->items + (tail % HANDOFF_CAPACITY) * handoff->item_size, item, handoff->item_size);
+
+    // The item is published before checking for a waiting consumer, the consumer does it the other way around. Thus at
+    // least one of them sees what the other one has written and the wake up cannot get lost.
+    g_atomic_int_set (&handoff->tail, (gint) (tail + 1));
+
+    if (g_atomic_int_get (&handoff->waiting)) {
+        g_mutex_lock (&handoff->mutex);
+        g_cond_signal (&handoff->cond);
+        g_mutex_unlock (&handoff->mutex);
+    }
+}
+
+/**
+ * @brief Copies the oldest item of the ring into @p item, waiting for one if the ring is empty
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param handoff
+ * @param item
+ */
+static void
+handoff_pop (struct handoff *handoff, gpointer item)
+{
+    guint head = (guint) handoff->head;
+
+    if ((guint) g_atomic_int_get (&handoff->tail) == head) {
+        g_mutex_lock (&handoff->mutex);
+        g_atomic_int_set (&handoff->waiting, 1);
+
+        while ((guint) g_atomic_int_get (&handoff->tail) == head)
+            g_cond_wait (&handoff->cond, &handoff->mutex);
+
+        g_atomic_int_set (&handoff->waiting, 0);
+        g_mutex_unlock (&handoff->mutex);
+    }
+
+    memcpy (item, handoff->items + (head % HANDOFF_CAPACITY) * handoff->item_size, handoff->item_size);
+    g_atomic_int_set (&handoff->head, (gint) (head + 1));
+}
+
+/**
+ * @brief Discards the items left in the ring, may only be called while there is no consumer
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param handoff
+ */
+static void
+handoff_clear (struct handoff *handoff)
+{
+    g_atomic_int_set (&handoff->head, g_atomic_int_get (&handoff->tail));
+}
+
 // ***************************************
 // BASIC NETWORK INTERACTIONS WITH PHANTOM
 // ***************************************
@@ -512,6 +1191,11 @@ phantom_lookup_by_id (gint property_id)
  *
  * @author Matthias Vogelgesang
  *
+ * CHANGELOG
+ *
+ * Changed 17.10.2026
+ * Renamed from "phantom_talk", which calls it while holding the lock of the control connection.
+ *
  * @param priv
  * @param request
  * @param reply_loc
@@ -520,11 +1204,11 @@ phantom_lookup_by_id (gint property_id)
  * @return
  */
 static gchar *
-phantom_talk (UcaPhantomCameraPrivate *priv,
-              const gchar *request,
-              gchar *reply_loc,
-              gsize reply_loc_size,
-              GError **error_loc)
+phantom_exchange (UcaPhantomCameraPrivate *priv,
+                  const gchar *request,
+                  gchar *reply_loc,
+                  gsize reply_loc_size,
+                  GError **error_loc)
 {
     GOutputStream *ostream;
     GInputStream *istream;
@@ -603,6 +1287,39 @@ phantom_talk (UcaPhantomCameraPrivate *priv,
     return reply;
 }
 
+/**
+ * @brief Sends the given request to the phantom and returns the response
+ *
+ * The streaming thread (see "STREAMING") requests frames, while the application may get and set properties at the
+ * same time. A request and its reply are therefore exchanged while holding "talk_mutex", so that they are not mixed up
+ * with the ones of another thread.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @param request
+ * @param reply_loc
+ * @param reply_loc_size
+ * @param error_loc
+ * @return
+ */
+static gchar *
+phantom_talk (UcaPhantomCameraPrivate *priv,
+              const gchar *request,
+              gchar *reply_loc,
+              gsize reply_loc_size,
+              GError **error_loc)
+{
+    gchar *reply;
+
+    g_mutex_lock (&priv->talk_mutex);
+    reply = phantom_exchange (priv, request, reply_loc, reply_loc_size, error_loc);
+    g_mutex_unlock (&priv->talk_mutex);
+    return reply;
+}
+
 /**
  * @brief Acquires the value of the attribute given by its name from the phantom
  *
@@ -838,6 +1555,105 @@ get_buffer_size (UcaPhantomCameraPrivate *priv)
     return buffer_size;
 }
 
+/**
+ * @brief Returns whether the pixels are delivered with a single byte each
+ *
+ * This is only possible for the P8 transfer format and has to be enabled with the "enable-8bit-output" property. The
+ * received data is then already the final image and does not have to be unpacked. "sensor-bitdepth" is reported as
+ * 8 in this case, so that libuca allocates one byte per pixel for the grab buffers.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static inline gboolean
+has_8bit_output (UcaPhantomCameraPrivate *priv)
+{
+    return priv->enable_8bit_output && priv->format == IMAGE_FORMAT_P8;
+}
+
+/**
+ * @brief Returns whether the pixels are delivered as float
+ *
+ * This has to be enabled with the "enable-float-output" property and is possible for all formats, which are unpacked.
+ * The pixels are then corrected (see "DARK/FLAT CORRECTION"), even without reference frames, and "has-float-output" is
+ * TRUE. The frame buffers of the camera need 4 bytes per pixel in this case. Only the lent frames are float, "grab"
+ * still delivers 16 bit (see "copy_frame").
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * "sensor-bitdepth" is not reported as 32 anymore, the float output is reported by "has-float-output" instead.
+ *
+ * @param priv
+ * @return
+ */
+static inline gboolean
+has_float_output (UcaPhantomCameraPrivate *priv)
+{
+    return priv->enable_float_output && priv->format != IMAGE_FORMAT_P16 && !has_8bit_output (priv);
+}
+
+/**
+ * @brief Returns the amount of bytes of a single pixel of a decoded frame
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static inline gsize
+get_output_pixel_size (UcaPhantomCameraPrivate *priv)
+{
+    if (has_8bit_output (priv))
+        return 1;
+
+    return has_float_output (priv) ? sizeof (gfloat) : sizeof (guint16);
+}
+
+/**
+ * @brief Copies a decoded frame of the camera into a buffer, which has been passed to "grab"
+ *
+ * libuca and its clients (uca-grab, the camera task of ufo, the ring buffer of libuca) size the grab buffers from
+ * "sensor-bitdepth", thus with at most 2 bytes per pixel. Float frames are therefore only handed out as they are by
+ * "uca_phantom_camera_lend_frame". For "grab" they are rounded and clamped to 16 bit, exactly like the 16 bit
+ * correction does it. @p data may be @p frame itself.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @param frame
+ * @param data
+ */
+static void
+copy_frame (UcaPhantomCameraPrivate *priv, gconstpointer frame, gpointer data)
+{
+    // See "correct_u16_scalar"
+    const gfloat round = 12582912.0f;
+    const gfloat *in = frame;
+    guint16 *out = data;
+    gsize pixels = priv->roi_width * priv->roi_height;
+
+    if (!priv->correction_float) {
+        if (data != frame)
+            memcpy (data, frame, pixels * get_output_pixel_size (priv));
+        return;
+    }
+
+    // In place every pixel is written behind the floats, which are still to be read
+    for (gsize i = 0; i < pixels; i++)
+        out[i] = (guint16) ((CLAMP (in[i], 0.0f, 65535.0f) + round) - round);
+}
+
 static void print_buffer(guint8 *buffer, int length) {
     char string[100000];
     char temp[20];
@@ -853,6 +1669,18 @@ static void print_buffer(guint8 *buffer, int length) {
 // "NORMAL" NETWORK INTERFACE IMAGE TRANSMISSION
 // *********************************************
 
+// 17.10.2026
+// The amount of bytes, which is being received at once, before it is unpacked. Small enough, that the data is still in
+// the cache, when it is unpacked.
+#define READ_DATA_CHUNK_SIZE    (1 << 18)
+
+static inline UnpackKernel get_unpack_kernel (UcaPhantomCameraPrivate *priv);
+static inline gsize get_unpack_group_size (ImageFormat format);
+static void unpack_pixels (UcaPhantomCameraPrivate *priv, UnpackKernel kernel, const guint8 *input, gpointer output,
+                           gsize first_pixel, gsize groups);
+static void unpack_tail (UcaPhantomCameraPrivate *priv, UnpackKernel kernel, const guint8 *input, gsize length,
+                         gpointer output, gsize first_pixel, gsize pixels);
+
 /**
  * @brief Actually receives the image data for normal network connection
  *
@@ -861,27 +1689,70 @@ static void print_buffer(guint8 *buffer, int length) {
  *
  * @author Matthias Vogelgesang
  *
+ * CHANGELOG
+ *
+ * Changed 17.10.2026
+ * The image is now unpacked into the @p output buffer while it is being received, using the same kernels as the 10G
+ * transmission (which also adds P12L and P8). P16 is received directly into the output buffer. If the connection is
+ * closed before the image is complete, an error is set instead of waiting forever.
+ *
+ * Changed 17.10.2026
+ * P8 with 8 bit output is received directly into the output buffer as well.
+ *
+ * Changed 17.10.2026
+ * The unpacked pixels are corrected as well, if enabled (see "DARK/FLAT CORRECTION"), thus the @p output buffer can
+ * also contain floats.
+ *
  * @param priv
  * @param istream
+ * @param output
  * @param error
  */
 static void
-read_data (UcaPhantomCameraPrivate *priv, GInputStream *istream, GError **error)
+read_data (UcaPhantomCameraPrivate *priv, GInputStream *istream, gpointer output, GError **error)
 {
-    gsize to_read;
+    UnpackKernel kernel = has_8bit_output (priv) ? NULL : get_unpack_kernel (priv);
+    gsize group_size = get_unpack_group_size (priv->format);
+    gsize size = get_buffer_size (priv);
+    guint8 *buffer = kernel != NULL ? priv->buffer : (guint8 *) output;
+    gsize received = 0;
+    gsize unpacked = 0;
+    gsize groups;
+
+    // This loop exits after all the bytes of the image have been received. Every chunk is unpacked right away, as far
+    // as it contains complete groups of pixels. The rest of an incomplete group is unpacked with the next chunk.
+    while (received < size) {
+        gssize bytes_read;
+
+        bytes_read = g_input_stream_read (istream, buffer + received, MIN (size - received, READ_DATA_CHUNK_SIZE),
+                                          NULL, error);
+
+        if (bytes_read < 0)
+            return;
+
+        if (bytes_read == 0) {
+            g_set_error (error, UCA_PHANTOM_CAMERA_ERROR, UCA_PHANTOM_CAMERA_ERROR_NO_DATA,
+                         "Data connection closed after %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT " bytes",
+                         received, size);
+            return;
+        }
 
-    to_read = get_buffer_size (priv);
+        received += bytes_read;
 
-    // This loop exits after all the bytes of the image have been received. The "to_read" variable contains the amount
-    // of bytes to be received in the beginning and is then step by step decremented by the amount, that has been
-    // received.
-    while (to_read > 0) {
-        gsize bytes_read;
+        if (kernel != NULL) {
+            groups = (received - unpacked) / group_size;
+            unpack_pixels (priv, kernel, buffer + unpacked, output, unpacked / group_size * UNPACK_GROUP_PIXELS,
+                           groups);
+            unpacked += groups * group_size;
+        }
+    }
 
-        if (!g_input_stream_read_all (istream, priv->buffer, to_read, &bytes_read, NULL, error))
-            return;
+    // If the amount of pixels is not a multiple of 8, the last group is incomplete
+    if (kernel != NULL && unpacked < size) {
+        gsize first_pixel = unpacked / group_size * UNPACK_GROUP_PIXELS;
 
-        to_read -= bytes_read;
+        unpack_tail (priv, kernel, buffer + unpacked, size - unpacked, output, first_pixel,
+                     priv->roi_width * priv->roi_height - first_pixel);
     }
 }
 
@@ -895,6 +1766,11 @@ read_data (UcaPhantomCameraPrivate *priv, GInputStream *istream, GError **error)
  *
  * @author Matthias Vogelgesang
  *
+ * CHANGELOG
+ *
+ * Changed 17.10.2026
+ * The messages and results are handed over by value, nothing is allocated per frame anymore.
+ *
  * @param priv
  * @return
  */
@@ -904,16 +1780,16 @@ accept_img_data (UcaPhantomCameraPrivate *priv)
     GSocketConnection *connection;
     GSocketAddress *remote_addr;
     GInetAddress *inet_addr;
-    Result *result;
+    Result result;
     gchar *addr;
     gboolean stop = FALSE;
     GError *error = NULL;
 
     g_debug ("Accepting data connection ...");
-    result = g_new0 (Result, 1);
+    memset (&result, 0, sizeof (result));
 
-    result->type = RESULT_READY;
-    g_async_queue_push (priv->result_queue, result);
+    result.type = RESULT_READY;
+    handoff_push (priv->result_queue, &result);
 
     // Listening on the socket, waiting for the phantom to establish a new connection
     connection = g_socket_listener_accept (priv->listener, NULL, priv->accept, &error);
@@ -941,26 +1817,27 @@ accept_img_data (UcaPhantomCameraPrivate *priv)
     g_free (addr);
 
     while (!stop) {
-        InternalMessage *message;
+        InternalMessage message;
         GInputStream *istream;
 
         istream = g_io_stream_get_input_stream (G_IO_STREAM (connection));
-        message = g_async_queue_pop (priv->message_queue);
+        handoff_pop (priv->message_queue, &message);
 
-        switch (message->type) {
+        switch (message.type) {
             case MESSAGE_READ_IMAGE:
-                result = g_new0 (Result, 1);
+                memset (&result, 0, sizeof (result));
 
                 // This function, actually does the job of receiving the bytes over the socket connection. The function
-                // will be blocking, until all bytes have been received. The received image data will be saved into
-                // the "priv->buffer".
-                read_data (priv, istream, &result->error);
+                // will be blocking, until all bytes have been received.
+                // 17.10.2026
+                // The image is unpacked directly into the buffer passed to "grab", while it is being received.
+                read_data (priv, istream, message.data, &result.error);
 
                 // After all the image data has been received, a message indicating the success will be put into the
-                // queue, so that the main thread knows, that it can retrieve the image data from the "buffer" now.
-                result->type = RESULT_IMAGE;
-                result->success = TRUE;
-                g_async_queue_push (priv->result_queue, result);
+                // queue, so that the main thread knows, that the image is complete now.
+                result.type = RESULT_IMAGE;
+                result.success = result.error == NULL;
+                handoff_push (priv->result_queue, &result);
                 //g_warning("receive error %s", result->error);
                 break;
 
@@ -974,8 +1851,6 @@ accept_img_data (UcaPhantomCameraPrivate *priv)
                 stop = TRUE;
                 break;
         }
-
-        g_free (message);
     }
 
     //g_warning("EXITS THE RECEIVE LOOP");
@@ -995,6 +1870,53 @@ accept_img_data (UcaPhantomCameraPrivate *priv)
 // 10G NETWORK IMAGE TRANSMISSION
 // ******************************
 
+/**
+ * @brief Allocates the state of the receiving and the unpack thread, each on cache lines of its own
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ */
+static void
+ximg_stages_setup (UcaPhantomCameraPrivate *priv)
+{
+    struct ximg_parser *parser;
+    struct ximg_decoder *decoder;
+
+    if (posix_memalign ((gpointer *) &parser, CACHE_LINE_SIZE, sizeof (struct ximg_parser)) != 0 ||
+        posix_memalign ((gpointer *) &decoder, CACHE_LINE_SIZE, sizeof (struct ximg_decoder)) != 0)
+        g_error ("Could not allocate the state of the 10G threads");
+
+    memset (parser, 0, sizeof (struct ximg_parser));
+    memset (decoder, 0, sizeof (struct ximg_decoder));
+    parser->priv = priv;
+    decoder->priv = priv;
+    decoder->parser = parser;
+
+    priv->xg_parser = parser;
+    priv->xg_decoder = decoder;
+}
+
+/**
+ * @brief Frees the state of the receiving and the unpack thread
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ */
+static void
+ximg_stages_teardown (UcaPhantomCameraPrivate *priv)
+{
+    free (priv->xg_parser);
+    free (priv->xg_decoder);
+    priv->xg_parser = NULL;
+    priv->xg_decoder = NULL;
+}
+
 
 
 /**
@@ -1003,45 +1925,45 @@ accept_img_data (UcaPhantomCameraPrivate *priv)
  * @param priv
  */
 void unpack_packet(UcaPhantomCameraPrivate *priv) {
-    if (priv->xg_remaining_length > 0) {
-        priv->xg_packet_data -= priv->xg_remaining_length - 0;
-        memcpy(priv->xg_packet_data, priv->xg_remaining_data, priv->xg_remaining_length);
+    if (priv->xg_parser->remaining_length > 0) {
+        priv->xg_parser->packet_data -= priv->xg_parser->remaining_length - 0;
+        memcpy(priv->xg_parser->packet_data, priv->xg_parser->remaining_data, priv->xg_parser->remaining_length);
     }
 
     int mask = 0b1111111111;
     int i;
-    int length = (priv->xg_packet_length + priv->xg_remaining_length);
+    int length = (priv->xg_parser->packet_length + priv->xg_parser->remaining_length);
     int overlap = length % 5;
     guint64 temp;
     for (i = 0; i < length - overlap; i += 5) {
         temp = 0;
         temp = 0;
         for (int k = 0; k < 5; k++) {
-            temp |= priv->xg_packet_data[i + k];
+            temp |= priv->xg_parser->packet_data[i + k];
             temp <<= 8;
         }
         temp >>= 8;
 
-        priv->xg_buffer[priv->xg_buffer_index + 3] = (guint16) temp & mask;
-        priv->xg_buffer[priv->xg_buffer_index + 2] = (guint16) (temp >> 10) & mask;
-        priv->xg_buffer[priv->xg_buffer_index + 1] = (guint16) (temp >> 20) & mask;
-        priv->xg_buffer[priv->xg_buffer_index + 0] = (guint16) (temp >> 30) & mask;
-        priv->xg_buffer_index += 4;
+        priv->xg_decoder->out[priv->xg_decoder->buffer_index + 3] = (guint16) temp & mask;
+        priv->xg_decoder->out[priv->xg_decoder->buffer_index + 2] = (guint16) (temp >> 10) & mask;
+        priv->xg_decoder->out[priv->xg_decoder->buffer_index + 1] = (guint16) (temp >> 20) & mask;
+        priv->xg_decoder->out[priv->xg_decoder->buffer_index + 0] = (guint16) (temp >> 30) & mask;
+        priv->xg_decoder->buffer_index += 4;
     }
     // Setting up the overlap for the next iteration
-    priv->xg_packet_data += length - overlap;
-    memcpy(priv->xg_remaining_data, priv->xg_packet_data, overlap);
-    priv->xg_remaining_length = overlap;
+    priv->xg_parser->packet_data += length - overlap;
+    memcpy(priv->xg_parser->remaining_data, priv->xg_parser->packet_data, overlap);
+    priv->xg_parser->remaining_length = overlap;
 }
 
 /**
  * @deprecated
- * @param priv
+ * @param parser
  */
-void mem_copy_packet(UcaPhantomCameraPrivate *priv) {
+void mem_copy_packet(struct ximg_parser *parser) {
 
-    memcpy(priv->xg_data_in, priv->xg_packet_data, priv->xg_packet_length);
-    priv->xg_data_in += priv->xg_packet_length;
+    memcpy(parser->data_in, parser->packet_data, parser->packet_length);
+    parser->data_in += parser->packet_length;
 }
 
 /**
@@ -1076,13 +1998,13 @@ P10_byte_size(UcaPhantomCameraPrivate *priv)
  * @param block_description
  * @param finished
  */
-static void flush_block(UcaPhantomCameraPrivate *priv) {
+static void flush_block(struct ximg_parser *parser) {
 
     // If the block has been completely processed (all payload data extracted from all the packages in it), then it has
     // to be flushed, meaning that it has to be "given back" to the kernel, so new data can be written to it.
     // unless it's status isn't changed, the kernel cannot write new packages into this block of the ring buffer.
-    if (priv->xg_block_finished == TRUE) {
-        priv->xg_current_block->h1.block_status = TP_STATUS_KERNEL;
+    if (parser->block_finished == TRUE) {
+        parser->current_block->h1.block_status = TP_STATUS_KERNEL;
     }
 }
 
@@ -1091,287 +2013,3064 @@ static void flush_block(UcaPhantomCameraPrivate *priv) {
  *
  * @author Jonas Teufel
  *
- * @param priv
+ * @param parser
  */
-void increment_packet(UcaPhantomCameraPrivate *priv) {
-    priv->xg_packet_index += 1;
-    priv->xg_packet_header = (struct tpacket3_hdr *) ((uint8_t *) priv->xg_packet_header + priv->xg_packet_header->tp_next_offset);
+void increment_packet(struct ximg_parser *parser) {
+    parser->packet_index += 1;
+    parser->packet_header = (struct tpacket3_hdr *) ((uint8_t *) parser->packet_header + parser->packet_header->tp_next_offset);
 }
 
+// ******************
+// UNPACKING KERNELS
+// ******************
+
+// 17.10.2026
+// The transfer formats P10, P12L and P8 are unpacked in groups of 8 pixels (10 bytes P10, 12 bytes P12L, 8 bytes P8).
+// Besides the portable version, there are vectorized versions of these "kernels" for SSSE3 (8 pixels per step), AVX2
+// (16 pixels) and AVX-512 VBMI (32 pixels). They are used for the 10G as well as for the 1G transmission. The
+// vectorized kernels are compiled with the "target" attribute, so that the plugin itself does not have to be compiled
+// for a specific instruction set. The kernels, which are being used, are selected using CPUID (see
+// "find_unpack_kernels") and can be changed with the "unpack-kernel" property. benchmarks/unpack-kernels.c compares
+// all of them with the scalar kernels and measures their throughput.
+//
+// A kernel unpacks the given amount of complete groups and never reads beyond them. The vectorized kernels load more
+// bytes than a group has, so they leave the last groups to the next smaller kernel.
+//
+// The SSSE3 kernels are plain SSE code. Before an AVX2 kernel hands over to them, it clears the upper halves of the
+// vector registers with "_mm256_zeroupper", otherwise every SSE instruction afterwards may pay for the transition
+// between the two states. This matters for the correction, which calls the kernels for a few groups at a time.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define UNPACK_X86              1
+#else
+#define UNPACK_X86              0
+#endif
+
 /**
- * @brief Copies the packet data into the image buffer and prepares the pointers for the next iteration
+ * @brief Unpacks groups of P10 pixels (4 pixels in 5 bytes, big endian), without any vector instructions
  *
- * This function processes the data from one packet from the ring buffer
+ * CHANGELOG
  *
- * @author Jonas Teufel
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
+ */
+static void
+unpack_p10_scalar (const guint8 *input, guint16 *output, gsize groups)
+{
+    for (gsize i = 0; i < groups * 2; i++, input += 5, output += 4) {
+        output[0] = (input[0] << 2) | (input[1] >> 6);
+        output[1] = ((input[1] & 0x3f) << 4) | (input[2] >> 4);
+        output[2] = ((input[2] & 0x0f) << 6) | (input[3] >> 2);
+        output[3] = ((input[3] & 0x03) << 8) | input[4];
+    }
+}
+
+/**
+ * @brief Unpacks groups of P12L pixels (2 pixels in 3 bytes, big endian), without any vector instructions
  *
  * CHANGELOG
  *
- * Added 20.05.2019
+ * Added 17.10.2026
  *
- * Changed 29.05.2019
- * There was a bug here. When the processed package was the pre-last one in a block, but also the last one for an image
- * that cause the program to flag the block as finished even though the last block would never be looked at. Thus the
- * last packet in the block would disappear...
- * Added a if clause that checks for the edge case now.
+ * @param input
+ * @param output
+ * @param groups
+ */
+static void
+unpack_p12l_scalar (const guint8 *input, guint16 *output, gsize groups)
+{
+    for (gsize i = 0; i < groups * 4; i++, input += 3, output += 2) {
+        output[0] = (input[0] << 4) | (input[1] >> 4);
+        output[1] = ((input[1] & 0x0f) << 8) | input[2];
+    }
+}
+
+/**
+ * @brief Unpacks groups of P8 pixels, without any vector instructions
  *
- * @param priv
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
  */
-void process_packet(UcaPhantomCameraPrivate *priv) {
+static void
+unpack_p8_scalar (const guint8 *input, guint16 *output, gsize groups)
+{
+    for (gsize i = 0; i < groups * UNPACK_GROUP_PIXELS; i++)
+        output[i] = input[i];
+}
 
-    // If the remaining length of the data is bigger, than the length of the packet, we can just use all the packet
-    // data to append it to the buffer
-    if (priv->xg_remaining_length >= priv->xg_packet_length) {
+/**
+ * @brief Applies the dark/flat correction "(raw - dark) * gain" to unpacked pixels, with 16 bit output
+ *
+ * The result is clamped to the range of 16 bit and rounded to the nearest integer (ties to even), the same way the
+ * vector instructions do it, so that all kernels give identical results.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+static void
+correct_u16_scalar (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    // Adding and subtracting 1.5 * 2^23 rounds a float below 2^22 to an integer with the current rounding mode,
+    // without calling rintf
+    const gfloat round = 12582912.0f;
+    guint16 *out = output;
 
-        // Here we copy the packet data into the image buffer and increment the pointer to the top of the image buffer
-        // for the next iteration
-        memcpy(priv->xg_data_in, priv->xg_packet_data, priv->xg_packet_length);
-        priv->xg_data_in += priv->xg_packet_length;
+    for (gsize i = 0; i < pixels; i++)
+        out[i] = (guint16) ((CLAMP ((raw[i] - dark[i]) * gain[i], 0.0f, 65535.0f) + round) - round);
+}
 
-        // Now we need to update the count of the total bytes received and the remaining bytes
-        priv->xg_total += priv->xg_packet_length;
-        priv->xg_remaining_length -= priv->xg_packet_length;
+/**
+ * @brief Applies the dark/flat correction "(raw - dark) * gain" to unpacked pixels, with float output
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+static void
+correct_f32_scalar (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    gfloat *out = output;
 
-        // We also need to update the pointer to the packet, so that it points to the next packet
-        // 29.05.2019
-        // The edge case of incrementing a packet when ist is the pre-last in a block but the last one for an image
-        // caused a nasty bug with disappearing packages... So we have to check for that now.
-        if (!(priv->xg_remaining_length <= 0 && priv->xg_packet_index == priv->xg_packet_amount - 2)) {
-            increment_packet(priv);
-        } else {
-            priv->xg_packet_skipped = TRUE;
-            //g_warning("I AM ACTUALLY USEFUL");
-        }
-    }
-    // THIS BASICALLY NEVER GETS EXECUTED...
-    // This is the tricky case. This means the image would be completely finished with just a fraction of the data from
-    // the current package. This also means, that some portion of the data from this package belongs to the next image
-    // already... So we have to make sure to set the pointers up correctly, so the next image grab call will pick up
-    // excatly where we left...
-    else if (priv->xg_remaining_length < priv->xg_packet_length) {
+    for (gsize i = 0; i < pixels; i++)
+        out[i] = (raw[i] - dark[i]) * gain[i];
+}
 
-        // Here we will take as many bytes from the buffer, as there are remaining to get the full image...
-        memcpy(priv->xg_data_in, priv->xg_packet_data, priv->xg_remaining_length);
+#if UNPACK_X86
 
-        // Now we update the stats for the image, signaling that all the bytes for this image have been received now
-        // and that there are none remaining
-        priv->xg_total += priv->xg_remaining_length;
-        priv->xg_remaining_length = 0;
+// THE GENERAL IDEA
+// The general way the vectorized unpacking works due to the weird way the SSE Vectors work is two steps:
+// 1) Shuffle: Specific parts of the input vector are shuffled into a new position (especially new 8 bit units of
+// the vector, in such a way, that the following shift operation does not transcend inter block separations. and
+// then the new part-vectors are AND-masked so that they only contain the relevant bits.
+// 2) Shift: All the part-vectors are shifted according to what their position demands and then they are combined
+// by OR-ing them into a single output vector.
+//
+// THE SHUFFLE MASKS
+// These masks shuffle parts of the input vector into new positions, while also reversing the unit switch within
+// the two byte blocks, so this does not have to be dealt with when saving the vector into the output array again.
+// For P10 every mask shuffles the required bytes for two pixels. This is because due to the symmetric nature, the
+// required shifts to be in the right position repeat after 4 pixels.
+//
+// THE AND MASKS
+// These masks will be applied after the shuffle masks. The shuffle masks already get rid of most of the irrelevant
+// bits, but the 16 bit unit of a pixel still contains some bits of its neighbours, which are cropped by the masks.
+// Only the bytes of the group itself are shuffled, so the remaining bytes of a 16 byte load do not matter.
+//
+// The AVX2 kernels use the same masks in both 128 bit lanes (the AVX2 shuffle does not cross lanes) and load the next
+// group into the upper lane.
+static const guint8 p10_shuffle_masks[4][16] = {
+    {1, 0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 6, 5, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 2, 1, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 7, 6, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 3, 2, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 8, 7, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 4, 3, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 9, 8},
+};
 
-        // Now we can update the pointers for the next iteration / the next image. We can make sure that the next
-        // iteration picks up here by just moving the data pointer accordingly by as many bytes as we have just used
-        // and adjusting the data length accordingly. This way we dont need another special case.
-        priv->xg_packet_data += priv->xg_remaining_length;
-        priv->xg_packet_length -= priv->xg_remaining_length;
+static const guint8 p10_and_masks[4][16] = {
+    {0b11000000, 0b11111111, 0, 0, 0, 0, 0, 0, 0b11000000, 0b11111111, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0b11110000, 0b00111111, 0, 0, 0, 0, 0, 0, 0b11110000, 0b00111111, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0b11111100, 0b00001111, 0, 0, 0, 0, 0, 0, 0b11111100, 0b00001111, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0b11111111, 0b00000011, 0, 0, 0, 0, 0, 0, 0b11111111, 0b00000011},
+};
 
-        // Also we will NOT increment the packet index, as we want the next iteration to pick up with this packet...
-    }
-}
+static const guint8 p12l_shuffle_masks[2][16] = {
+    {1, 0, 0x80, 0x80, 4, 3, 0x80, 0x80, 7, 6, 0x80, 0x80, 10, 9, 0x80, 0x80},
+    {0x80, 0x80, 2, 1, 0x80, 0x80, 5, 4, 0x80, 0x80, 8, 7, 0x80, 0x80, 11, 10},
+};
+
+static const guint8 p12l_and_masks[2][16] = {
+    {0b11110000, 0b11111111, 0, 0, 0b11110000, 0b11111111, 0, 0, 0b11110000, 0b11111111, 0, 0, 0b11110000, 0b11111111, 0, 0},
+    {0, 0, 0b11111111, 0b00001111, 0, 0, 0b11111111, 0b00001111, 0, 0, 0b11111111, 0b00001111, 0, 0, 0b11111111, 0b00001111},
+};
+
+// The AVX-512 kernels use a different approach, because VBMI can permute the bytes across the whole 512 bit vector.
+// For every pixel the two bytes, which contain it, are moved into its 16 bit unit (in the right order), which is then
+// shifted right by the amount of bits of the following pixel in the lower byte and masked. 32 pixels are unpacked
+// from 40 (P10) or 48 (P12L) bytes at once.
+static const guint8 p10_permutation[64] __attribute__ ((aligned (64))) = {
+    1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8, 11, 10, 12, 11, 13, 12, 14, 13, 16, 15, 17, 16, 18, 17, 19, 18,
+    21, 20, 22, 21, 23, 22, 24, 23, 26, 25, 27, 26, 28, 27, 29, 28, 31, 30, 32, 31, 33, 32, 34, 33, 36, 35, 37, 36,
+    38, 37, 39, 38,
+};
+
+static const guint8 p12l_permutation[64] __attribute__ ((aligned (64))) = {
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 13, 12, 14, 13, 16, 15, 17, 16, 19, 18, 20, 19, 22, 21, 23, 22,
+    25, 24, 26, 25, 28, 27, 29, 28, 31, 30, 32, 31, 34, 33, 35, 34, 37, 36, 38, 37, 40, 39, 41, 40, 43, 42, 44, 43,
+    46, 45, 47, 46,
+};
 
 /**
- * @brief Extracts the data from one block in the ring buffer and adds it to the destination buffer.
+ * @brief Unpacks groups of P10 pixels with SSSE3, 8 pixels per step
  *
- * @author Jonas Teufel
+ * This is the shuffle/mask/shift algorithm, which "unpack_image_p10" used directly before.
  *
  * CHANGELOG
  *
- * Added 28.04.2019
- *
- * Changed 20.05.2019
- * Completely moved the whole processing of the actual package data of a single packet (memcopy the contents and
- * incrementing of the pointers) to the method "process_packet"
- *
- * Changed 29.05.2019
- * Also saving the amount of packages inside a block into a attribute of the camera object now, so it can be used
- * in the process_packet method without explicitly passing it.
+ * Added 17.10.2026
  *
- * @param block_description
- * @param destination
- * @param expected
- * @param total
- * @param finished
- * @param header
- * @return
+ * @param input
+ * @param output
+ * @param groups
  */
-void process_block(UcaPhantomCameraPrivate *priv) {
-    // Each block can hold multiple actual packets (frames). But the actual amount how many packets are in one block
-    // depends on the size of the packet, speed of transmission etc. In general, the amount is not previously known,
-    // but once the block is done writing, is stored inside the "num_pckts" of its descriptor.
-    int packet_amount = priv->xg_current_block->h1.num_pkts;
-    priv->xg_packet_amount = packet_amount;
+__attribute__ ((target ("ssse3")))
+static void
+unpack_p10_ssse3 (const guint8 *input, guint16 *output, gsize groups)
+{
+    __m128i sm[4], m[4];
+    __m128i vector, t0, t1, t2, t3;
 
-    // This will be the pointer directed at the start of the actual packet data! The data contained in a packet is
-    // byte wise, which means its a unsigned 8 bit format.
-    guint8 *data;
+    for (gint k = 0; k < 4; k++) {
+        sm[k] = _mm_loadu_si128 ((__m128i *) p10_shuffle_masks[k]);
+        m[k] = _mm_loadu_si128 ((__m128i *) p10_and_masks[k]);
+    }
 
-    // This will store the size of the packet's payload
-    int length;
+    // A 16 byte load is 6 bytes longer than the group, so the last group is left for the scalar kernel
+    for (; groups > 1; groups--, input += 10, output += 8) {
+        vector = _mm_loadu_si128 ((__m128i *) input);
 
-    // The finished boolean variable is an indicator of whether the currently processed block is finished or not.
-    // We have to consider the following case: If the loop below break's because all the expected data has been
-    // received for one package, there could possibly still be data of the next image in that ring buffer block.
-    // and we need to indicate this to know, if we should start in this or the next block when attempting to get the
-    // data for that next image.
-    //priv->xg_block_finished = TRUE;
+        t0 = _mm_srli_epi64 (_mm_and_si128 (_mm_shuffle_epi8 (vector, sm[0]), m[0]), 6);
+        t1 = _mm_srli_epi64 (_mm_and_si128 (_mm_shuffle_epi8 (vector, sm[1]), m[1]), 4);
+        t2 = _mm_srli_epi64 (_mm_and_si128 (_mm_shuffle_epi8 (vector, sm[2]), m[2]), 2);
+        t3 = _mm_and_si128 (_mm_shuffle_epi8 (vector, sm[3]), m[3]);
 
-    int i;
-    
-    // Ugly hack, should improve this
-    if (priv->xg_packet_skipped == TRUE) {
-        //g_warning("ALSO USEFUL");
-        increment_packet(priv);
-        priv->xg_packet_skipped = FALSE;
+        _mm_storeu_si128 ((__m128i *) output, _mm_or_si128 (_mm_or_si128 (t0, t1), _mm_or_si128 (t2, t3)));
     }
 
-    for (i = priv->xg_packet_index; i < priv->xg_packet_amount; i++) {
-
-        if (priv->xg_remaining_length <= 0) {
-            break;
-        }
+    unpack_p10_scalar (input, output, groups);
+}
 
-        // Calculation of the actual payload(!) length. The packages sent by the phantom have a overhead of 32 bytes!
-        length = priv->xg_packet_header->tp_snaplen - 32;
-        // After exactly 94 bytes into the package the info about the used protocol can be extracted. And after 114
-        // bytes the overhead ends and the actual payload starts.
-        data = (guint8 *) priv->xg_packet_header;
-        //g_warning("length: %i", length);
-        if (data[94] == 136 && data[95] == 183) {
-            data += 114;
+/**
+ * @brief Unpacks groups of P12L pixels with SSSE3, 8 pixels per step
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
+ */
+__attribute__ ((target ("ssse3")))
+static void
+unpack_p12l_ssse3 (const guint8 *input, guint16 *output, gsize groups)
+{
+    __m128i sm0 = _mm_loadu_si128 ((__m128i *) p12l_shuffle_masks[0]);
+    __m128i sm1 = _mm_loadu_si128 ((__m128i *) p12l_shuffle_masks[1]);
+    __m128i m0 = _mm_loadu_si128 ((__m128i *) p12l_and_masks[0]);
+    __m128i m1 = _mm_loadu_si128 ((__m128i *) p12l_and_masks[1]);
+    __m128i vector, t0, t1;
 
-            // With this we copy all the data (using the complete length of the payload) onto the destination buffer (where
-            // the final image data will be stored)
-            priv->xg_packet_data = data;
-            priv->xg_packet_length = length;
+    for (; groups > 1; groups--, input += 12, output += 8) {
+        vector = _mm_loadu_si128 ((__m128i *) input);
 
-            process_packet(priv);
+        t0 = _mm_srli_epi64 (_mm_and_si128 (_mm_shuffle_epi8 (vector, sm0), m0), 4);
+        t1 = _mm_and_si128 (_mm_shuffle_epi8 (vector, sm1), m1);
 
-        } else {
-            increment_packet(priv);
-        }
+        _mm_storeu_si128 ((__m128i *) output, _mm_or_si128 (t0, t1));
     }
 
-    // Here we are simply checking "Did the loop process all the packets of the blog?". Because if it did than obviously
-    // This block is finished and we can flag it as such. But if it is not, than the next image has to pick up with
-    // this block.
-    if (priv->xg_packet_amount - 1 > priv->xg_packet_index) {
-        priv->xg_block_finished = FALSE;
-    } else {
-        priv->xg_block_finished = TRUE;
-        //g_warning("block finished");
-    }
+    unpack_p12l_scalar (input, output, groups);
 }
 
-
 /**
- * @brief Receives / reads the image data being transmitted over the 10G interface.
+ * @brief Unpacks groups of P10 pixels with AVX2, 16 pixels per step
  *
- * @author Jonas Teufel
+ * CHANGELOG
  *
- * @param priv
- * @param fd
- * @param ring
- * @param poll_fd
- * @param block_index
- * @param finished
- * @param header
- * @param error
- * @return
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
  */
-static int
-read_ximg_data (
-        UcaPhantomCameraPrivate *priv,
-        gint fd,
-        struct ring *ring,
-        struct pollfd *poll_fd,
-        GError **error)
+__attribute__ ((target ("avx2")))
+static void
+unpack_p10_avx2 (const guint8 *input, guint16 *output, gsize groups)
 {
+    __m256i sm[4], m[4];
+    __m256i vector, t0, t1, t2, t3;
 
-    // With this we keep track of how many bytes have already been received.
-    priv->xg_total = 0;
-    gsize total = 0;
-    int bytes;
-    int remaining;
-    
-    // Resetting state variables
-    priv->xg_remaining_length = 0;
-    priv->xg_data_in = priv->xg_data_buffer.in;
-    
-    unsigned long header_address;
+    for (gint k = 0; k < 4; k++) {
+        sm[k] = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((__m128i *) p10_shuffle_masks[k]));
+        m[k] = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((__m128i *) p10_and_masks[k]));
+    }
 
-    // This is the amount of bytes that has to be received, based on the resolution of the image and the structure of
-    // the 10G transfer format (always P10).
-    int expected_bytes = get_buffer_size(priv);
-    priv->xg_expected = get_buffer_size(priv);
+    // The upper lane is loaded from the second group, so 26 bytes are read for 20 bytes of data
+    for (; groups > 2; groups -= 2, input += 20, output += 16) {
+        vector = _mm256_inserti128_si256 (_mm256_castsi128_si256 (_mm_loadu_si128 ((__m128i *) input)),
+                                          _mm_loadu_si128 ((__m128i *) (input + 10)), 1);
 
-    // This struct will contain all the necessary iformation about the block of the ring buffer, that is currently
-    // being processed
-    struct block_desc *block_description;
+        t0 = _mm256_srli_epi64 (_mm256_and_si256 (_mm256_shuffle_epi8 (vector, sm[0]), m[0]), 6);
+        t1 = _mm256_srli_epi64 (_mm256_and_si256 (_mm256_shuffle_epi8 (vector, sm[1]), m[1]), 4);
+        t2 = _mm256_srli_epi64 (_mm256_and_si256 (_mm256_shuffle_epi8 (vector, sm[2]), m[2]), 2);
+        t3 = _mm256_and_si256 (_mm256_shuffle_epi8 (vector, sm[3]), m[3]);
 
-    //unsigned int block_index = 0;
-    unsigned int block_amount = 10000;
+        _mm256_storeu_si256 ((__m256i *) output, _mm256_or_si256 (_mm256_or_si256 (t0, t1), _mm256_or_si256 (t2, t3)));
+    }
 
-    // For profiling the code
-    struct timespec tstart={0,0}, tend={0,0};
-    struct timespec pstart={0,0}, pend={0,0};
-    
-    priv->xg_remaining_length = priv->xg_expected;
+    _mm256_zeroupper ();
+    unpack_p10_ssse3 (input, output, groups);
+}
 
+/**
+ * @brief Unpacks groups of P12L pixels with AVX2, 16 pixels per step
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
+ */
+__attribute__ ((target ("avx2")))
+static void
+unpack_p12l_avx2 (const guint8 *input, guint16 *output, gsize groups)
+{
+    __m256i sm0 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((__m128i *) p12l_shuffle_masks[0]));
+    __m256i sm1 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((__m128i *) p12l_shuffle_masks[1]));
+    __m256i m0 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((__m128i *) p12l_and_masks[0]));
+    __m256i m1 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((__m128i *) p12l_and_masks[1]));
+    __m256i vector, t0, t1;
 
-    //clock_gettime(CLOCK_MONOTONIC, &tstart);
-    while (priv->xg_total < priv->xg_expected) {
+    for (; groups > 2; groups -= 2, input += 24, output += 16) {
+        vector = _mm256_inserti128_si256 (_mm256_castsi128_si256 (_mm_loadu_si128 ((__m128i *) input)),
+                                          _mm_loadu_si128 ((__m128i *) (input + 12)), 1);
 
-        // Creating the block description for the current block index from the ring buffer.
-        //block_description = (struct block_desc *) ring->rd[block_index].iov_base;
-        priv->xg_current_block = (struct block_desc *) ring->rd[priv->xg_block_index].iov_base;
+        t0 = _mm256_srli_epi64 (_mm256_and_si256 (_mm256_shuffle_epi8 (vector, sm0), m0), 4);
+        t1 = _mm256_and_si256 (_mm256_shuffle_epi8 (vector, sm1), m1);
 
-        // Polling.
-        // Once the kernel has finished writing to a block of the buffer (either because it is full, or because the
-        // timer ran out), this block is being released to the user space (-> this program) and only then we can
-        // read it. So the program execution of the loop will be skipped here, if the next block has not yet been
-        // released to the user space.
-        if ((priv->xg_current_block->h1.block_status & TP_STATUS_USER) == 0) {
-            poll(poll_fd, 1, -1);
-            continue;
-        }
+        _mm256_storeu_si256 ((__m256i *) output, _mm256_or_si256 (t0, t1));
+    }
 
-        if (priv->xg_block_finished == TRUE) {
-            // In case block was finished during the previous run of this function, the header struct will be created
-            // to point to the first packet of the current (new) block.
-            // Although if it wasn't finished the header for the packet, where the last loop left of will be reused.
-            priv->xg_packet_header = (struct tpacket3_hdr *) ((uint8_t *) priv->xg_current_block +
-                                                              priv->xg_current_block->h1.offset_to_first_pkt);
-            priv->xg_packet_index = 0;
-        }
+    _mm256_zeroupper ();
+    unpack_p12l_ssse3 (input, output, groups);
+}
 
-        // Actually extracting the data of the packages in that block into the destination buffer.
+/**
+ * @brief Unpacks groups of P10 pixels with AVX-512 VBMI, 32 pixels per step
+ *
+ * The input is loaded with a byte mask, so exactly the 40 bytes of the 4 groups are read.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
+ */
+__attribute__ ((target ("avx512f,avx512bw,avx512vbmi")))
+static void
+unpack_p10_avx512 (const guint8 *input, guint16 *output, gsize groups)
+{
+    const __m512i permutation = _mm512_load_si512 (p10_permutation);
+    const __m512i shifts = _mm512_set1_epi64 (0x0000000200040006);
+    const __m512i mask = _mm512_set1_epi16 (0x03ff);
+    __m512i vector;
+
+    for (; groups >= 4; groups -= 4, input += 40, output += 32) {
+        vector = _mm512_maskz_loadu_epi8 ((1ULL << 40) - 1, input);
+        vector = _mm512_permutexvar_epi8 (permutation, vector);
+        _mm512_storeu_si512 (output, _mm512_and_si512 (_mm512_srlv_epi16 (vector, shifts), mask));
+    }
 
-        process_block(priv);
-        flush_block(priv);
+    unpack_p10_avx2 (input, output, groups);
+}
 
-        // If the block is not yet finished to be processed we cannot increment the index, so that with the next call
-        // of this function the rest of the unfinished block will be processed first.
-        if (priv->xg_block_finished == TRUE) {
-            // Going to the next block. If the last block has been reached, it starts with the first block again,
-            // after all this is how a ring buffer works.
-            priv->xg_block_index = (priv->xg_block_index + 1) % block_amount;
-        }
+/**
+ * @brief Unpacks groups of P12L pixels with AVX-512 VBMI, 32 pixels per step
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
+ */
+__attribute__ ((target ("avx512f,avx512bw,avx512vbmi")))
+static void
+unpack_p12l_avx512 (const guint8 *input, guint16 *output, gsize groups)
+{
+    const __m512i permutation = _mm512_load_si512 (p12l_permutation);
+    const __m512i shifts = _mm512_set1_epi32 (0x00000004);
+    const __m512i mask = _mm512_set1_epi16 (0x0fff);
+    __m512i vector;
+
+    for (; groups >= 4; groups -= 4, input += 48, output += 32) {
+        vector = _mm512_maskz_loadu_epi8 ((1ULL << 48) - 1, input);
+        vector = _mm512_permutexvar_epi8 (permutation, vector);
+        _mm512_storeu_si512 (output, _mm512_and_si512 (_mm512_srlv_epi16 (vector, shifts), mask));
     }
-    return 0;
+
+    unpack_p12l_avx2 (input, output, groups);
 }
 
 /**
- * @brief sets up the raw socket to be used for the ethernet frames, using the ring buffer
+ * @brief Unpacks groups of P8 pixels with SSSE3, 16 pixels per step
  *
- * @author Jonas Teufel
+ * P8 only has to be zero extended, so the vector kernels for P8 read exactly the bytes of their groups.
  *
- * @param ring
- * @param netdev
- * @return
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
  */
-static int setup_raw_socket(struct ring *ring, char *netdev) {
+__attribute__ ((target ("ssse3")))
+static void
+unpack_p8_ssse3 (const guint8 *input, guint16 *output, gsize groups)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i vector;
 
-    guint sock_opt;
-    // This will be the variable, into which we are saving the exit codes of all the functions. These functions will
+    for (; groups >= 2; groups -= 2, input += 16, output += 16) {
+        vector = _mm_loadu_si128 ((__m128i *) input);
+        _mm_storeu_si128 ((__m128i *) output, _mm_unpacklo_epi8 (vector, zero));
+        _mm_storeu_si128 ((__m128i *) (output + 8), _mm_unpackhi_epi8 (vector, zero));
+    }
+
+    unpack_p8_scalar (input, output, groups);
+}
+
+/**
+ * @brief Unpacks groups of P8 pixels with AVX2, 32 pixels per step
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
+ */
+__attribute__ ((target ("avx2")))
+static void
+unpack_p8_avx2 (const guint8 *input, guint16 *output, gsize groups)
+{
+    for (; groups >= 4; groups -= 4, input += 32, output += 32) {
+        _mm256_storeu_si256 ((__m256i *) output, _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((__m128i *) input)));
+        _mm256_storeu_si256 ((__m256i *) (output + 16),
+                             _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((__m128i *) (input + 16))));
+    }
+
+    _mm256_zeroupper ();
+    unpack_p8_ssse3 (input, output, groups);
+}
+
+/**
+ * @brief Unpacks groups of P8 pixels with AVX-512, 64 pixels per step
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param input
+ * @param output
+ * @param groups
+ */
+__attribute__ ((target ("avx512f,avx512bw,avx512vbmi")))
+static void
+unpack_p8_avx512 (const guint8 *input, guint16 *output, gsize groups)
+{
+    for (; groups >= 8; groups -= 8, input += 64, output += 64) {
+        _mm512_storeu_si512 (output, _mm512_cvtepu8_epi16 (_mm256_loadu_si256 ((__m256i *) input)));
+        _mm512_storeu_si512 (output + 32, _mm512_cvtepu8_epi16 (_mm256_loadu_si256 ((__m256i *) (input + 32))));
+    }
+
+    unpack_p8_avx2 (input, output, groups);
+}
+
+/**
+ * @brief Applies the dark/flat correction with SSSE3, 8 pixels per step, with 16 bit output
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+__attribute__ ((target ("ssse3")))
+static void
+correct_u16_ssse3 (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    guint16 *out = output;
+    const __m128i zero = _mm_setzero_si128 ();
+    const __m128i offset = _mm_set1_epi32 (32768);
+    const __m128i sign = _mm_set1_epi16 ((gint16) 0x8000);
+    const __m128 low = _mm_setzero_ps ();
+    const __m128 high = _mm_set1_ps (65535.0f);
+    __m128i values;
+    __m128 v0, v1;
+
+    // Without SSE4.1 there is no unsigned saturating pack. The values are moved into the signed range instead, packed
+    // and moved back by flipping the sign bit.
+    for (; pixels >= 8; pixels -= 8, raw += 8, dark += 8, gain += 8, out += 8) {
+        values = _mm_loadu_si128 ((__m128i *) raw);
+        v0 = _mm_cvtepi32_ps (_mm_unpacklo_epi16 (values, zero));
+        v1 = _mm_cvtepi32_ps (_mm_unpackhi_epi16 (values, zero));
+
+        v0 = _mm_mul_ps (_mm_sub_ps (v0, _mm_loadu_ps (dark)), _mm_loadu_ps (gain));
+        v1 = _mm_mul_ps (_mm_sub_ps (v1, _mm_loadu_ps (dark + 4)), _mm_loadu_ps (gain + 4));
+        v0 = _mm_min_ps (_mm_max_ps (v0, low), high);
+        v1 = _mm_min_ps (_mm_max_ps (v1, low), high);
+
+        values = _mm_packs_epi32 (_mm_sub_epi32 (_mm_cvtps_epi32 (v0), offset),
+                                  _mm_sub_epi32 (_mm_cvtps_epi32 (v1), offset));
+        _mm_storeu_si128 ((__m128i *) out, _mm_xor_si128 (values, sign));
+    }
+
+    correct_u16_scalar (raw, dark, gain, out, pixels);
+}
+
+/**
+ * @brief Applies the dark/flat correction with SSSE3, 8 pixels per step, with float output
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+__attribute__ ((target ("ssse3")))
+static void
+correct_f32_ssse3 (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    gfloat *out = output;
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i values;
+    __m128 v0, v1;
+
+    for (; pixels >= 8; pixels -= 8, raw += 8, dark += 8, gain += 8, out += 8) {
+        values = _mm_loadu_si128 ((__m128i *) raw);
+        v0 = _mm_cvtepi32_ps (_mm_unpacklo_epi16 (values, zero));
+        v1 = _mm_cvtepi32_ps (_mm_unpackhi_epi16 (values, zero));
+
+        _mm_storeu_ps (out, _mm_mul_ps (_mm_sub_ps (v0, _mm_loadu_ps (dark)), _mm_loadu_ps (gain)));
+        _mm_storeu_ps (out + 4, _mm_mul_ps (_mm_sub_ps (v1, _mm_loadu_ps (dark + 4)), _mm_loadu_ps (gain + 4)));
+    }
+
+    correct_f32_scalar (raw, dark, gain, out, pixels);
+}
+
+/**
+ * @brief Applies the dark/flat correction with AVX2, 16 pixels per step, with 16 bit output
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+__attribute__ ((target ("avx2")))
+static void
+correct_u16_avx2 (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    guint16 *out = output;
+    const __m256 low = _mm256_setzero_ps ();
+    const __m256 high = _mm256_set1_ps (65535.0f);
+    __m256i values;
+    __m256 v0, v1;
+
+    for (; pixels >= 16; pixels -= 16, raw += 16, dark += 16, gain += 16, out += 16) {
+        v0 = _mm256_cvtepi32_ps (_mm256_cvtepu16_epi32 (_mm_loadu_si128 ((__m128i *) raw)));
+        v1 = _mm256_cvtepi32_ps (_mm256_cvtepu16_epi32 (_mm_loadu_si128 ((__m128i *) (raw + 8))));
+
+        v0 = _mm256_mul_ps (_mm256_sub_ps (v0, _mm256_loadu_ps (dark)), _mm256_loadu_ps (gain));
+        v1 = _mm256_mul_ps (_mm256_sub_ps (v1, _mm256_loadu_ps (dark + 8)), _mm256_loadu_ps (gain + 8));
+        v0 = _mm256_min_ps (_mm256_max_ps (v0, low), high);
+        v1 = _mm256_min_ps (_mm256_max_ps (v1, low), high);
+
+        // The pack works within the 128 bit lanes, so the 64 bit blocks have to be put back into order
+        values = _mm256_packus_epi32 (_mm256_cvtps_epi32 (v0), _mm256_cvtps_epi32 (v1));
+        _mm256_storeu_si256 ((__m256i *) out, _mm256_permute4x64_epi64 (values, 0xd8));
+    }
+
+    _mm256_zeroupper ();
+    correct_u16_ssse3 (raw, dark, gain, out, pixels);
+}
+
+/**
+ * @brief Applies the dark/flat correction with AVX2, 16 pixels per step, with float output
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+__attribute__ ((target ("avx2")))
+static void
+correct_f32_avx2 (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    gfloat *out = output;
+    __m256 v0, v1;
+
+    for (; pixels >= 16; pixels -= 16, raw += 16, dark += 16, gain += 16, out += 16) {
+        v0 = _mm256_cvtepi32_ps (_mm256_cvtepu16_epi32 (_mm_loadu_si128 ((__m128i *) raw)));
+        v1 = _mm256_cvtepi32_ps (_mm256_cvtepu16_epi32 (_mm_loadu_si128 ((__m128i *) (raw + 8))));
+
+        _mm256_storeu_ps (out, _mm256_mul_ps (_mm256_sub_ps (v0, _mm256_loadu_ps (dark)), _mm256_loadu_ps (gain)));
+        _mm256_storeu_ps (out + 8, _mm256_mul_ps (_mm256_sub_ps (v1, _mm256_loadu_ps (dark + 8)),
+                                                  _mm256_loadu_ps (gain + 8)));
+    }
+
+    _mm256_zeroupper ();
+    correct_f32_ssse3 (raw, dark, gain, out, pixels);
+}
+
+/**
+ * @brief Applies the dark/flat correction with AVX-512, 32 pixels per step, with 16 bit output
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+__attribute__ ((target ("avx512f,avx512bw,avx512vbmi")))
+static void
+correct_u16_avx512 (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    guint16 *out = output;
+    const __m512 low = _mm512_setzero_ps ();
+    const __m512 high = _mm512_set1_ps (65535.0f);
+    __m512 v0, v1;
+
+    for (; pixels >= 32; pixels -= 32, raw += 32, dark += 32, gain += 32, out += 32) {
+        v0 = _mm512_cvtepi32_ps (_mm512_cvtepu16_epi32 (_mm256_loadu_si256 ((__m256i *) raw)));
+        v1 = _mm512_cvtepi32_ps (_mm512_cvtepu16_epi32 (_mm256_loadu_si256 ((__m256i *) (raw + 16))));
+
+        v0 = _mm512_mul_ps (_mm512_sub_ps (v0, _mm512_loadu_ps (dark)), _mm512_loadu_ps (gain));
+        v1 = _mm512_mul_ps (_mm512_sub_ps (v1, _mm512_loadu_ps (dark + 16)), _mm512_loadu_ps (gain + 16));
+        v0 = _mm512_min_ps (_mm512_max_ps (v0, low), high);
+        v1 = _mm512_min_ps (_mm512_max_ps (v1, low), high);
+
+        _mm256_storeu_si256 ((__m256i *) out, _mm512_cvtusepi32_epi16 (_mm512_cvtps_epi32 (v0)));
+        _mm256_storeu_si256 ((__m256i *) (out + 16), _mm512_cvtusepi32_epi16 (_mm512_cvtps_epi32 (v1)));
+    }
+
+    correct_u16_avx2 (raw, dark, gain, out, pixels);
+}
+
+/**
+ * @brief Applies the dark/flat correction with AVX-512, 32 pixels per step, with float output
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param raw
+ * @param dark
+ * @param gain
+ * @param output
+ * @param pixels
+ */
+__attribute__ ((target ("avx512f,avx512bw,avx512vbmi")))
+static void
+correct_f32_avx512 (const guint16 *raw, const gfloat *dark, const gfloat *gain, gpointer output, gsize pixels)
+{
+    gfloat *out = output;
+    __m512 v0, v1;
+
+    for (; pixels >= 32; pixels -= 32, raw += 32, dark += 32, gain += 32, out += 32) {
+        v0 = _mm512_cvtepi32_ps (_mm512_cvtepu16_epi32 (_mm256_loadu_si256 ((__m256i *) raw)));
+        v1 = _mm512_cvtepi32_ps (_mm512_cvtepu16_epi32 (_mm256_loadu_si256 ((__m256i *) (raw + 16))));
+
+        _mm512_storeu_ps (out, _mm512_mul_ps (_mm512_sub_ps (v0, _mm512_loadu_ps (dark)), _mm512_loadu_ps (gain)));
+        _mm512_storeu_ps (out + 16, _mm512_mul_ps (_mm512_sub_ps (v1, _mm512_loadu_ps (dark + 16)),
+                                                   _mm512_loadu_ps (gain + 16)));
+    }
+
+    correct_f32_avx2 (raw, dark, gain, out, pixels);
+}
+
+static gboolean
+cpu_supports_avx512 (void)
+{
+    return __builtin_cpu_supports ("avx512bw") && __builtin_cpu_supports ("avx512vbmi");
+}
+
+static gboolean
+cpu_supports_avx2 (void)
+{
+    return __builtin_cpu_supports ("avx2");
+}
+
+static gboolean
+cpu_supports_ssse3 (void)
+{
+    return __builtin_cpu_supports ("ssse3");
+}
+
+#endif
+
+// The available kernels, the fastest first. "supported" is NULL, if the kernel can be used on any CPU.
+static const UnpackKernels unpack_kernels[] = {
+#if UNPACK_X86
+    { "avx512", cpu_supports_avx512,  unpack_p10_avx512,  unpack_p12l_avx512,  unpack_p8_avx512,
+      correct_u16_avx512,  correct_f32_avx512 },
+    { "avx2",   cpu_supports_avx2,    unpack_p10_avx2,    unpack_p12l_avx2,    unpack_p8_avx2,
+      correct_u16_avx2,    correct_f32_avx2 },
+    { "ssse3",  cpu_supports_ssse3,   unpack_p10_ssse3,   unpack_p12l_ssse3,   unpack_p8_ssse3,
+      correct_u16_ssse3,   correct_f32_ssse3 },
+#endif
+    { "scalar", NULL,                 unpack_p10_scalar,  unpack_p12l_scalar,  unpack_p8_scalar,
+      correct_u16_scalar,  correct_f32_scalar },
+};
+
+/**
+ * @brief Returns the unpacking kernels with the given name, if they are supported by the CPU
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param name The name of the kernels or NULL/"" for the fastest kernels supported by the CPU
+ * @return NULL if there are no supported kernels with this name
+ */
+static const UnpackKernels *
+find_unpack_kernels (const gchar *name)
+{
+    gboolean any = name == NULL || name[0] == '\0';
+
+#if UNPACK_X86
+    __builtin_cpu_init ();
+#endif
+
+    for (guint i = 0; i < G_N_ELEMENTS (unpack_kernels); i++) {
+        if (!any && g_strcmp0 (name, unpack_kernels[i].name) != 0)
+            continue;
+
+        if (unpack_kernels[i].supported == NULL || unpack_kernels[i].supported ())
+            return &unpack_kernels[i];
+
+        if (!any)
+            return NULL;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Returns the kernel, which unpacks the transfer format of the current readout
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return NULL for P16, which does not have to be unpacked
+ */
+static inline UnpackKernel
+get_unpack_kernel (UcaPhantomCameraPrivate *priv)
+{
+    switch (priv->format) {
+        case IMAGE_FORMAT_P10:
+            return priv->xg_unpack->p10;
+        case IMAGE_FORMAT_P12L:
+            return priv->xg_unpack->p12l;
+        case IMAGE_FORMAT_P8:
+            return priv->xg_unpack->p8;
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Returns the amount of bytes of a group of 8 pixels in the given transfer format
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param format
+ * @return
+ */
+static inline gsize
+get_unpack_group_size (ImageFormat format)
+{
+    switch (format) {
+        case IMAGE_FORMAT_P10:
+            return 10;
+        case IMAGE_FORMAT_P12L:
+            return 12;
+        case IMAGE_FORMAT_P8:
+            return 8;
+        default:
+            return 16;
+    }
+}
+
+// **********************
+// DARK/FLAT CORRECTION
+// **********************
+
+// 17.10.2026
+// Optionally the images are corrected with a dark and a flat field reference frame while they are being unpacked:
+//
+//      corrected = (raw - dark) * gain,    gain = mean (flat - dark) / (flat - dark)
+//
+// Instead of a separate pass over the whole unpacked frame, a few groups at a time are unpacked into a small buffer,
+// which stays in the L1 cache, and corrected from there into the output buffer. This way the frame is only written
+// once. The output is either 16 bit (rounded and clamped) or float ("enable-float-output"). The correction is only
+// available for the formats, which are being unpacked (P10, P12L and P8 with 16 bit output).
+
+// The amount of groups, which are unpacked into the intermediate buffer at once (256 pixels, 512 bytes)
+#define CORRECTION_CHUNK_GROUPS     32
+
+/**
+ * @brief Writes the given unpacked pixels into the output buffer, applying the correction of the current readout
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The pointers into the reference frames are only computed, if there are reference frames.
+ *
+ * @param priv
+ * @param raw
+ * @param output The output buffer of the whole frame
+ * @param first_pixel The index of the first pixel within the frame
+ * @param pixels
+ */
+static inline void
+store_pixels (UcaPhantomCameraPrivate *priv, const guint16 *raw, gpointer output, gsize first_pixel, gsize pixels)
+{
+    const gfloat *dark;
+    const gfloat *gain;
+
+    if (priv->correction_dark == NULL) {
+        memcpy ((guint16 *) output + first_pixel, raw, pixels * sizeof (guint16));
+        return;
+    }
+
+    dark = priv->correction_dark + first_pixel;
+    gain = priv->correction_gain + first_pixel;
+
+    if (priv->correction_float)
+        priv->xg_unpack->correct_f32 (raw, dark, gain, (gfloat *) output + first_pixel, pixels);
+    else
+        priv->xg_unpack->correct_u16 (raw, dark, gain, (guint16 *) output + first_pixel, pixels);
+}
+
+/**
+ * @brief Unpacks complete groups of pixels into the output buffer of a frame, correcting them if enabled
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @param kernel
+ * @param input
+ * @param output The output buffer of the whole frame
+ * @param first_pixel The index of the first pixel of the groups within the frame
+ * @param groups
+ */
+static void
+unpack_pixels (UcaPhantomCameraPrivate *priv, UnpackKernel kernel, const guint8 *input, gpointer output,
+               gsize first_pixel, gsize groups)
+{
+    guint16 raw[CORRECTION_CHUNK_GROUPS * UNPACK_GROUP_PIXELS];
+    gsize group_size = get_unpack_group_size (priv->format);
+    gsize chunk;
+
+    if (priv->correction_dark == NULL) {
+        kernel (input, (guint16 *) output + first_pixel, groups);
+        return;
+    }
+
+    for (; groups > 0; groups -= chunk) {
+        chunk = MIN (groups, CORRECTION_CHUNK_GROUPS);
+        kernel (input, raw, chunk);
+        store_pixels (priv, raw, output, first_pixel, chunk * UNPACK_GROUP_PIXELS);
+
+        input += chunk * group_size;
+        first_pixel += chunk * UNPACK_GROUP_PIXELS;
+    }
+}
+
+/**
+ * @brief Unpacks the last, incomplete group of an image, whose amount of pixels is not a multiple of 8
+ *
+ * The bytes are copied into a zero padded group first, so that neither the input nor the output buffer is accessed
+ * beyond its end.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The pixels are corrected as well, thus the position within the frame is needed.
+ *
+ * @param priv
+ * @param kernel
+ * @param input
+ * @param length The amount of bytes left in the input buffer, at most a group
+ * @param output The output buffer of the whole frame
+ * @param first_pixel The index of the first pixel of the group within the frame
+ * @param pixels The amount of pixels left in the output buffer, at most 8
+ */
+static void
+unpack_tail (UcaPhantomCameraPrivate *priv, UnpackKernel kernel, const guint8 *input, gsize length, gpointer output,
+             gsize first_pixel, gsize pixels)
+{
+    guint8 group[16] = {0,};
+    guint16 unpacked[UNPACK_GROUP_PIXELS];
+
+    memcpy (group, input, length);
+    kernel (group, unpacked, 1);
+    store_pixels (priv, unpacked, output, first_pixel, pixels);
+}
+
+/**
+ * @brief Reads a reference frame file and averages its frames into @p average
+ *
+ * The file contains one or more raw frames with the size of the ROI and 16 bit per pixel, as they are delivered by
+ * "grab" without any correction.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param filename
+ * @param pixels The amount of pixels of a frame
+ * @param average
+ * @param error
+ * @return
+ */
+static gboolean
+read_reference_frames (const gchar *filename, gsize pixels, gfloat *average, GError **error)
+{
+    gchar *contents;
+    gsize length;
+    gsize frames;
+    const guint16 *values;
+
+    if (!g_file_get_contents (filename, &contents, &length, error))
+        return FALSE;
+
+    if (length == 0 || length % (pixels * sizeof (guint16)) != 0) {
+        g_set_error (error, UCA_PHANTOM_CAMERA_ERROR, UCA_PHANTOM_CAMERA_ERROR_START_RECORDING,
+                     "%s does not contain 16 bit frames of %" G_GSIZE_FORMAT " pixels", filename, pixels);
+        g_free (contents);
+        return FALSE;
+    }
+
+    frames = length / (pixels * sizeof (guint16));
+    values = (const guint16 *) contents;
+
+    for (gsize i = 0; i < pixels; i++) {
+        guint64 sum = 0;
+
+        for (gsize frame = 0; frame < frames; frame++)
+            sum += values[frame * pixels + i];
+
+        average[i] = (gdouble) sum / frames;
+    }
+
+    g_free (contents);
+    return TRUE;
+}
+
+/**
+ * @brief Frees the reference frames of the correction after the readout
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Also ends the float output of the readout.
+ *
+ * @param priv
+ */
+static void
+stop_correction (UcaPhantomCameraPrivate *priv)
+{
+    g_free (priv->correction_dark);
+    g_free (priv->correction_gain);
+    priv->correction_dark = NULL;
+    priv->correction_gain = NULL;
+    priv->correction_float = FALSE;
+}
+
+/**
+ * @brief Returns whether the images of the running readout are being corrected or delivered as float
+ *
+ * The reference frames and the frame buffers of the readout have been set up for its ROI and pixel size, which
+ * therefore must not change until the readout has stopped.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static inline gboolean
+is_correcting (UcaPhantomCameraPrivate *priv)
+{
+    return priv->correction_dark != NULL || priv->correction_float;
+}
+
+/**
+ * @brief Loads the reference frames for the correction of the readout, which is about to start
+ *
+ * Without a dark frame the dark level is 0, without a flat frame the gain is 1. Pixels, which are not brighter in the
+ * flat than in the dark frame, cannot be corrected and are set to 0. Nothing is loaded, if there is nothing to
+ * correct.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @param error
+ * @return
+ */
+static gboolean
+start_correction (UcaPhantomCameraPrivate *priv, GError **error)
+{
+    gsize pixels = priv->roi_width * priv->roi_height;
+    gboolean have_dark = priv->dark_frame_file != NULL && priv->dark_frame_file[0] != '\0';
+    gboolean have_flat = priv->flat_frame_file != NULL && priv->flat_frame_file[0] != '\0';
+    gfloat *flat;
+    gdouble mean = 0.0;
+
+    // A readout, which failed to start, may have left the previous reference frames
+    stop_correction (priv);
+
+    if (get_unpack_kernel (priv) == NULL || has_8bit_output (priv) ||
+        (!have_dark && !have_flat && !has_float_output (priv)))
+        return TRUE;
+
+    priv->correction_dark = g_new0 (gfloat, pixels);
+    priv->correction_gain = g_new (gfloat, pixels);
+    priv->correction_float = has_float_output (priv);
+
+    for (gsize i = 0; i < pixels; i++)
+        priv->correction_gain[i] = 1.0f;
+
+    if (have_dark && !read_reference_frames (priv->dark_frame_file, pixels, priv->correction_dark, error))
+        goto failed;
+
+    if (have_flat) {
+        flat = g_new (gfloat, pixels);
+
+        if (!read_reference_frames (priv->flat_frame_file, pixels, flat, error)) {
+            g_free (flat);
+            goto failed;
+        }
+
+        for (gsize i = 0; i < pixels; i++)
+            mean += flat[i] - priv->correction_dark[i];
+
+        mean /= pixels;
+
+        for (gsize i = 0; i < pixels; i++) {
+            gfloat difference = flat[i] - priv->correction_dark[i];
+
+            priv->correction_gain[i] = difference > 0.0f ? mean / difference : 0.0f;
+        }
+
+        g_free (flat);
+    }
+
+    return TRUE;
+
+failed:
+    stop_correction (priv);
+    return FALSE;
+}
+
+
+// *****************
+// FRAME BUFFER POOL
+// *****************
+
+// 17.10.2026
+// The large buffers of a readout (the frame slots, the buffer of the normal transmission and the lent frames) are
+// taken from a pool, which belongs to the camera object and is kept across the readouts. A readout with the same or a
+// smaller ROI than the one before does not allocate anything.
+//
+// The buffers are mapped directly. Buffers of at least a huge page are mapped with explicit huge pages, if there are
+// any reserved (vm.nr_hugepages), otherwise transparent huge pages are asked for. If the NUMA node of the 10G interface
+// is known, the pages are preferably placed on it. They are touched once right away, so that the page faults do not
+// happen in the middle of the first frames.
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+struct pool_buffer {
+    gpointer             data;
+    gsize                size;
+    gint                 node;
+    // Whether the buffer is in the free list, so that giving it back twice is noticed
+    gboolean             in_pool;
+};
+
+struct buffer_pool {
+    GMutex               mutex;
+    // Every buffer of the pool by its address, no matter if it is free or not
+    GHashTable          *buffers;
+    // The buffers, which are free to be taken
+    GPtrArray           *free;
+};
+
+/**
+ * @brief Returns the NUMA node of the network interface @p iface or -1, if it is not known
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param iface
+ * @return
+ */
+static gint
+get_interface_numa_node (const gchar *iface)
+{
+    gchar *path;
+    gchar *contents = NULL;
+    gint node = -1;
+
+    if (iface == NULL)
+        return -1;
+
+    path = g_strdup_printf ("/sys/class/net/%s/device/numa_node", iface);
+
+    if (g_file_get_contents (path, &contents, NULL, NULL))
+        node = atoi (contents);
+
+    g_free (contents);
+    g_free (path);
+    return node;
+}
+
+/**
+ * @brief Maps a new buffer of at least @p size bytes, whose pages are placed on the NUMA node @p node
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param size
+ * @param node The NUMA node or -1 for any
+ * @return
+ */
+static struct pool_buffer *
+pool_buffer_new (gsize size, gint node)
+{
+    struct pool_buffer *buffer = g_new0 (struct pool_buffer, 1);
+    gsize page_size = size >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : (gsize) sysconf (_SC_PAGESIZE);
+
+    buffer->size = (MAX (size, 1) + page_size - 1) / page_size * page_size;
+    buffer->node = node;
+    buffer->data = MAP_FAILED;
+
+    if (page_size == HUGE_PAGE_SIZE)
+        buffer->data = mmap (NULL, buffer->size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+    if (buffer->data == MAP_FAILED) {
+        buffer->data = mmap (NULL, buffer->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (buffer->data == MAP_FAILED)
+            g_error ("Could not map a frame buffer of %" G_GSIZE_FORMAT " bytes: %s", buffer->size, g_strerror (errno));
+
+        if (page_size == HUGE_PAGE_SIZE)
+            madvise (buffer->data, buffer->size, MADV_HUGEPAGE);
+    }
+
+    // Only a preference, if the node has no memory left the pages are placed elsewhere
+    if (node >= 0 && node < (gint) (sizeof (gulong) * 8)) {
+        gulong mask = 1UL << node;
+
+        syscall (SYS_mbind, buffer->data, buffer->size, MPOL_PREFERRED, &mask, sizeof (mask) * 8, 0);
+    }
+
+    memset (buffer->data, 0, buffer->size);
+    return buffer;
+}
+
+/**
+ * @brief Unmaps the buffer
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param buffer
+ */
+static void
+pool_buffer_free (struct pool_buffer *buffer)
+{
+    munmap (buffer->data, buffer->size);
+    g_free (buffer);
+}
+
+/**
+ * @brief Creates an empty buffer pool
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @return
+ */
+static struct buffer_pool *
+buffer_pool_setup (void)
+{
+    struct buffer_pool *pool = g_new0 (struct buffer_pool, 1);
+
+    g_mutex_init (&pool->mutex);
+    pool->buffers = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+                                           (GDestroyNotify) pool_buffer_free);
+    pool->free = g_ptr_array_new ();
+    return pool;
+}
+
+/**
+ * @brief Frees the pool along with all of its buffers, including the ones, which have not been given back
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param pool
+ */
+static void
+buffer_pool_teardown (struct buffer_pool *pool)
+{
+    g_ptr_array_free (pool->free, TRUE);
+    g_hash_table_destroy (pool->buffers);
+    g_mutex_clear (&pool->mutex);
+    g_free (pool);
+}
+
+/**
+ * @brief Takes a buffer of at least @p size bytes on the NUMA node @p node from the pool
+ *
+ * A free buffer is reused, if it is large enough and on the right node. Otherwise a new one is mapped and the free
+ * buffers, which do not fit, are unmapped. They are left over from a readout with a smaller ROI or another interface
+ * and would only be in the way.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param pool
+ * @param size
+ * @param node The NUMA node or -1 for any
+ * @return
+ */
+static gpointer
+buffer_pool_take (struct buffer_pool *pool, gsize size, gint node)
+{
+    struct pool_buffer *buffer = NULL;
+    guint i;
+
+    g_mutex_lock (&pool->mutex);
+
+    for (i = pool->free->len; i > 0; i--) {
+        struct pool_buffer *candidate = g_ptr_array_index (pool->free, i - 1);
+
+        if (candidate->size >= size && (node < 0 || candidate->node == node)) {
+            buffer = g_ptr_array_remove_index_fast (pool->free, i - 1);
+            buffer->in_pool = FALSE;
+            break;
+        }
+    }
+
+    if (buffer == NULL) {
+        for (i = pool->free->len; i > 0; i--) {
+            struct pool_buffer *unfit = g_ptr_array_remove_index_fast (pool->free, i - 1);
+
+            g_hash_table_remove (pool->buffers, unfit->data);
+        }
+
+        buffer = pool_buffer_new (size, node);
+        g_hash_table_insert (pool->buffers, buffer->data, buffer);
+    }
+
+    g_mutex_unlock (&pool->mutex);
+    return buffer->data;
+}
+
+/**
+ * @brief Gives the buffer @p data, which has been taken from the pool before, back to it
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * A buffer, which is given back twice, is not added to the free list again. Otherwise it would be taken for two
+ * frames at the same time.
+ *
+ * @param pool
+ * @param data
+ */
+static void
+buffer_pool_give (struct buffer_pool *pool, gpointer data)
+{
+    struct pool_buffer *buffer;
+    gboolean given_twice = FALSE;
+
+    g_mutex_lock (&pool->mutex);
+    buffer = g_hash_table_lookup (pool->buffers, data);
+
+    if (buffer == NULL) {
+        g_warning ("%p is not a buffer of the frame buffer pool", data);
+    } else if (buffer->in_pool) {
+        given_twice = TRUE;
+    } else {
+        buffer->in_pool = TRUE;
+        g_ptr_array_add (pool->free, buffer);
+    }
+
+    g_mutex_unlock (&pool->mutex);
+    g_return_if_fail (!given_twice);
+}
+
+/**
+ * @brief Returns the size of the frame buffers for the current ROI
+ *
+ * 4 bytes per pixel are enough for the received data of every format and the float output.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static gsize
+get_frame_buffer_size (UcaPhantomCameraPrivate *priv)
+{
+    return MAX ((gsize) priv->roi_width * priv->roi_height * 4, (gsize) get_buffer_size (priv));
+}
+
+// ************
+// FRAME SLOTS
+// ************
+
+// 17.10.2026
+// Without zero copy decoding every 10G frame, which is in flight, has a slot of its own with the received data and the
+// decoded image. The frames are numbered from the start of the readout and frame n uses the slot n modulo the amount
+// of slots. With a single slot there is exactly one frame at a time, just as before. With more slots, the receiving
+// thread already receives the next frames, while the unpack thread still decodes the previous one and "grab" copies
+// out the one before that. The messages for the threads are only tokens then, every thread counts the frames itself:
+//
+// - "parser->started_frames" and "parser->received_frames" are increased by the receiving thread, when it starts and
+//   finishes a frame.
+// - "decoder->unpack_frame" is the frame, which is decoded by the unpack thread (and the decode pool).
+// - "xg_delivered_frames" is increased by "finalize_receiving_image", after the image has been copied out.
+//
+// A slot is used for a new frame only after the frame, which has used it before, has been delivered. The threads
+// handle the frames strictly in order, thus the images are delivered in order as well.
+
+struct frame_slot {
+    guint8              *data;
+    gpointer             image;
+    // Set by the receiving thread, when the frame is finished. The error of the reception is passed on to the unpack
+    // thread, which publishes the result of the frame.
+    gsize                missing;
+    gsize                expected;
+    GError              *error;
+};
+
+/**
+ * @brief Allocates the frame slots for a 10G readout and resets the frame counters
+ *
+ * The slots are only needed without zero copy decoding. With zero copy decoding or normal transmission there is a
+ * single frame in flight at a time, which is decoded into the buffer passed to "grab" directly.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The buffers of the slots are taken from the frame buffer pool.
+ *
+ * Changed 17.10.2026
+ * There are at least as many slots as live frames are pipelined.
+ *
+ * @param priv
+ */
+static void
+frame_slots_setup (UcaPhantomCameraPrivate *priv)
+{
+    gsize size = get_frame_buffer_size (priv);
+
+    priv->xg_slot_amount = 1;
+    priv->xg_parser->started_frames = 0;
+    priv->xg_parser->received_frames = 0;
+    priv->xg_decoder->unpack_frame = 0;
+    priv->xg_delivered_frames = 0;
+    priv->xg_frames_in_flight = 0;
+
+    if (!priv->enable_10ge || priv->xg_zero_copy)
+        return;
+
+    // 17.10.2026
+    // The pipelined live frames need a slot each as well
+    priv->xg_slot_amount = MAX (priv->frame_slots, priv->request_pipeline_depth);
+    priv->xg_slots = g_new0 (struct frame_slot, priv->xg_slot_amount);
+
+    for (guint i = 0; i < priv->xg_slot_amount; i++) {
+        priv->xg_slots[i].data = buffer_pool_take (priv->buffer_pool, size, priv->xg_numa_node);
+        priv->xg_slots[i].image = buffer_pool_take (priv->buffer_pool, size, priv->xg_numa_node);
+    }
+
+    priv->xg_decoder->in = priv->xg_slots[0].data;
+    priv->xg_decoder->out = priv->xg_slots[0].image;
+}
+
+/**
+ * @brief Frees the frame slots, once the receiving and the unpack thread have stopped
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The buffers of the slots are given back to the frame buffer pool.
+ *
+ * Changed 17.10.2026
+ * Frees the errors of frames, which have not been delivered.
+ *
+ * @param priv
+ */
+static void
+frame_slots_teardown (UcaPhantomCameraPrivate *priv)
+{
+    if (priv->xg_slots == NULL)
+        return;
+
+    for (guint i = 0; i < priv->xg_slot_amount; i++) {
+        buffer_pool_give (priv->buffer_pool, priv->xg_slots[i].data);
+        buffer_pool_give (priv->buffer_pool, priv->xg_slots[i].image);
+        // The error of a frame, which has been discarded while still in flight
+        g_clear_error (&priv->xg_slots[i].error);
+    }
+
+    g_free (priv->xg_slots);
+    priv->xg_slots = NULL;
+    priv->xg_slot_amount = 1;
+    priv->xg_decoder->in = NULL;
+    priv->xg_decoder->out = NULL;
+}
+
+/**
+ * @brief Returns the amount of bytes of the frame being unpacked, which have been received already
+ *
+ * If the receiving thread has not started the frame yet, "parser->total" still belongs to the previous frame and
+ * nothing has been received. If it has finished the frame meanwhile, "parser->total" may already belong to the next
+ * frame, which is why the frame is checked again after reading it. The receiving thread counts the frame as received,
+ * before it resets "parser->total" for the next one.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * "parser->total" is read with acquire semantics, so that the data it counts is visible as well.
+ *
+ * Changed 17.10.2026
+ * Reads the state of the decoder and its parser instead of "priv".
+ *
+ * @param decoder
+ * @return
+ */
+static gsize
+get_unpack_received (struct ximg_decoder *decoder)
+{
+    struct ximg_parser *parser = decoder->parser;
+    gsize size = get_buffer_size (decoder->priv);
+    guint frame = decoder->unpack_frame;
+    gsize total;
+
+    if ((guint) g_atomic_int_get (&parser->started_frames) <= frame)
+        return 0;
+
+    total = __atomic_load_n (&parser->total, __ATOMIC_ACQUIRE);
+
+    if ((guint) g_atomic_int_get (&parser->received_frames) > frame)
+        return size;
+
+    return MIN (total, size);
+}
+
+struct unpack_wait {
+    struct ximg_decoder *decoder;
+    gsize                amount;
+    gsize                received;
+};
+
+/**
+ * @brief The condition of "wait_unpack_received"
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param wait
+ * @return
+ */
+static gboolean
+has_unpack_received (struct unpack_wait *wait)
+{
+    wait->received = get_unpack_received (wait->decoder);
+    return wait->received >= wait->amount;
+}
+
+/**
+ * @brief Waits until at least @p amount bytes of the frame being unpacked have been received
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param decoder
+ * @param amount
+ * @return The amount of bytes received, which may be more than @p amount
+ */
+static gsize
+wait_unpack_received (struct ximg_decoder *decoder, gsize amount)
+{
+    UcaPhantomCameraPrivate *priv = decoder->priv;
+    struct unpack_wait wait = { decoder, amount, 0 };
+
+    progress_wait (priv->xg_progress, priv->wait_spin_time, (ProgressCondition) has_unpack_received, &wait);
+    return wait.received;
+}
+
+/**
+ * @brief The condition of "wait_unpack_finished"
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param decoder
+ * @return
+ */
+static gboolean
+has_unpack_finished (struct ximg_decoder *decoder)
+{
+    return (guint) g_atomic_int_get (&decoder->parser->received_frames) > decoder->unpack_frame;
+}
+
+/**
+ * @brief Waits until the receiving thread has finished the frame being unpacked (see "finish_ximg_frame")
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param decoder
+ */
+static void
+wait_unpack_finished (struct ximg_decoder *decoder)
+{
+    UcaPhantomCameraPrivate *priv = decoder->priv;
+
+    progress_wait (priv->xg_progress, priv->wait_spin_time, (ProgressCondition) has_unpack_finished, decoder);
+}
+
+// ******************
+// REQUEST PIPELINING
+// ******************
+
+// 17.10.2026
+// Outside of memread mode, every live frame has to be requested with an "img" or "ximg" request, whose reply has to be
+// waited for. With the "request-pipeline-depth" property set to N, "grab" keeps N live frames requested, so the
+// requests for the next frames are already out, while the current frame is received, decoded and copied. The first
+// "grab" of a readout sends N requests, every following one a single request to replace the frame it delivers.
+//
+// With frame slots the pipelined frames are received into the slots, of which there are at least N then. Otherwise
+// (zero copy decoding and 1G) a frame can only be received into the buffer of the "grab" call, which delivers it, if it
+// is the only one in flight. With N > 1 every frame is therefore received into a buffer of the pool, which is copied
+// into the buffer of "grab" (or lent) once the frame is delivered. "xg_pipeline" holds these buffers in the order of
+// the frames.
+
+/**
+ * @brief Fixes the pipeline depth for a readout, which has just set up its frame slots
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ */
+static void
+pipeline_setup (UcaPhantomCameraPrivate *priv)
+{
+    priv->xg_pipeline_depth = priv->request_pipeline_depth;
+    priv->xg_pipeline_buffered = priv->xg_pipeline_depth > 1 && priv->xg_slots == NULL;
+    priv->xg_pipeline_head = 0;
+    priv->xg_pipeline_amount = 0;
+}
+
+/**
+ * @brief Gives the buffers of the pipelined frames back to the pool, once no frame is in flight anymore
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ */
+static void
+pipeline_teardown (UcaPhantomCameraPrivate *priv)
+{
+    for (; priv->xg_pipeline_amount > 0; priv->xg_pipeline_amount--) {
+        buffer_pool_give (priv->buffer_pool, priv->xg_pipeline[priv->xg_pipeline_head]);
+        priv->xg_pipeline_head = (priv->xg_pipeline_head + 1) % PIPELINE_MAX_DEPTH;
+    }
+}
+
+/**
+ * @brief Returns the buffer, into which the next pipelined frame is to be received
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static gpointer
+pipeline_push (UcaPhantomCameraPrivate *priv)
+{
+    gpointer buffer = buffer_pool_take (priv->buffer_pool, get_frame_buffer_size (priv), priv->xg_numa_node);
+
+    priv->xg_pipeline[(priv->xg_pipeline_head + priv->xg_pipeline_amount) % PIPELINE_MAX_DEPTH] = buffer;
+    priv->xg_pipeline_amount++;
+    return buffer;
+}
+
+/**
+ * @brief Delivers the oldest pipelined frame, which has just been finalized, into @p data
+ *
+ * The frame is copied and its buffer given back to the pool. If the frame is lent, its buffer is returned in @p lent
+ * instead and @p data goes back to the pool.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Whether the frame is lent is decided by the caller with @p lent.
+ *
+ * @param priv
+ * @param data
+ * @param lent NULL to copy the frame into @p data
+ */
+static void
+pipeline_pop (UcaPhantomCameraPrivate *priv, gpointer data, gpointer *lent)
+{
+    gpointer buffer = priv->xg_pipeline[priv->xg_pipeline_head];
+
+    priv->xg_pipeline_head = (priv->xg_pipeline_head + 1) % PIPELINE_MAX_DEPTH;
+    priv->xg_pipeline_amount--;
+
+    if (lent != NULL) {
+        buffer_pool_give (priv->buffer_pool, data);
+        *lent = buffer;
+    } else {
+        memcpy (data, buffer, priv->roi_width * priv->roi_height * get_output_pixel_size (priv));
+        buffer_pool_give (priv->buffer_pool, buffer);
+    }
+}
+
+// ********************
+// ZERO COPY DECODING
+// ********************
+
+/**
+ * @brief Decodes a single group of 8 pixels (10 bytes P10, 12 bytes P12L or 8 bytes P8) into the output buffer
+ *
+ * The group is copied into a zero padded buffer first, so that neither more than the group is read from @p data nor
+ * more pixels than the frame has are written into the output buffer. This is used for the groups, which straddle two
+ * packets, and the last groups of a packet.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Uses "unpack_tail", which also corrects the pixels.
+ *
+ * @param parser
+ * @param data
+ * @param length The amount of valid bytes of the group. Missing bytes are decoded as zeros.
+ */
+static void
+decode_ximg_group (struct ximg_parser *parser, const guint8 *data, gsize length)
+{
+    UcaPhantomCameraPrivate *priv = parser->priv;
+    gsize pixel_count = priv->roi_width * priv->roi_height;
+
+    if (parser->output_index >= pixel_count)
+        return;
+
+    unpack_tail (priv, get_unpack_kernel (priv), data, length, parser->output, parser->output_index,
+                 MIN (UNPACK_GROUP_PIXELS, pixel_count - parser->output_index));
+    parser->output_index += UNPACK_GROUP_PIXELS;
+}
+
+/**
+ * @brief Decodes the payload of a single ximg packet directly into the output buffer of the current frame
+ *
+ * The payload of a packet does not necessarily end on the boundary of a group of 8 pixels. The bytes of an incomplete
+ * group at the end of a packet are kept in "carry" and completed with the first bytes of the next packet.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Added P8, which is copied as it is with 8 bit output.
+ *
+ * Changed 17.10.2026
+ * The pixels are corrected as well, if enabled.
+ *
+ * @param parser
+ * @param data
+ * @param length
+ */
+static void
+decode_ximg_payload (struct ximg_parser *parser, const guint8 *data, gsize length)
+{
+    UcaPhantomCameraPrivate *priv = parser->priv;
+    gsize group_size = get_unpack_group_size (priv->format);
+    gsize pixel_count = priv->roi_width * priv->roi_height;
+    gsize groups;
+
+    // 17.10.2026
+    // With 8 bit output the payload already consists of the final pixels
+    if (has_8bit_output (priv)) {
+        length = parser->output_index < pixel_count ? MIN (length, pixel_count - parser->output_index) : 0;
+        memcpy ((guint8 *) parser->output + parser->output_index, data, length);
+        parser->output_index += length;
+        return;
+    }
+
+    // First the group, which has been started by the previous packet, is completed
+    if (parser->carry_length > 0) {
+        gsize missing = MIN (group_size - parser->carry_length, length);
+
+        memcpy (parser->carry + parser->carry_length, data, missing);
+        parser->carry_length += missing;
+        data += missing;
+        length -= missing;
+
+        if (parser->carry_length < group_size)
+            return;
+
+        decode_ximg_group (parser, parser->carry, group_size);
+        parser->carry_length = 0;
+    }
+
+    // The kernels do not read beyond the complete groups, so they can be used directly on the packet data. Only the
+    // groups, for which there are 8 pixels left in the output buffer, are decoded this way.
+    groups = length / group_size;
+    if (parser->output_index + groups * UNPACK_GROUP_PIXELS > pixel_count)
+        groups = parser->output_index < pixel_count ? (pixel_count - parser->output_index) / UNPACK_GROUP_PIXELS : 0;
+
+    if (groups > 0) {
+        unpack_pixels (priv, get_unpack_kernel (priv), data, parser->output, parser->output_index, groups);
+        parser->output_index += groups * UNPACK_GROUP_PIXELS;
+        data += groups * group_size;
+        length -= groups * group_size;
+    }
+
+    while (length >= group_size) {
+        decode_ximg_group (parser, data, group_size);
+        data += group_size;
+        length -= group_size;
+    }
+
+    memcpy (parser->carry, data, length);
+    parser->carry_length = length;
+}
+
+/**
+ * @brief Prepares the zero copy decoding of a new frame into the given output buffer
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param parser
+ * @param output
+ */
+static void
+start_ximg_decoding (struct ximg_parser *parser, gpointer output)
+{
+    parser->output = output;
+    parser->output_index = 0;
+    parser->carry_length = 0;
+}
+
+/**
+ * @brief Decodes the last incomplete group of a frame, if the size of the frame is not a multiple of the group size
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param parser
+ */
+static void
+finish_ximg_decoding (struct ximg_parser *parser)
+{
+    if (parser->carry_length > 0)
+        decode_ximg_group (parser, parser->carry, parser->carry_length);
+
+    parser->carry_length = 0;
+    parser->output = NULL;
+}
+
+/**
+ * @brief Appends the payload of a packet to the current frame
+ *
+ * Normally the payload is copied into the raw data buffer, from which it is decoded by the unpack thread. With zero
+ * copy decoding the payload is decoded directly into the output buffer instead.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param parser
+ * @param data
+ * @param length
+ */
+static void
+append_ximg_payload (struct ximg_parser *parser, const guint8 *data, gsize length)
+{
+    UcaPhantomCameraPrivate *priv = parser->priv;
+
+    if (priv->xg_zero_copy) {
+        decode_ximg_payload (parser, data, length);
+    } else {
+        memcpy (parser->data_in, data, length);
+        parser->data_in += length;
+    }
+}
+
+/**
+ * @brief Appends the given amount of zero bytes to the current frame, as a replacement for lost packets
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param parser
+ * @param length
+ */
+static void
+append_ximg_zeros (struct ximg_parser *parser, gsize length)
+{
+    static const guint8 zeros[4096] = {0,};
+
+    while (length > 0) {
+        gsize chunk = MIN (length, sizeof (zeros));
+
+        append_ximg_payload (parser, zeros, chunk);
+        length -= chunk;
+    }
+}
+
+// 17.10.2026
+// The time in milliseconds, which the receiving thread waits for the next packet of a frame. Once it has passed, the
+// rest of the frame is considered lost.
+#define XIMG_RECEIVE_TIMEOUT        5000
+#define XIMG_RECEIVE_TIMEOUT_REASON "No ximg packet received for " G_STRINGIFY (XIMG_RECEIVE_TIMEOUT) " ms"
+
+/**
+ * @brief Gives up on the rest of the current frame, because no more packets can be received
+ *
+ * The missing part of the frame is filled with zeros, so that the frame is complete nonetheless, and @p error is set.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The reason is given by the caller, as the AF_XDP backend also gives up on socket errors.
+ *
+ * @param parser
+ * @param error
+ * @param reason
+ */
+static void
+abandon_ximg_frame (struct ximg_parser *parser, GError **error, const gchar *reason)
+{
+    gsize missing = parser->expected - parser->total;
+
+    g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                 "%s, %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT " bytes of the frame are missing",
+                 reason, missing, parser->expected);
+
+    parser->missing += missing;
+    append_ximg_zeros (parser, missing);
+    parser->total = parser->expected;
+}
+
+// 17.10.2026
+// The ximg header ends with the byte offset of the payload within the frame (32 bit, big endian). As this field is
+// not documented, it is only relied on after it has matched the packet lengths for XIMG_OFFSET_TRUST packets in a row,
+// and only as long as it never points outside of the frame.
+#define XIMG_OFFSET_POSITION        4
+#define XIMG_OFFSET_TRUST           64
+
+/**
+ * @brief Returns the byte offset within the frame, which the ximg header of the packet with the payload @p data states
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param data The payload of the packet, which is preceded by the ximg header
+ * @return
+ */
+static inline gsize
+get_ximg_offset (const guint8 *data)
+{
+    guint32 offset;
+
+    memcpy (&offset, data - XIMG_OFFSET_POSITION, sizeof (offset));
+    return GUINT32_FROM_BE (offset);
+}
+
+/**
+ * @brief Checks the offset in the ximg header of a packet, which has been placed using its length, against its position
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param parser
+ * @param offset The offset stated by the header
+ * @param position The position, at which the payload is placed
+ */
+static inline void
+learn_ximg_offset (struct ximg_parser *parser, gsize offset, gsize position)
+{
+    // The first packet of a frame proves nothing, a header without an offset would match as well
+    if (position == 0)
+        return;
+
+    if (offset != position || parser->missing > 0) {
+        parser->offset_matches = 0;
+        return;
+    }
+
+    if (++parser->offset_matches >= XIMG_OFFSET_TRUST) {
+        parser->offset_trusted = TRUE;
+        g_debug ("Using the offsets of the ximg headers to detect lost packets");
+    }
+}
+
+/**
+ * @brief Appends the payload of a ximg packet to the current frame, detecting lost packets on the way
+ *
+ * The camera sends every frame as a sequence of packets with the maximum payload size, followed by one shorter packet
+ * with the rest of the frame. A frame thus always ends with a packet boundary. The header of the ximg packets does not
+ * contain any documented sequence information, so the lost packets are detected using these lengths instead:
+ *
+ * - A short packet, which arrives while more than its payload is missing from the frame, is the last packet of the
+ *   frame. Packets in between have been lost. The payload is placed at the end of the frame and the gap is filled
+ *   with zeros.
+ * - A packet, which is longer than the rest of the frame, already belongs to the next frame. The last packet(s) of
+ *   this frame have been lost. The frame is filled up with zeros and the packet is left for the next frame.
+ *
+ * This way a lost packet only affects the frame it belongs to, instead of shifting all the following frames. Only
+ * for frames, whose size is a multiple of the maximum payload size, a loss cannot be detected.
+ * The amount of missing bytes is accumulated in "parser->missing", before "parser->total" reaches the expected size.
+ *
+ * Once the offsets of the ximg headers are trusted (see "XIMG_OFFSET_TRUST"), a packet is placed at its offset
+ * instead, which also finds the gaps in the middle of a frame and the loss of the last packet of any frame. A packet
+ * with the offset 0 starts the next frame, a packet before the current position is a duplicate and dropped. An offset
+ * outside of the frame withdraws the trust and the lengths are used again.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The byte count is published with release semantics and the waiting unpack thread is woken up.
+ *
+ * Changed 17.10.2026
+ * The offsets of the ximg headers are used to find the gaps, once they have proven to be consistent.
+ *
+ * @param parser
+ * @param data
+ * @param length
+ * @return FALSE if the packet belongs to the next frame and has not been used
+ */
+static gboolean
+receive_ximg_packet (struct ximg_parser *parser, const guint8 *data, gsize length)
+{
+    UcaPhantomCameraPrivate *priv = parser->priv;
+    gsize remaining = parser->expected - parser->total;
+    gsize offset = get_ximg_offset (data);
+    gsize gap = 0;
+
+    parser->max_payload = MAX (parser->max_payload, length);
+
+    if (parser->offset_trusted && offset + length > parser->expected) {
+        g_debug ("Offset %" G_GSIZE_FORMAT " of a ximg header is outside of the frame, using the packet lengths",
+                 offset);
+        parser->offset_trusted = FALSE;
+        parser->offset_matches = 0;
+    }
+
+    if (parser->offset_trusted) {
+        if (offset == 0 && parser->total > 0) {
+            parser->missing += remaining;
+            append_ximg_zeros (parser, remaining);
+            parser->total = parser->expected;
+            return FALSE;
+        }
+
+        if (offset < parser->total)
+            return TRUE;
+
+        gap = offset - parser->total;
+        parser->missing += gap;
+        append_ximg_zeros (parser, gap);
+        append_ximg_payload (parser, data, length);
+        __atomic_store_n (&parser->total, parser->total + gap + length, __ATOMIC_RELEASE);
+        progress_signal (priv->xg_progress);
+        return TRUE;
+    }
+
+    if (length > remaining) {
+        parser->missing += remaining;
+        append_ximg_zeros (parser, remaining);
+        parser->total = parser->expected;
+        return FALSE;
+    }
+
+    if (length < parser->max_payload && length < remaining) {
+        gap = remaining - length;
+        parser->missing += gap;
+        append_ximg_zeros (parser, gap);
+    }
+
+    learn_ximg_offset (parser, offset, parser->total + gap);
+    append_ximg_payload (parser, data, length);
+    __atomic_store_n (&parser->total, parser->total + gap + length, __ATOMIC_RELEASE);
+    progress_signal (priv->xg_progress);
+    return TRUE;
+}
+
+/**
+ * @brief Prepares the reception of a new frame
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The frame is received into its frame slot and counted as started, after the byte count has been reset.
+ *
+ * @param parser
+ */
+static void
+start_ximg_frame (struct ximg_parser *parser)
+{
+    UcaPhantomCameraPrivate *priv = parser->priv;
+    guint frame = (guint) parser->started_frames;
+
+    parser->total = 0;
+    parser->missing = 0;
+    parser->expected = get_buffer_size (priv);
+    parser->data_in = priv->xg_slots != NULL ? priv->xg_slots[frame % priv->xg_slot_amount].data : NULL;
+    g_atomic_int_inc (&parser->started_frames);
+}
+
+/**
+ * @brief Concludes the reception of a frame, by counting it, if packets have been lost
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The amount of missing bytes is kept in the frame slot, since the next frame may already be received, when the image
+ * is delivered.
+ *
+ * Changed 17.10.2026
+ * The waiting unpack thread is woken up.
+ *
+ * Changed 17.10.2026
+ * The error of the reception is kept in the frame slot as well, the unpack thread puts it into the result.
+ *
+ * @param parser
+ * @param error The error of the reception, which is taken over into the frame slot, if there are frame slots
+ */
+static void
+finish_ximg_frame (struct ximg_parser *parser, GError **error)
+{
+    UcaPhantomCameraPrivate *priv = parser->priv;
+
+    if (parser->missing > 0) {
+        priv->xg_incomplete_frames++;
+        priv->xg_missing_total += parser->missing;
+    }
+
+    if (priv->xg_slots != NULL) {
+        struct frame_slot *slot = &priv->xg_slots[(guint) parser->received_frames % priv->xg_slot_amount];
+
+        slot->missing = parser->missing;
+        slot->expected = parser->expected;
+        slot->error = *error;
+        *error = NULL;
+    }
+
+    g_atomic_int_inc (&parser->received_frames);
+    progress_signal (priv->xg_progress);
+}
+
+// ******************************
+// CAPTURING AND REPLAYING PACKETS
+// ******************************
+
+// 17.10.2026
+// The packets are captured into files of the classic pcap format with nanosecond timestamps, so that they can also be
+// inspected with the usual tools. Captures of tcpdump (microsecond timestamps) can be replayed as well. Only files
+// with the byte order of this machine are supported.
+#define PCAP_MAGIC_MICROSECONDS     0xa1b2c3d4
+#define PCAP_MAGIC_NANOSECONDS      0xa1b23c4d
+#define PCAP_LINKTYPE_ETHERNET      1
+#define PCAP_SNAPLEN                65535
+
+struct pcap_file_header {
+    guint32 magic;
+    guint16 version_major;
+    guint16 version_minor;
+    gint32  thiszone;
+    guint32 sigfigs;
+    guint32 snaplen;
+    guint32 linktype;
+};
+
+struct pcap_packet_header {
+    guint32 ts_sec;
+    guint32 ts_frac;
+    guint32 caplen;
+    guint32 len;
+};
+
+// 17.10.2026
+// The amount of blocks of the ring buffer in memory, which is used by the replay backend. As the blocks are filled on
+// demand, only a few are needed.
+#define REPLAY_BLOCK_AMOUNT         16
+
+/**
+ * @brief Creates the capture file and writes the pcap file header
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param path
+ * @return The opened file or NULL, if it could not be created
+ */
+static FILE *
+capture_open (const gchar *path)
+{
+    struct pcap_file_header header;
+    FILE *file;
+
+    file = fopen (path, "wb");
+    if (file == NULL)
+        return NULL;
+
+    // The blocks arrive in big bursts, a larger buffer saves a lot of write calls
+    setvbuf (file, NULL, _IOFBF, 1 << 20);
+
+    memset (&header, 0, sizeof (header));
+    header.magic = PCAP_MAGIC_NANOSECONDS;
+    header.version_major = 2;
+    header.version_minor = 4;
+    header.snaplen = PCAP_SNAPLEN;
+    header.linktype = PCAP_LINKTYPE_ETHERNET;
+    fwrite (&header, sizeof (header), 1, file);
+
+    return file;
+}
+
+/**
+ * @brief Writes all the packets of a block of the ring buffer into the capture file
+ *
+ * All packets are written, not only the ximg packets, so that a replay sees exactly what the ring buffer contained.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param file
+ * @param block
+ */
+static void
+capture_block (FILE *file, struct block_desc *block)
+{
+    struct tpacket3_hdr *header;
+
+    header = (struct tpacket3_hdr *) ((guint8 *) block + block->h1.offset_to_first_pkt);
+
+    for (guint i = 0; i < block->h1.num_pkts; i++) {
+        struct pcap_packet_header record;
+
+        record.ts_sec = header->tp_sec;
+        record.ts_frac = header->tp_nsec;
+        record.caplen = header->tp_snaplen;
+        record.len = header->tp_len;
+        fwrite (&record, sizeof (record), 1, file);
+        fwrite ((guint8 *) header + header->tp_mac, header->tp_snaplen, 1, file);
+
+        header = (struct tpacket3_hdr *) ((guint8 *) header + header->tp_next_offset);
+    }
+}
+
+/**
+ * @brief Opens a pcap file for the replay backend and allocates the ring buffer in memory
+ *
+ * The file is mapped into memory, so that reading it costs as little as possible during the replay.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param path
+ * @param geometry Only the block size is taken from the geometry
+ * @param error
+ * @return
+ */
+static struct replay *
+replay_setup (const gchar *path, const struct ring_geometry *geometry, GError **error)
+{
+    struct pcap_file_header header;
+    struct replay *replay;
+    guint block_size = geometry->block_size;
+
+    replay = g_new0 (struct replay, 1);
+    replay->file = g_mapped_file_new (path, FALSE, error);
+    if (replay->file == NULL) {
+        g_free (replay);
+        return NULL;
+    }
+
+    replay->data = (const guint8 *) g_mapped_file_get_contents (replay->file);
+    replay->size = g_mapped_file_get_length (replay->file);
+
+    if (replay->size >= sizeof (header))
+        memcpy (&header, replay->data, sizeof (header));
+
+    if (replay->size < sizeof (header) ||
+        (header.magic != PCAP_MAGIC_MICROSECONDS && header.magic != PCAP_MAGIC_NANOSECONDS) ||
+        header.linktype != PCAP_LINKTYPE_ETHERNET) {
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "%s is not a pcap file of ethernet packets in the byte order of this machine", path);
+        g_mapped_file_unref (replay->file);
+        g_free (replay);
+        return NULL;
+    }
+
+    replay->nanoseconds = header.magic == PCAP_MAGIC_NANOSECONDS;
+    replay->offset = sizeof (header);
+
+    replay->ring.req.tp_block_size = block_size;
+    replay->ring.req.tp_block_nr = REPLAY_BLOCK_AMOUNT;
+    replay->ring.req.tp_frame_size = geometry->frame_size;
+    replay->ring.req.tp_frame_nr = (block_size * REPLAY_BLOCK_AMOUNT) / geometry->frame_size;
+    replay->ring.map = g_malloc0 ((gsize) block_size * REPLAY_BLOCK_AMOUNT);
+    replay->ring.rd = g_new0 (struct iovec, REPLAY_BLOCK_AMOUNT);
+
+    // All blocks start out as owned by the "kernel", which means that they can be filled from the file
+    for (guint i = 0; i < REPLAY_BLOCK_AMOUNT; i++) {
+        replay->ring.rd[i].iov_base = replay->ring.map + i * block_size;
+        replay->ring.rd[i].iov_len = block_size;
+    }
+
+    return replay;
+}
+
+static void
+replay_teardown (struct replay *replay)
+{
+    g_free (replay->ring.map);
+    g_free (replay->ring.rd);
+    g_mapped_file_unref (replay->file);
+    g_free (replay);
+}
+
+/**
+ * @brief Fills a block of the replay ring buffer with the next packets of the file and hands it to the user space
+ *
+ * The packets are laid out the same way the kernel does it for a TPACKET_V3 ring: Every packet is preceded by its
+ * tpacket3 header and the link layer address, the ethernet header starts at the offset "tp_mac" (which is 82 for
+ * ethernet, the offsets used by "process_block" rely on that).
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param replay
+ * @param block
+ * @return FALSE, if the end of the file has been reached and no packet was left
+ */
+static gboolean
+replay_fill_block (struct replay *replay, struct block_desc *block)
+{
+    guint block_size = replay->ring.req.tp_block_size;
+    guint mac_offset = TPACKET_ALIGN (TPACKET3_HDRLEN + 16) - ETH_HLEN;
+    struct tpacket3_hdr *previous = NULL;
+    guint offset;
+
+    memset (block, 0, sizeof (struct block_desc));
+    block->version = TPACKET_V3;
+    block->offset_to_priv = sizeof (struct block_desc);
+    block->h1.offset_to_first_pkt = TPACKET_ALIGN (sizeof (struct block_desc));
+    offset = block->h1.offset_to_first_pkt;
+
+    while (replay->offset + sizeof (struct pcap_packet_header) <= replay->size) {
+        struct pcap_packet_header record;
+        struct tpacket3_hdr *header;
+
+        memcpy (&record, replay->data + replay->offset, sizeof (record));
+
+        if (replay->offset + sizeof (record) + record.caplen > replay->size)
+            break;
+
+        // A packet, which would never fit into a block, is skipped
+        if (mac_offset + record.caplen > block_size - block->h1.offset_to_first_pkt) {
+            replay->offset += sizeof (record) + record.caplen;
+            replay->skipped++;
+            continue;
+        }
+
+        if (offset + mac_offset + record.caplen > block_size)
+            break;
+
+        header = (struct tpacket3_hdr *) ((guint8 *) block + offset);
+        memset (header, 0, sizeof (struct tpacket3_hdr));
+        header->tp_sec = record.ts_sec;
+        header->tp_nsec = replay->nanoseconds ? record.ts_frac : record.ts_frac * 1000;
+        header->tp_snaplen = record.caplen;
+        header->tp_len = record.len;
+        header->tp_mac = mac_offset;
+        header->tp_net = mac_offset + ETH_HLEN;
+        memcpy ((guint8 *) header + mac_offset, replay->data + replay->offset + sizeof (record), record.caplen);
+
+        if (previous != NULL)
+            previous->tp_next_offset = (guint8 *) header - (guint8 *) previous;
+
+        previous = header;
+        offset += TPACKET_ALIGN (mac_offset + record.caplen);
+        replay->offset += sizeof (record) + record.caplen;
+        replay->packets++;
+        replay->bytes += record.caplen;
+        block->h1.num_pkts++;
+    }
+
+    if (block->h1.num_pkts == 0)
+        return FALSE;
+
+    block->h1.blk_len = offset;
+    block->h1.block_status = TP_STATUS_USER;
+    return TRUE;
+}
+
+/**
+ * @brief Copies the packet data into the image buffer and prepares the pointers for the next iteration
+ *
+ * This function processes the data from one packet from the ring buffer
+ *
+ * @author Jonas Teufel
+ *
+ * CHANGELOG
+ *
+ * Added 20.05.2019
+ *
+ * Changed 29.05.2019
+ * There was a bug here. When the processed package was the pre-last one in a block, but also the last one for an image
+ * that cause the program to flag the block as finished even though the last block would never be looked at. Thus the
+ * last packet in the block would disappear...
+ * Added a if clause that checks for the edge case now.
+ *
+ * Changed 17.10.2026
+ * The payload is appended using "append_ximg_payload", which decodes it directly in the zero copy mode.
+ *
+ * Changed 17.10.2026
+ * The payload is appended using "receive_ximg_packet", which detects lost packets. The special handling of the
+ * pre-last packet of a block is not necessary anymore, as the block is now only finished, when all of its packets
+ * have been processed.
+ *
+ * @param parser
+ */
+void process_packet(struct ximg_parser *parser) {
+
+    // 17.10.2026
+    // Previously the payload was copied here as long as there were bytes remaining and a packet containing the end of
+    // this frame and the start of the next one was split up. A frame always ends with a packet boundary though, so
+    // now such a packet means, that the end of this frame has been lost (see "receive_ximg_packet"). In that case the
+    // packet is not consumed, so that the next frame starts with it.
+    if (receive_ximg_packet(parser, parser->packet_data, parser->packet_length)) {
+        increment_packet(parser);
+    }
+
+    parser->remaining_length = parser->expected - parser->total;
+}
+
+/**
+ * @brief Extracts the data from one block in the ring buffer and adds it to the destination buffer.
+ *
+ * @author Jonas Teufel
+ *
+ * CHANGELOG
+ *
+ * Added 28.04.2019
+ *
+ * Changed 20.05.2019
+ * Completely moved the whole processing of the actual package data of a single packet (memcopy the contents and
+ * incrementing of the pointers) to the method "process_packet"
+ *
+ * Changed 29.05.2019
+ * Also saving the amount of packages inside a block into a attribute of the camera object now, so it can be used
+ * in the process_packet method without explicitly passing it.
+ *
+ * Changed 17.10.2026
+ * Packets without payload are skipped.
+ *
+ * @param block_description
+ * @param destination
+ * @param expected
+ * @param total
+ * @param finished
+ * @param header
+ * @return
+ */
+void process_block(struct ximg_parser *parser) {
+    // Each block can hold multiple actual packets (frames). But the actual amount how many packets are in one block
+    // depends on the size of the packet, speed of transmission etc. In general, the amount is not previously known,
+    // but once the block is done writing, is stored inside the "num_pckts" of its descriptor.
+    // 17.10.2026
+    // The counters are unsigned like the amount of packets, which the kernel reports
+    parser->packet_amount = parser->current_block->h1.num_pkts;
+
+    // This will be the pointer directed at the start of the actual packet data! The data contained in a packet is
+    // byte wise, which means its a unsigned 8 bit format.
+    guint8 *data;
+
+    // This will store the size of the packet's payload
+    gssize length;
+
+    // The finished boolean variable is an indicator of whether the currently processed block is finished or not.
+    // We have to consider the following case: If the loop below break's because all the expected data has been
+    // received for one package, there could possibly still be data of the next image in that ring buffer block.
+    // and we need to indicate this to know, if we should start in this or the next block when attempting to get the
+    // data for that next image.
+    //priv->xg_block_finished = TRUE;
+
+    // 17.10.2026
+    // The loop now directly uses the packet index, as "process_packet" does not consume a packet, which belongs to the
+    // next frame.
+    while (parser->packet_index < parser->packet_amount) {
+
+        if (parser->remaining_length <= 0) {
+            break;
+        }
+
+        // Calculation of the actual payload(!) length. The packages sent by the phantom have a overhead of 32 bytes!
+        length = (gssize) parser->packet_header->tp_snaplen - 32;
+        // After exactly 94 bytes into the package the info about the used protocol can be extracted. And after 114
+        // bytes the overhead ends and the actual payload starts.
+        data = (guint8 *) parser->packet_header;
+        // 17.10.2026
+        // A runt frame without any payload is skipped like a foreign packet
+        if (length > 0 && data[94] == 136 && data[95] == 183) {
+            data += 114;
+
+            // With this we copy all the data (using the complete length of the payload) onto the destination buffer (where
+            // the final image data will be stored)
+            parser->packet_data = data;
+            parser->packet_length = length;
+
+            process_packet(parser);
+
+        } else {
+            increment_packet(parser);
+        }
+    }
+
+    // Here we are simply checking "Did the loop process all the packets of the blog?". Because if it did than obviously
+    // This block is finished and we can flag it as such. But if it is not, than the next image has to pick up with
+    // this block.
+    if (parser->packet_index < parser->packet_amount) {
+        parser->block_finished = FALSE;
+    } else {
+        parser->block_finished = TRUE;
+        //g_warning("block finished");
+    }
+}
+
+
+/**
+ * @brief Receives / reads the image data being transmitted over the 10G interface.
+ *
+ * @author Jonas Teufel
+ *
+ * CHANGELOG
+ *
+ * Changed 17.10.2026
+ * If no block is released within XIMG_RECEIVE_TIMEOUT, the rest of the frame is abandoned and @p error is set.
+ *
+ * Changed 17.10.2026
+ * Removed the unused variables and the unused socket parameter, the ring is polled through @p poll_fd.
+ *
+ * @param priv
+ * @param ring
+ * @param poll_fd
+ * @param block_index
+ * @param finished
+ * @param header
+ * @param error
+ * @return
+ */
+static int
+read_ximg_data (
+        UcaPhantomCameraPrivate *priv,
+        struct ring *ring,
+        struct pollfd *poll_fd,
+        GError **error)
+{
+    struct ximg_parser *parser = priv->xg_parser;
+
+    // With this we keep track of how many bytes have already been received.
+    // 17.10.2026
+    // The state of the frame is reset by "start_ximg_frame" now
+    start_ximg_frame(parser);
+    guint block_amount = ring->req.tp_block_nr;
+
+    parser->remaining_length = parser->expected;
+
+    while (parser->total < parser->expected) {
+
+        // Creating the block description for the current block index from the ring buffer.
+        //block_description = (struct block_desc *) ring->rd[block_index].iov_base;
+        parser->current_block = (struct block_desc *) ring->rd[parser->block_index].iov_base;
+
+        // Polling.
+        // Once the kernel has finished writing to a block of the buffer (either because it is full, or because the
+        // timer ran out), this block is being released to the user space (-> this program) and only then we can
+        // read it. So the program execution of the loop will be skipped here, if the next block has not yet been
+        // released to the user space.
+        // 17.10.2026
+        // With the replay backend the blocks are filled from the file instead. Once it has been read completely, the
+        // rest of the frame (and every following one) is missing.
+        // 17.10.2026
+        // If no block is released within the receive timeout, the camera has stopped sending.
+        if ((parser->current_block->h1.block_status & TP_STATUS_USER) == 0) {
+            if (priv->xg_replay == NULL) {
+                if (poll(poll_fd, 1, XIMG_RECEIVE_TIMEOUT) == 0 &&
+                    (parser->current_block->h1.block_status & TP_STATUS_USER) == 0)
+                    abandon_ximg_frame(parser, error, XIMG_RECEIVE_TIMEOUT_REASON);
+            } else if (!replay_fill_block(priv->xg_replay, parser->current_block)) {
+                gsize missing = parser->expected - parser->total;
+
+                parser->missing += missing;
+                append_ximg_zeros(parser, missing);
+                parser->total = parser->expected;
+            }
+            continue;
+        }
+
+        if (parser->block_finished == TRUE) {
+            // In case block was finished during the previous run of this function, the header struct will be created
+            // to point to the first packet of the current (new) block.
+            // Although if it wasn't finished the header for the packet, where the last loop left of will be reused.
+            parser->packet_header = (struct tpacket3_hdr *) ((uint8_t *) parser->current_block +
+                                                              parser->current_block->h1.offset_to_first_pkt);
+            parser->packet_index = 0;
+
+            // 17.10.2026
+            // The kernel sets this flag, if it has dropped packets since the block has been retired
+            if (parser->current_block->h1.block_status & TP_STATUS_LOSING)
+                priv->xg_losing_blocks++;
+
+            // 17.10.2026
+            // Every block is written to the capture file once, when it is processed for the first time
+            if (priv->xg_capture != NULL)
+                capture_block(priv->xg_capture, parser->current_block);
+        }
+
+        // Actually extracting the data of the packages in that block into the destination buffer.
+
+        process_block(parser);
+        flush_block(parser);
+
+        // If the block is not yet finished to be processed we cannot increment the index, so that with the next call
+        // of this function the rest of the unfinished block will be processed first.
+        if (parser->block_finished == TRUE) {
+            // Going to the next block. If the last block has been reached, it starts with the first block again,
+            // after all this is how a ring buffer works.
+            parser->block_index = (parser->block_index + 1) % block_amount;
+        }
+    }
+    return 0;
+}
+
+// 17.10.2026
+// Offset from the start of the ethernet header to the payload of a ximg packet. This is the 14 byte ethernet header plus
+// the 18 byte ximg header. It is the same overhead of 32 bytes, which "process_block" subtracts from the snaplen.
+#define XIMG_OVERHEAD               32
+
+// 17.10.2026
+// The configuration used to derive the ring geometry, when no explicit block size or block count is given. The ring
+// has to be able to hold a whole memread chunk of images (times the safety factor), in case the unpacking falls behind.
+// Each block has to fit at least RING_MIN_PACKETS_PER_BLOCK packets of the largest size the MTU allows.
+// 17.10.2026
+// Only a fixed "memread-chunk-size" still determines the size of the ring. Otherwise a memread ring locks
+// RING_MEMREAD_MEMORY and the chunks are derived from that (see "MEMREAD FLOW CONTROL"). Outside of memread mode the
+// ring only has to hold the frames in flight, again times the safety factor.
+#define RING_DEFAULT_BLOCK_SIZE     (1 << 16)
+#define RING_FRAME_SIZE             (1 << 8)
+#define RING_MIN_BLOCK_AMOUNT       64
+#define RING_MIN_PACKETS_PER_BLOCK  4
+#define RING_SAFETY_FACTOR          2
+#define RING_MEMREAD_MEMORY         (256 << 20)
+
+/**
+ * @brief Returns the MTU of the given interface or 1500, if it cannot be determined
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param netdev
+ * @return
+ */
+static guint
+get_interface_mtu (const gchar *netdev)
+{
+    struct ifreq if_opts;
+    guint mtu = ETH_DATA_LEN;
+    int fd;
+
+    if (netdev == NULL)
+        return mtu;
+
+    fd = socket (AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+        return mtu;
+
+    memset (&if_opts, 0, sizeof (if_opts));
+    strncpy (if_opts.ifr_name, netdev, IFNAMSIZ - 1);
+
+    if (ioctl (fd, SIOCGIFMTU, &if_opts) == 0 && if_opts.ifr_mtu > 0)
+        mtu = if_opts.ifr_mtu;
+
+    close (fd);
+    return mtu;
+}
+
+/**
+ * @brief Returns the amount of memory in bytes, which this process is still allowed to lock
+ *
+ * This is the RLIMIT_MEMLOCK minus the memory, which is already locked. G_MAXUINT64 is returned, if there is no limit
+ * or the process has the CAP_IPC_LOCK capability, to which the limit does not apply.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @return
+ */
+static guint64
+get_lockable_memory (void)
+{
+    struct rlimit limit;
+    guint64 capabilities = 0;
+    guint64 locked = 0;
+    gchar *contents;
+    gchar *line;
+
+    if (getrlimit (RLIMIT_MEMLOCK, &limit) < 0 || limit.rlim_cur == RLIM_INFINITY)
+        return G_MAXUINT64;
+
+    if (g_file_get_contents ("/proc/self/status", &contents, NULL, NULL)) {
+        if ((line = strstr (contents, "\nCapEff:")) != NULL)
+            capabilities = g_ascii_strtoull (line + strlen ("\nCapEff:"), NULL, 16);
+
+        if ((line = strstr (contents, "\nVmLck:")) != NULL)
+            locked = g_ascii_strtoull (line + strlen ("\nVmLck:"), NULL, 10) * 1024;
+
+        g_free (contents);
+    }
+
+    if (capabilities & ((guint64) 1 << CAP_IPC_LOCK))
+        return G_MAXUINT64;
+
+    return limit.rlim_cur > locked ? limit.rlim_cur - locked : 0;
+}
+
+/**
+ * @brief Computes the geometry of the 10G ring buffer(s) for the current configuration of the camera object
+ *
+ * Block size and block count can be set explicitly using the "ring-block-size" and "ring-block-count" properties. If
+ * one of them is 0, it is derived automatically: The block size is the smallest power of two (but at least 64 KiB),
+ * which fits RING_MIN_PACKETS_PER_BLOCK packets of the interface MTU, so that jumbo frames never get truncated. The
+ * block count is chosen, so that all rings together can hold RING_SAFETY_FACTOR times the images in flight, taking the
+ * per packet overhead of the ring into account.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * A fixed memread chunk size set with "memread-chunk-size" is used instead of MEMREAD_CHUNK_SIZE.
+ *
+ * Changed 17.10.2026
+ * The automatic block count depends on the mode: A memread ring without fixed chunk size locks RING_MEMREAD_MEMORY,
+ * a ring for live frames only holds RING_SAFETY_FACTOR times the frames in flight. The ring is shrunk to the memory,
+ * which the process may still lock.
+ *
+ * @param priv
+ * @param geometry
+ */
+static void
+compute_ring_geometry (UcaPhantomCameraPrivate *priv, struct ring_geometry *geometry)
+{
+    guint page_size = sysconf (_SC_PAGESIZE);
+    guint packet_size;
+    guint payload_size;
+    guint min_block_size;
+    guint block_amount;
+    guint block_capacity;
+    guint64 frame_amount;
+    guint64 packet_amount;
+    guint64 lockable;
+
+    geometry->mtu = get_interface_mtu (priv->iface);
+    geometry->frame_size = RING_FRAME_SIZE;
+    geometry->retire_timeout = MAX (priv->ring_retire_timeout, 1);
+    geometry->ring_amount = MAX (priv->receive_threads, 1);
+
+    // This is the space, that a single packet of maximum size takes up within a block of the ring. Besides the
+    // ethernet frame itself, every packet is preceded by the tpacket3 header and the link layer address.
+    packet_size = TPACKET_ALIGN (TPACKET3_HDRLEN + ETH_HLEN + geometry->mtu);
+    payload_size = geometry->mtu + ETH_HLEN - XIMG_OVERHEAD;
+
+    // Every block has to hold at least a few packets of the maximum size. The block size has to be a multiple of the
+    // page size and thus also of the frame size.
+    min_block_size = RING_MIN_PACKETS_PER_BLOCK * packet_size;
+    geometry->block_size = priv->ring_block_size > 0 ? priv->ring_block_size : RING_DEFAULT_BLOCK_SIZE;
+    geometry->block_size = MAX (geometry->block_size, min_block_size);
+    geometry->block_size = MAX (geometry->block_size, page_size);
+    if (priv->ring_block_size == 0)
+        geometry->block_size = 1 << g_bit_storage (geometry->block_size - 1);
+    geometry->block_size = ((geometry->block_size + page_size - 1) / page_size) * page_size;
+
+    block_capacity = geometry->block_size / packet_size;
+
+    if (priv->ring_block_amount > 0) {
+        block_amount = priv->ring_block_amount;
+    }
+    else if (priv->enable_memread && priv->memread_chunk_size == 0) {
+        block_amount = RING_MEMREAD_MEMORY / geometry->block_size;
+        block_amount = MAX (block_amount, RING_MIN_BLOCK_AMOUNT);
+    }
+    else {
+        if (priv->enable_memread)
+            frame_amount = priv->memread_chunk_size;
+        else
+            frame_amount = MAX (priv->frame_slots, priv->request_pipeline_depth);
+
+        packet_amount = ((guint64) get_buffer_size (priv) * frame_amount * RING_SAFETY_FACTOR) / payload_size + 1;
+        block_amount = packet_amount / block_capacity + 1;
+        block_amount = MAX (block_amount, RING_MIN_BLOCK_AMOUNT);
+    }
+
+    // A ring, that cannot be locked, cannot be mapped at all
+    lockable = get_lockable_memory ();
+
+    if ((guint64) block_amount * geometry->block_size > lockable) {
+        guint lockable_amount = MAX (lockable / geometry->block_size, geometry->ring_amount);
+
+        if (priv->ring_block_amount > 0)
+            g_warning ("%u ring blocks exceed the lockable memory (ulimit -l), using %u", block_amount, lockable_amount);
+
+        block_amount = lockable_amount;
+    }
+
+    // The blocks are split evenly between the rings of a fanout group, every ring needs at least one block.
+    block_amount = MAX (block_amount / geometry->ring_amount, 1);
+    geometry->block_amount = block_amount * geometry->ring_amount;
+}
+
+/**
+ * @brief Returns the amount of memory in bytes, that is locked by the ring buffer(s) of the given geometry
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param geometry
+ * @return
+ */
+static guint64
+get_ring_locked_memory (const struct ring_geometry *geometry)
+{
+    return (guint64) geometry->block_size * geometry->block_amount;
+}
+
+/**
+ * @brief Returns a description of the ring geometry, which is used by the running readout or would be used by the next
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static gchar *
+get_ring_geometry_description (UcaPhantomCameraPrivate *priv)
+{
+    struct ring_geometry geometry = priv->xg_geometry;
+
+    if (geometry.block_amount == 0)
+        compute_ring_geometry (priv, &geometry);
+
+    return g_strdup_printf ("%u rings, %u blocks of %u bytes each, retire timeout %u ms, MTU %u, "
+                            "%" G_GUINT64_FORMAT " bytes locked",
+                            geometry.ring_amount, geometry.block_amount / geometry.ring_amount, geometry.block_size,
+                            geometry.retire_timeout, geometry.mtu, get_ring_locked_memory (&geometry));
+}
+
+/**
+ * @brief Parses a MAC address in the format "aa:bb:cc:dd:ee:ff"
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param string
+ * @param mac
+ * @return TRUE if the string was a valid MAC address
+ */
+static gboolean
+parse_mac_address (const gchar *string, guint8 mac[6])
+{
+    guint bytes[6];
+    gchar end;
+
+    if (string == NULL ||
+        sscanf (string, "%2x:%2x:%2x:%2x:%2x:%2x%c",
+                &bytes[0], &bytes[1], &bytes[2], &bytes[3], &bytes[4], &bytes[5], &end) != 6)
+        return FALSE;
+
+    for (guint i = 0; i < 6; i++)
+        mac[i] = bytes[i];
+
+    return TRUE;
+}
+
+/**
+ * @brief Determines the MAC address, from which the camera sends the ximg packets
+ *
+ * If the "ximg-source-mac" property is set, this address is used. Otherwise the address of the control connection is
+ * looked up in the ARP table of the 10G interface. With 10G the camera is controlled using its 10G port, so this
+ * is the same port, which sends the image data.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @param mac
+ * @return TRUE if the address could be determined
+ */
+static gboolean
+get_ximg_source_mac (UcaPhantomCameraPrivate *priv, guint8 mac[6])
+{
+    GSocketAddress *remote;
+    gchar *address;
+    gchar *contents;
+    gchar **lines;
+    gboolean found = FALSE;
+
+    if (priv->ximg_source_mac != NULL && priv->ximg_source_mac[0] != '\0')
+        return parse_mac_address (priv->ximg_source_mac, mac);
+
+    if (priv->connection == NULL || priv->iface == NULL)
+        return FALSE;
+
+    remote = g_socket_connection_get_remote_address (priv->connection, NULL);
+    if (remote == NULL)
+        return FALSE;
+
+    address = g_inet_address_to_string (g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (remote)));
+    g_object_unref (remote);
+
+    // The lines of the ARP table have the format "IP address  HW type  Flags  HW address  Mask  Device"
+    if (g_file_get_contents ("/proc/net/arp", &contents, NULL, NULL)) {
+        lines = g_strsplit (contents, "\n", -1);
+
+        for (guint i = 1; lines[i] != NULL && !found; i++) {
+            gchar ip[64], hwaddr[32], device[IFNAMSIZ + 1];
+            guint hwtype, flags;
+
+            if (sscanf (lines[i], "%63s 0x%x 0x%x %31s %*s %16s", ip, &hwtype, &flags, hwaddr, device) == 5 &&
+                g_strcmp0 (ip, address) == 0 && g_strcmp0 (device, priv->iface) == 0)
+                found = parse_mac_address (hwaddr, mac);
+        }
+
+        g_strfreev (lines);
+        g_free (contents);
+    }
+
+    g_free (address);
+    return found;
+}
+
+/**
+ * @brief Attaches a BPF filter to the raw socket, which only accepts ximg packets (from the given MAC address)
+ *
+ * The filter is evaluated by the kernel before a packet is being written into the ring buffer. Thus other traffic on
+ * the interface neither takes up space in the ring nor has to be skipped by the reception. If @p source_mac is NULL,
+ * only the ethertype is checked.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param fd
+ * @param source_mac
+ * @return The return value of setsockopt
+ */
+static int
+attach_ximg_filter (int fd, const guint8 *source_mac)
+{
+    guint32 mac_high = 0;
+    guint32 mac_low = 0;
+
+    if (source_mac != NULL) {
+        mac_high = (source_mac[0] << 8) | source_mac[1];
+        mac_low = ((guint32) source_mac[2] << 24) | (source_mac[3] << 16) | (source_mac[4] << 8) | source_mac[5];
+    }
+
+    // The offsets are relative to the start of the ethernet header: 6 is the source MAC address, 12 the ethertype.
+    // Without a source MAC address the program ends after the ethertype check (the first four instructions).
+    struct sock_filter code[] = {
+        BPF_STMT (BPF_LD | BPF_H | BPF_ABS, 12),
+        BPF_JUMP (BPF_JMP | BPF_JEQ | BPF_K, ETH_P_XIMG, 0, 1),
+        BPF_STMT (BPF_RET | BPF_K, 0xffffffff),
+        BPF_STMT (BPF_RET | BPF_K, 0),
+        BPF_STMT (BPF_LD | BPF_H | BPF_ABS, 12),
+        BPF_JUMP (BPF_JMP | BPF_JEQ | BPF_K, ETH_P_XIMG, 0, 5),
+        BPF_STMT (BPF_LD | BPF_W | BPF_ABS, 8),
+        BPF_JUMP (BPF_JMP | BPF_JEQ | BPF_K, mac_low, 0, 3),
+        BPF_STMT (BPF_LD | BPF_H | BPF_ABS, 6),
+        BPF_JUMP (BPF_JMP | BPF_JEQ | BPF_K, mac_high, 0, 1),
+        BPF_STMT (BPF_RET | BPF_K, 0xffffffff),
+        BPF_STMT (BPF_RET | BPF_K, 0),
+    };
+    struct sock_fprog program;
+
+    if (source_mac != NULL) {
+        program.len = G_N_ELEMENTS (code) - 4;
+        program.filter = code + 4;
+    } else {
+        program.len = 4;
+        program.filter = code;
+    }
+
+    return setsockopt (fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof (program));
+}
+
+/**
+ * @brief sets up the raw socket to be used for the ethernet frames, using the ring buffer
+ *
+ * @author Jonas Teufel
+ *
+ * CHANGELOG
+ *
+ * Changed 17.10.2026
+ * The amount of blocks is now passed as a parameter, because the rings of a PACKET_FANOUT group share the memory,
+ * which was previously used by one single ring.
+ *
+ * Changed 17.10.2026
+ * Instead of just the amount of blocks, the whole geometry of the ring (block size and amount, frame size and the
+ * retire timeout) is passed now. It is computed by "compute_ring_geometry".
+ *
+ * Changed 17.10.2026
+ * The socket is bound to the ximg ethertype instead of ETH_P_ALL and a BPF filter for the camera's MAC address
+ * @p source_mac is attached, before any packet can reach the ring.
+ *
+ * @param ring
+ * @param netdev
+ * @param geometry
+ * @param source_mac The MAC address of the camera or NULL, if it is unknown
+ * @return
+ */
+static int setup_raw_socket(struct ring *ring, char *netdev, const struct ring_geometry *geometry,
+                            const guint8 *source_mac) {
+
+    guint sock_opt;
+    // This will be the variable, into which we are saving the exit codes of all the functions. These functions will
     // return a negative int (-1) if an error occurred.
     int err;
     // This is the file descriptor int, which will later hold the actual socket.
@@ -1380,115 +5079,1253 @@ static int setup_raw_socket(struct ring *ring, char *netdev) {
     // case it is version 3
     int version = TPACKET_V3;
 
-    // The ring buffer consist of multiple so called blocks. And each block will hold multiple "frames" (The actual
-    // packets send over the network). Here we define How many bytes are assigned to one block and how many bytes one
-    // frame can consume. Also we define the amount of blocks the ring buffer is supposed to have.
-    // These values will later be used to define (the size of) the ring buffer struct.
-    unsigned int block_size = 1 << 16; // 22
-    unsigned int frame_size = 1 << 8;  // 11
-    unsigned int block_amount = 10000;
-    // The amount of frames is directly derived from the previous config.
-    unsigned int frame_amount = (block_size * block_amount) / frame_size;
+    // The ring buffer consist of multiple so called blocks. And each block will hold multiple "frames" (The actual
+    // packets send over the network). Here we define How many bytes are assigned to one block and how many bytes one
+    // frame can consume. Also we define the amount of blocks the ring buffer is supposed to have.
+    // These values will later be used to define (the size of) the ring buffer struct.
+    // 17.10.2026
+    // The values are no longer hardcoded (previously 10000 blocks of 64 KiB) but given by the geometry.
+    unsigned int block_size = geometry->block_size;
+    unsigned int frame_size = geometry->frame_size;
+    unsigned int block_amount = geometry->block_amount;
+    // The amount of frames is directly derived from the previous config.
+    unsigned int frame_amount = (block_size / frame_size) * block_amount;
+
+    // the total size of the ring is the size of all blocks combined
+    gsize ring_size = (gsize) block_size * block_amount;
+
+    // The socket needs to know where it is operating using a socketaddr. Usually with a TCP socket for example this
+    // would be a combination of a IP and PORT to listen on. But raw sockets use the name if the INTERFACE (ethernet).
+    // This struct, will represent a socket address, to which the listening/receiving socket will be bound.
+    struct sockaddr_ll ll;
+
+
+    // Here we are creating the actual RAW socket
+    // 17.10.2026
+    // The socket is created without a protocol, so that it does not receive anything until it is bound below. Until
+    // then the filter is in place already.
+    fd = socket(AF_PACKET, SOCK_RAW, 0);
+    if (fd < 0) {
+        g_warning("Raw Socket creation failed");
+    }
+
+    err = attach_ximg_filter(fd, source_mac);
+    if (err < 0) {
+        g_warning("Error attaching the ximg filter to the socket: %s", g_strerror(errno));
+    }
+
+    // reuse socket
+    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &sock_opt, sizeof (sock_opt));
+
+    // Now we are telling the socket, that it is supposed to be used in combination with a ring buffer, by configuring
+    // the option for which packet_mmap version is being used.
+    err = setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version));
+    if (err < 0) {
+        g_warning("Error while setting socket options");
+    }
+
+    // Here we are actually setting up the ring buffer, by telling it how many blocks/frames and their sizes it is
+    // supposed to have.
+    // "req" for "requirement"?
+    memset(&ring->req, 0, sizeof(ring->req));
+    ring->req.tp_block_size         = block_size;
+    ring->req.tp_frame_size         = frame_size;
+    ring->req.tp_block_nr           = block_amount;
+    ring->req.tp_frame_nr           = frame_amount;
+    ring->req.tp_retire_blk_tov     = geometry->retire_timeout;
+    ring->req.tp_feature_req_word   = TP_FT_REQ_FILL_RXHASH;
+    // Assigning the ring to the socket
+    err = setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &ring->req, sizeof(ring->req));
+    if (err < 0) {
+        g_warning("Error while assigning the ring to the socket");
+    }
+    // This is the actual memory mapping for the ring, previously it was just setting up configuration
+    ring->map = mmap(NULL, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, fd, 0);
+    if (ring->map == MAP_FAILED) {
+        g_warning("Error allocating ring memory");
+    }
+
+    // ?
+    // As far as I have understood it, here we are defining the starting positions of all the blocks in memory
+    // When calling "ring->rd[0].iov_base" for example, that will give us a pointer to the start of the first (index 0)
+    // block.
+    ring->rd = malloc(ring->req.tp_block_nr * sizeof(*ring->rd));
+    for (int i = 0; i < ring->req.tp_block_nr; ++i) {
+        ring->rd[i].iov_base = ring->map + (i * ring->req.tp_block_size);
+        ring->rd[i].iov_len = ring->req.tp_block_size;
+    }
+
+    // BINDING THE SOCKET
+
+    // "netdev" is the name of the interface to be used, but here we need the index of this interface:
+    int interface_index = if_nametoindex(netdev);
+    // Configuration of the socket address to be bound to
+    memset(&ll, 0, sizeof(ll));
+    ll.sll_family       = PF_PACKET;
+    ll.sll_protocol     = htons(PROTOCOL);
+    ll.sll_hatype       = 0;
+    ll.sll_pkttype      = 0;
+    ll.sll_halen        = 0;
+    ll.sll_ifindex      = interface_index;
+
+    err = bind(fd, (struct sockaddr *) &ll, sizeof(ll));
+    if (err < 0) {
+        g_warning("Error binding the socket to the interface");
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Porperly closing the used ring buffer and socket at the end of the program
+ *
+ * @author Jonas Teufel
+ *
+ * @param ring
+ * @param fd
+ */
+static void teardown_raw_socket(struct ring *ring, int fd) {
+
+    // The complete size of the ring
+    gsize ring_size = (gsize) ring->req.tp_block_size * ring->req.tp_block_nr;
+    // This command will delete the memory mapping for the ring, for that it needs the pointer to the start of the
+    // memory map (ring->map) and the ring
+    munmap(ring->map, ring_size);
+
+    // During the setup phase, we dynamically allocated memory (array) to store the information for the starting points
+    // of the blocks inside the ring buffer. This allocated memory has to be free'ed
+    free(ring->rd);
+
+    // Closing the socket properly
+    close(fd);
+}
+
+// ****************************************
+// MULTI THREADED 10G RECEPTION (FANOUT)
+// ****************************************
+
+// 17.10.2026
+// The additional time in milliseconds the reassembly waits on top of twice the block retire timeout, before it decides,
+// that an empty ring does not hold an older packet anymore. The kernel handles the retire timeout in jiffies, thus a
+// timeout of 1 ms can actually take up to 10 ms on kernels with HZ=100.
+#define FANOUT_REORDER_MARGIN       10
+
+/**
+ * @brief Counts one more block, which is owned by the plugin, and updates the high water mark of those blocks
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param fanout
+ */
+static void
+fanout_count_user_block (struct fanout *fanout)
+{
+    gint user_blocks = g_atomic_int_add (&fanout->user_blocks, 1) + 1;
+    gint user_blocks_max = g_atomic_int_get (&fanout->user_blocks_max);
+
+    while (user_blocks > user_blocks_max &&
+           !g_atomic_int_compare_and_exchange (&fanout->user_blocks_max, user_blocks_max, user_blocks))
+        user_blocks_max = g_atomic_int_get (&fanout->user_blocks_max);
+}
+
+/**
+ * @brief Receiver thread of one ring of the PACKET_FANOUT group
+ *
+ * This thread waits for the kernel to release the blocks of its ring one after the other. For every released block the
+ * ximg packets are indexed (kernel timestamp, payload pointer and payload length) and the block is passed on to the
+ * reassembly through the shared queue of the fanout group. Blocks without any ximg packet are given back to the kernel
+ * directly. The blocks are handed back to the kernel by the reassembly with "fanout_release_block" and this thread
+ * does not touch a block again, until that has happened.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Runt frames without any payload are skipped, like the AF_XDP receiver does it.
+ *
+ * @param ring
+ * @return
+ */
+static gpointer
+fanout_ring_thread (struct fanout_ring *ring)
+{
+    guint block_index = 0;
+    guint block_amount = ring->ring.req.tp_block_nr;
+    struct pollfd poll_fd;
+
+    memset (&poll_fd, 0, sizeof (poll_fd));
+    poll_fd.fd      = ring->fd;
+    poll_fd.events  = POLLIN | POLLERR;
+
+    while (!g_atomic_int_get (&ring->stop)) {
+        struct block_desc *block;
+        struct tpacket3_hdr *header;
+        struct fanout_block *fblock;
+        guint packet_amount;
+
+        block = (struct block_desc *) ring->ring.rd[block_index].iov_base;
+
+        // The block from the previous round through the ring is still being used by the reassembly. As long as that
+        // is the case, its status still says TP_STATUS_USER and polling would return immediately, so we just wait.
+        if (g_atomic_int_get (&ring->outstanding[block_index])) {
+            g_usleep (100);
+            continue;
+        }
+
+        if ((block->h1.block_status & TP_STATUS_USER) == 0) {
+            poll (&poll_fd, 1, 100);
+            continue;
+        }
+
+        // The kernel has dropped packets since this block was retired
+        if (block->h1.block_status & TP_STATUS_LOSING)
+            ring->losing_blocks += 1;
+
+        packet_amount = block->h1.num_pkts;
+        fblock = &ring->descriptors[block_index];
+        fblock->packet_amount = 0;
+        fblock->packet_index = 0;
+
+        // The descriptor is not used by the reassembly, as long as the block is not outstanding
+        if (packet_amount > fblock->packet_capacity) {
+            fblock->packets = g_renew (struct fanout_packet, fblock->packets, packet_amount);
+            fblock->packet_capacity = packet_amount;
+        }
+
+        header = (struct tpacket3_hdr *) ((guint8 *) block + block->h1.offset_to_first_pkt);
+
+        for (guint i = 0; i < packet_amount; i++) {
+            guint8 *data = (guint8 *) header + header->tp_mac;
+
+            // Only the packets with the ximg ethertype 0x88b7 carry image data. A runt frame without any payload would
+            // wrap the length around.
+            if (header->tp_snaplen > XIMG_OVERHEAD && data[12] == 0x88 && data[13] == 0xb7) {
+                struct fanout_packet *packet = &fblock->packets[fblock->packet_amount++];
+
+                packet->timestamp = (guint64) header->tp_sec * 1000000000 + header->tp_nsec;
+                packet->data = data + XIMG_OVERHEAD;
+                packet->length = header->tp_snaplen - XIMG_OVERHEAD;
+                ring->bytes += packet->length;
+            } else {
+                ring->skipped += 1;
+            }
+
+            header = (struct tpacket3_hdr *) ((guint8 *) header + header->tp_next_offset);
+        }
+
+        ring->packets += fblock->packet_amount;
+        ring->blocks += 1;
+
+        // The order of these operations matters for "fanout_ring_is_settled": An indexed block is counted before the
+        // next block index is published, an empty block is only given back after that.
+        if (fblock->packet_amount == 0) {
+            g_atomic_int_set (&ring->next_block, (block_index + 1) % block_amount);
+            block->h1.block_status = TP_STATUS_KERNEL;
+        } else {
+            g_atomic_int_set (&ring->outstanding[block_index], 1);
+            fanout_count_user_block (ring->fanout);
+            g_async_queue_push (ring->queue, fblock);
+            g_atomic_int_inc (&ring->indexed);
+            g_atomic_int_set (&ring->next_block, (block_index + 1) % block_amount);
+        }
+
+        block_index = (block_index + 1) % block_amount;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Gives a block, which has been completely consumed by the reassembly, back to the kernel
+ *
+ * The status has to be written before the block is marked as not outstanding anymore. Otherwise the receiver thread
+ * could see the old TP_STATUS_USER of the block and index it a second time.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param fblock
+ */
+static void
+fanout_release_block (struct fanout_block *fblock)
+{
+    struct fanout_ring *ring = fblock->owner;
+    struct block_desc *block = (struct block_desc *) ring->ring.rd[fblock->index].iov_base;
+
+    block->h1.block_status = TP_STATUS_KERNEL;
+    g_atomic_int_set (&ring->outstanding[fblock->index], 0);
+    g_atomic_int_add (&ring->fanout->user_blocks, -1);
+}
+
+static void fanout_teardown (struct fanout *fanout);
+
+/**
+ * @brief Creates the rings of a new PACKET_FANOUT group and starts one receiver thread for each of them
+ *
+ * The kernel distributes the packets of the group in a round robin fashion (PACKET_FANOUT_LB). Hashing the packets with
+ * the rxhash, which the rings request with TP_FT_REQ_FILL_RXHASH, is of no use here: All the ximg packets of a camera
+ * belong to the same flow and would therefore all end up in the same ring.
+ * The blocks of the geometry are split evenly between the rings, so that the amount of locked memory does not depend
+ * on the amount of rings.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * If a ring cannot be added to the group, the rings created so far are closed again and NULL is returned.
+ *
+ * @param netdev
+ * @param geometry
+ * @param source_mac
+ * @param error
+ * @return The fanout group or NULL, if it could not be created
+ */
+static struct fanout *
+fanout_setup (char *netdev, const struct ring_geometry *geometry, const guint8 *source_mac, GError **error)
+{
+    guint ring_amount = geometry->ring_amount;
+    struct ring_geometry ring_geometry = *geometry;
+    // The group id has to be unique for the whole system. Every camera object, that starts a readout gets a new one.
+    static volatile gint group_counter = 0;
+    struct fanout *fanout;
+    gint group_id;
+    gint fanout_arg;
+    guint packet_capacity;
+
+    group_id = (getpid () + g_atomic_int_add (&group_counter, 1)) & 0xffff;
+    fanout_arg = group_id | (PACKET_FANOUT_LB << 16);
+    ring_geometry.block_amount = MAX (geometry->block_amount / ring_amount, 1);
+    // A block holds at least this many packets of the maximum size
+    packet_capacity = MAX (geometry->block_size / TPACKET_ALIGN (TPACKET3_HDRLEN + ETH_HLEN + geometry->mtu), 1);
+
+    fanout = g_new0 (struct fanout, 1);
+    fanout->ring_amount = ring_amount;
+    fanout->rings = g_new0 (struct fanout_ring, ring_amount);
+    fanout->queue = g_async_queue_new ();
+    fanout->last_ring = ring_amount - 1;
+
+    for (guint i = 0; i < ring_amount; i++) {
+        struct fanout_ring *ring = &fanout->rings[i];
+
+        ring->fd = setup_raw_socket (&ring->ring, netdev, &ring_geometry, source_mac);
+        ring->queue = fanout->queue;
+        ring->fanout = fanout;
+        ring->outstanding = g_new0 (gint, ring->ring.req.tp_block_nr);
+        ring->descriptors = g_new0 (struct fanout_block, ring->ring.req.tp_block_nr);
+        g_queue_init (&ring->pending);
+
+        for (guint j = 0; j < ring->ring.req.tp_block_nr; j++) {
+            ring->descriptors[j].owner = ring;
+            ring->descriptors[j].index = j;
+            ring->descriptors[j].packet_capacity = packet_capacity;
+            ring->descriptors[j].packets = g_new (struct fanout_packet, ring->descriptors[j].packet_capacity);
+        }
+
+        if (setsockopt (ring->fd, SOL_PACKET, PACKET_FANOUT, &fanout_arg, sizeof (fanout_arg)) < 0) {
+            g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                         "Could not add ring %u to fanout group %i: %s", i, group_id, g_strerror (errno));
+            // No receiver thread has been started yet, only the rings up to this one have to be closed again
+            fanout->ring_amount = i + 1;
+            fanout_teardown (fanout);
+            return NULL;
+        }
+    }
+
+    for (guint i = 0; i < ring_amount; i++)
+        fanout->rings[i].thread = g_thread_new ("ximg-ring", (GThreadFunc) fanout_ring_thread, &fanout->rings[i]);
+
+    return fanout;
+}
+
+/**
+ * @brief Stops all the receiver threads of the fanout group and closes their rings
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param fanout
+ */
+static void
+fanout_teardown (struct fanout *fanout)
+{
+    for (guint i = 0; i < fanout->ring_amount; i++)
+        g_atomic_int_set (&fanout->rings[i].stop, 1);
+
+    for (guint i = 0; i < fanout->ring_amount; i++) {
+        struct fanout_ring *ring = &fanout->rings[i];
+
+        if (ring->thread != NULL)
+            g_thread_join (ring->thread);
+
+        g_queue_clear (&ring->pending);
+    }
+
+    for (guint i = 0; i < fanout->ring_amount; i++) {
+        struct fanout_ring *ring = &fanout->rings[i];
+
+        for (guint j = 0; j < ring->ring.req.tp_block_nr; j++)
+            g_free (ring->descriptors[j].packets);
+
+        teardown_raw_socket (&ring->ring, ring->fd);
+        g_free ((gpointer) ring->outstanding);
+        g_free (ring->descriptors);
+    }
+
+    g_async_queue_unref (fanout->queue);
+    g_free (fanout->rings);
+    g_free (fanout);
+}
+
+/**
+ * @brief Returns the ring, which holds the next packet in the order of reception
+ *
+ * The next packet is the one with the oldest kernel timestamp among the head packets of all rings. In case of equal
+ * timestamps the round robin order of the fanout decides, starting with the ring after the previously used one.
+ * @p complete is set to FALSE, if at least one of the rings has no pending packet at the moment, in which case the
+ * returned ring might not be the right one yet.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param fanout
+ * @param complete
+ * @return
+ */
+static struct fanout_ring *
+fanout_next_ring (struct fanout *fanout, gboolean *complete)
+{
+    struct fanout_ring *next = NULL;
+    guint64 oldest = G_MAXUINT64;
+
+    *complete = TRUE;
+
+    for (guint k = 1; k <= fanout->ring_amount; k++) {
+        guint i = (fanout->last_ring + k) % fanout->ring_amount;
+        struct fanout_block *fblock = g_queue_peek_head (&fanout->rings[i].pending);
+        guint64 timestamp;
+
+        if (fblock == NULL) {
+            *complete = FALSE;
+            continue;
+        }
+
+        timestamp = fblock->packets[fblock->packet_index].timestamp;
+
+        if (timestamp < oldest) {
+            oldest = timestamp;
+            next = &fanout->rings[i];
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief Whether a ring without pending packets can not hold a packet older than @p timestamp anymore
+ *
+ * This is the case, when all the blocks indexed by the receiver thread have arrived at the reassembly, the next block
+ * of the ring has not been released to the user space and enough time has passed since @p timestamp, that the kernel
+ * would have retired that block, if it contained an older packet.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param ring
+ * @param timestamp
+ * @return
+ */
+static gboolean
+fanout_ring_is_settled (struct fanout_ring *ring, guint64 timestamp)
+{
+    struct block_desc *block;
+    gint64 window;
+    gint next_block;
+
+    next_block = g_atomic_int_get (&ring->next_block);
+
+    if ((guint) g_atomic_int_get (&ring->indexed) != ring->received)
+        return FALSE;
+
+    block = (struct block_desc *) ring->ring.rd[next_block].iov_base;
+
+    if (block->h1.block_status & TP_STATUS_USER)
+        return FALSE;
+
+    window = (2 * ring->ring.req.tp_retire_blk_tov + FANOUT_REORDER_MARGIN) * G_TIME_SPAN_MILLISECOND;
+    return g_get_real_time () >= (gint64) (timestamp / 1000) + window;
+}
+
+/**
+ * @brief Moves a block, which has been indexed by a receiver thread, to the pending list of its ring
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param fblock
+ */
+static void
+fanout_add_pending (struct fanout_block *fblock)
+{
+    g_queue_push_tail (&fblock->owner->pending, fblock);
+    fblock->owner->received += 1;
+}
+
+/**
+ * @brief Receives the image data of one frame from the rings of the fanout group
+ *
+ * This is the counterpart of "read_ximg_data" for more than one receive thread. The packets, which have been indexed by
+ * the receiver threads, are merged back into their original order and their payload is appended to the data buffer
+ * of the camera object, updating "parser->total" for the unpack thread the same way the single ring does.
+ * If one of the rings is empty, the oldest pending packet can only be taken once it is certain, that this ring does
+ * not hold an even older packet (see "fanout_ring_is_settled"). This only delays the last packets of a transmission.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * If no block is received within XIMG_RECEIVE_TIMEOUT, the rest of the frame is abandoned and @p error is set.
+ *
+ * @param priv
+ * @param fanout
+ * @param error
+ */
+static void
+read_ximg_data_fanout (UcaPhantomCameraPrivate *priv, struct fanout *fanout, GError **error)
+{
+    struct ximg_parser *parser = priv->xg_parser;
+    gint64 deadline = g_get_monotonic_time () + XIMG_RECEIVE_TIMEOUT * G_TIME_SPAN_MILLISECOND;
+
+    start_ximg_frame (parser);
+
+    while (parser->total < parser->expected) {
+        struct fanout_ring *ring;
+        struct fanout_block *fblock;
+        struct fanout_packet *packet;
+        gboolean complete;
+
+        // All the blocks, which the receiver threads have indexed in the meantime, are sorted into the pending lists of
+        // their rings first.
+        while ((fblock = g_async_queue_try_pop (fanout->queue)) != NULL)
+            fanout_add_pending (fblock);
+
+        ring = fanout_next_ring (fanout, &complete);
+
+        if (ring == NULL) {
+            fblock = g_async_queue_timeout_pop (fanout->queue, 100 * G_TIME_SPAN_MILLISECOND);
+
+            if (fblock != NULL)
+                fanout_add_pending (fblock);
+            else if (g_get_monotonic_time () >= deadline)
+                abandon_ximg_frame (parser, error, XIMG_RECEIVE_TIMEOUT_REASON);
+
+            continue;
+        }
+
+        fblock = g_queue_peek_head (&ring->pending);
+        packet = &fblock->packets[fblock->packet_index];
 
-    // the total size of the ring is the size of all blocks combined
-    unsigned int ring_size = block_size * block_amount;
+        if (!complete) {
+            gboolean settled = TRUE;
 
-    // The socket needs to know where it is operating using a socketaddr. Usually with a TCP socket for example this
-    // would be a combination of a IP and PORT to listen on. But raw sockets use the name if the INTERFACE (ethernet).
-    // This struct, will represent a socket address, to which the listening/receiving socket will be bound.
-    struct sockaddr_ll ll;
+            for (guint i = 0; i < fanout->ring_amount && settled; i++) {
+                if (g_queue_is_empty (&fanout->rings[i].pending))
+                    settled = fanout_ring_is_settled (&fanout->rings[i], packet->timestamp);
+            }
 
+            if (!settled) {
+                fblock = g_async_queue_timeout_pop (fanout->queue, G_TIME_SPAN_MILLISECOND);
 
-    // Here we are creating the actual RAW socket
-    fd = socket(AF_PACKET, SOCK_RAW, htons(PROTOCOL));
-    if (fd < 0) {
-        g_warning("Raw Socket creation failed");
+                if (fblock != NULL)
+                    fanout_add_pending (fblock);
+
+                continue;
+            }
+        }
+
+        // A packet, which already belongs to the next frame, is left in the block for the next call
+        if (!receive_ximg_packet (parser, packet->data, packet->length))
+            break;
+
+        fblock->packet_index += 1;
+        fanout->last_ring = ring - fanout->rings;
+
+        if (fblock->packet_index == fblock->packet_amount) {
+            g_queue_pop_head (&ring->pending);
+            fanout_release_block (fblock);
+            deadline = g_get_monotonic_time () + XIMG_RECEIVE_TIMEOUT * G_TIME_SPAN_MILLISECOND;
+        }
     }
+}
 
-    // reuse socket
-    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &sock_opt, sizeof (sock_opt));
+// ************************
+// AF_XDP RECEPTION
+// ************************
 
-    // Now we are telling the socket, that it is supposed to be used in combination with a ring buffer, by configuring
-    // the option for which packet_mmap version is being used.
-    err = setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version));
-    if (err < 0) {
-        g_warning("Error while setting socket options");
+// 17.10.2026
+// The UMEM of the AF_XDP backend is divided into frames of one page each, so a packet may at most be about 3.5 KB
+// (jumbo frames are not supported). The amount of frames is derived from the locked memory of the ring geometry and is
+// limited to the following range. It has to be a power of two, as all the rings have as many entries as there are frames.
+#define XDP_FRAME_SIZE              4096
+#define XDP_MIN_FRAME_AMOUNT        (1 << 11)
+#define XDP_MAX_FRAME_AMOUNT        (1 << 18)
+
+static int
+xdp_bpf (int command, union bpf_attr *attr)
+{
+    return syscall (__NR_bpf, command, attr, sizeof (*attr));
+}
+
+/**
+ * @brief Loads the XDP program, which redirects the ximg packets into the XDP socket of the receiving rx queue
+ *
+ * The program is equivalent to the BPF filter of the packet mmap backend: Packets with the ximg ethertype (and the MAC
+ * address of the camera, if it is known) are redirected into the socket, which is stored in the XSKMAP for the rx
+ * queue of the packet. All other packets are passed on to the network stack.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param map_fd
+ * @param source_mac The MAC address of the camera or NULL
+ * @return The file descriptor of the program or a negative value
+ */
+static int
+xdp_load_program (int map_fd, const guint8 *source_mac)
+{
+    // The ethertype and the MAC address are compared as little endian values loaded from the packet
+    guint32 ethertype = ((ETH_P_XIMG & 0xff) << 8) | (ETH_P_XIMG >> 8);
+    guint32 mac_low = 0;
+    guint32 mac_high = 0;
+    static const gchar license[] = "GPL";
+    union bpf_attr attr;
+
+    if (source_mac != NULL) {
+        mac_low = source_mac[0] | (source_mac[1] << 8) | (source_mac[2] << 16) | ((guint32) source_mac[3] << 24);
+        mac_high = source_mac[4] | (source_mac[5] << 8);
     }
 
-    // Here we are actually setting up the ring buffer, by telling it how many blocks/frames and their sizes it is
-    // supposed to have.
-    // "req" for "requirement"?
-    memset(&ring->req, 0, sizeof(ring->req));
-    ring->req.tp_block_size         = block_size;
-    ring->req.tp_frame_size         = frame_size;
-    ring->req.tp_block_nr           = block_amount;
-    ring->req.tp_frame_nr           = frame_amount;
-    ring->req.tp_retire_blk_tov     = 1;
-    ring->req.tp_feature_req_word   = TP_FT_REQ_FILL_RXHASH;
-    // Assigning the ring to the socket
-    err = setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &ring->req, sizeof(ring->req));
-    if (err < 0) {
-        g_warning("Error while assigning the ring to the socket");
+    // All the conditional jumps lead to the two instructions at the very end, which pass the packet on to the stack.
+    // r1 holds the xdp_md context: data (+0), data_end (+4) and rx_queue_index (+16).
+    struct bpf_insn code[] = {
+        { BPF_LDX | BPF_MEM | BPF_W,    BPF_REG_2, BPF_REG_1, 0,  0 },
+        { BPF_LDX | BPF_MEM | BPF_W,    BPF_REG_3, BPF_REG_1, 4,  0 },
+        { BPF_ALU64 | BPF_MOV | BPF_X,  BPF_REG_4, BPF_REG_2, 0,  0 },
+        { BPF_ALU64 | BPF_ADD | BPF_K,  BPF_REG_4, 0,         0,  ETH_HLEN },
+        { BPF_JMP | BPF_JGT | BPF_X,    BPF_REG_4, BPF_REG_3, 12, 0 },
+        { BPF_LDX | BPF_MEM | BPF_H,    BPF_REG_4, BPF_REG_2, 12, 0 },
+        { BPF_JMP32 | BPF_JNE | BPF_K,  BPF_REG_4, 0,         10, ethertype },
+        { BPF_LDX | BPF_MEM | BPF_W,    BPF_REG_4, BPF_REG_2, 6,  0 },
+        { BPF_JMP32 | BPF_JNE | BPF_K,  BPF_REG_4, 0,         8,  mac_low },
+        { BPF_LDX | BPF_MEM | BPF_H,    BPF_REG_4, BPF_REG_2, 10, 0 },
+        { BPF_JMP32 | BPF_JNE | BPF_K,  BPF_REG_4, 0,         6,  mac_high },
+        { BPF_LDX | BPF_MEM | BPF_W,    BPF_REG_2, BPF_REG_1, 16, 0 },
+        { BPF_LD | BPF_DW | BPF_IMM,    BPF_REG_1, BPF_PSEUDO_MAP_FD, 0, map_fd },
+        { 0,                            0,         0,         0,  0 },
+        { BPF_ALU64 | BPF_MOV | BPF_K,  BPF_REG_3, 0,         0,  XDP_PASS },
+        { BPF_JMP | BPF_CALL,           0,         0,         0,  BPF_FUNC_redirect_map },
+        { BPF_JMP | BPF_EXIT,           0,         0,         0,  0 },
+        { BPF_ALU64 | BPF_MOV | BPF_K,  BPF_REG_0, 0,         0,  XDP_PASS },
+        { BPF_JMP | BPF_EXIT,           0,         0,         0,  0 },
+    };
+
+    // Without a MAC address the four instructions checking it are replaced by no-ops. The verifier does not accept
+    // unreachable instructions, so they cannot simply be jumped over.
+    if (source_mac == NULL) {
+        for (guint i = 7; i < 11; i++) {
+            struct bpf_insn nop = { BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, 0 };
+            code[i] = nop;
+        }
     }
-    // This is the actual memory mapping for the ring, previously it was just setting up configuration
-    ring->map = mmap(NULL, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, fd, 0);
-    if (ring->map == MAP_FAILED) {
-        g_warning("Error allocating ring memory");
+
+    memset (&attr, 0, sizeof (attr));
+    attr.prog_type = BPF_PROG_TYPE_XDP;
+    attr.insn_cnt = G_N_ELEMENTS (code);
+    attr.insns = (guint64) (guintptr) code;
+    attr.license = (guint64) (guintptr) license;
+
+    return xdp_bpf (BPF_PROG_LOAD, &attr);
+}
+
+/**
+ * @brief Maps one of the rings of the XDP socket into memory
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param fd
+ * @param ring
+ * @param offsets The offsets of the ring as returned by XDP_MMAP_OFFSETS
+ * @param page_offset
+ * @param descriptor_size
+ * @return
+ */
+static gboolean
+xdp_map_ring (int fd, struct xdp_ring *ring, struct xdp_ring_offset *offsets, off_t page_offset,
+              gsize descriptor_size)
+{
+    guint8 *map;
+
+    ring->map_size = offsets->desc + ring->size * descriptor_size;
+    map = mmap (NULL, ring->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, page_offset);
+
+    if (map == MAP_FAILED) {
+        ring->map = NULL;
+        return FALSE;
     }
 
-    // ?
-    // As far as I have understood it, here we are defining the starting positions of all the blocks in memory
-    // When calling "ring->rd[0].iov_base" for example, that will give us a pointer to the start of the first (index 0)
-    // block.
-    ring->rd = malloc(ring->req.tp_block_nr * sizeof(*ring->rd));
-    for (int i = 0; i < ring->req.tp_block_nr; ++i) {
-        ring->rd[i].iov_base = ring->map + (i * ring->req.tp_block_size);
-        ring->rd[i].iov_len = ring->req.tp_block_size;
+    ring->map = map;
+    ring->producer = (guint32 *) (map + offsets->producer);
+    ring->consumer = (guint32 *) (map + offsets->consumer);
+    ring->descriptors = map + offsets->desc;
+    return TRUE;
+}
+
+/**
+ * @brief Releases all the resources of the AF_XDP backend. The XDP program is detached, when its link is closed.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param xdp
+ */
+static void
+xdp_teardown (struct xdp_receiver *xdp)
+{
+    if (xdp->link_fd >= 0)
+        close (xdp->link_fd);
+
+    if (xdp->program_fd >= 0)
+        close (xdp->program_fd);
+
+    if (xdp->fill.map != NULL)
+        munmap (xdp->fill.map, xdp->fill.map_size);
+
+    if (xdp->completion.map != NULL)
+        munmap (xdp->completion.map, xdp->completion.map_size);
+
+    if (xdp->rx.map != NULL)
+        munmap (xdp->rx.map, xdp->rx.map_size);
+
+    if (xdp->fd >= 0)
+        close (xdp->fd);
+
+    if (xdp->map_fd >= 0)
+        close (xdp->map_fd);
+
+    if (xdp->umem != NULL)
+        munmap (xdp->umem, xdp->umem_size);
+
+    g_free (xdp);
+}
+
+/**
+ * @brief Sets up the XDP socket with its UMEM and rings and attaches the XDP program to the interface
+ *
+ * The program is attached in native (driver) mode if possible and in generic mode otherwise, which works with every
+ * network driver. Only in native mode the socket is bound in zero copy mode, in which the NIC writes the packets
+ * directly into the UMEM. Only the given rx queue of the interface is served, so on multi queue NICs all the ximg
+ * traffic has to be steered to this queue (or the NIC has to be configured to use only a single queue).
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param netdev
+ * @param queue_id
+ * @param geometry The frame amount of the UMEM is derived from the locked memory of this geometry
+ * @param source_mac The MAC address of the camera or NULL
+ * @param error
+ * @return The receiver or NULL in case of an error
+ */
+static struct xdp_receiver *
+xdp_setup (char *netdev, guint queue_id, const struct ring_geometry *geometry, const guint8 *source_mac,
+           GError **error)
+{
+    struct xdp_receiver *xdp;
+    struct xdp_umem_reg umem_reg;
+    struct xdp_mmap_offsets offsets;
+    struct sockaddr_xdp address;
+    union bpf_attr attr;
+    socklen_t length;
+    guint64 frame_amount;
+    gint interface_index;
+    gint ring_size;
+
+    interface_index = if_nametoindex (netdev);
+
+    xdp = g_new0 (struct xdp_receiver, 1);
+    xdp->fd = xdp->map_fd = xdp->program_fd = xdp->link_fd = -1;
+    xdp->queue_id = queue_id;
+    xdp->frame_size = XDP_FRAME_SIZE;
+
+    frame_amount = get_ring_locked_memory (geometry) / XDP_FRAME_SIZE;
+    frame_amount = CLAMP (frame_amount, XDP_MIN_FRAME_AMOUNT, XDP_MAX_FRAME_AMOUNT);
+    xdp->frame_amount = 1 << (g_bit_storage (frame_amount) - 1);
+    ring_size = xdp->frame_amount;
+
+    // THE UMEM
+    // The memory is registered with the kernel, which pins it just like the packet mmap ring.
+    xdp->umem_size = (gsize) xdp->frame_amount * xdp->frame_size;
+    xdp->umem = mmap (NULL, xdp->umem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+
+    if (xdp->umem == MAP_FAILED) {
+        xdp->umem = NULL;
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "Could not allocate %" G_GSIZE_FORMAT " bytes of UMEM: %s", xdp->umem_size, g_strerror (errno));
+        goto setup_error;
+    }
+
+    xdp->fd = socket (AF_XDP, SOCK_RAW, 0);
+
+    if (xdp->fd < 0) {
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "Could not create XDP socket: %s", g_strerror (errno));
+        goto setup_error;
+    }
+
+    memset (&umem_reg, 0, sizeof (umem_reg));
+    umem_reg.addr = (guint64) (guintptr) xdp->umem;
+    umem_reg.len = xdp->umem_size;
+    umem_reg.chunk_size = xdp->frame_size;
+
+    if (setsockopt (xdp->fd, SOL_XDP, XDP_UMEM_REG, &umem_reg, sizeof (umem_reg)) < 0 ||
+        setsockopt (xdp->fd, SOL_XDP, XDP_UMEM_FILL_RING, &ring_size, sizeof (ring_size)) < 0 ||
+        setsockopt (xdp->fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &ring_size, sizeof (ring_size)) < 0 ||
+        setsockopt (xdp->fd, SOL_XDP, XDP_RX_RING, &ring_size, sizeof (ring_size)) < 0) {
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "Could not register the UMEM of the XDP socket: %s", g_strerror (errno));
+        goto setup_error;
+    }
+
+    length = sizeof (offsets);
+
+    xdp->fill.size = xdp->completion.size = xdp->rx.size = ring_size;
+
+    if (getsockopt (xdp->fd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &length) < 0 ||
+        !xdp_map_ring (xdp->fd, &xdp->fill, &offsets.fr, XDP_UMEM_PGOFF_FILL_RING, sizeof (guint64)) ||
+        !xdp_map_ring (xdp->fd, &xdp->completion, &offsets.cr, XDP_UMEM_PGOFF_COMPLETION_RING, sizeof (guint64)) ||
+        !xdp_map_ring (xdp->fd, &xdp->rx, &offsets.rx, XDP_PGOFF_RX_RING, sizeof (struct xdp_desc))) {
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "Could not map the rings of the XDP socket: %s", g_strerror (errno));
+        goto setup_error;
+    }
+
+    // Initially all the frames are handed to the kernel
+    for (guint i = 0; i < xdp->frame_amount; i++)
+        ((guint64 *) xdp->fill.descriptors)[i] = (guint64) i * xdp->frame_size;
+
+    g_atomic_int_set ((gint *) xdp->fill.producer, xdp->frame_amount);
+
+    // THE XDP PROGRAM
+    memset (&attr, 0, sizeof (attr));
+    attr.map_type = BPF_MAP_TYPE_XSKMAP;
+    attr.key_size = sizeof (guint32);
+    attr.value_size = sizeof (guint32);
+    attr.max_entries = queue_id + 1;
+    xdp->map_fd = xdp_bpf (BPF_MAP_CREATE, &attr);
+
+    if (xdp->map_fd >= 0)
+        xdp->program_fd = xdp_load_program (xdp->map_fd, source_mac);
+
+    if (xdp->program_fd < 0) {
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "Could not load the XDP program: %s", g_strerror (errno));
+        goto setup_error;
+    }
+
+    memset (&attr, 0, sizeof (attr));
+    attr.link_create.prog_fd = xdp->program_fd;
+    attr.link_create.target_ifindex = interface_index;
+    attr.link_create.attach_type = BPF_XDP;
+    attr.link_create.flags = XDP_FLAGS_DRV_MODE;
+    xdp->link_fd = xdp_bpf (BPF_LINK_CREATE, &attr);
+    xdp->native = xdp->link_fd >= 0;
+
+    if (!xdp->native) {
+        attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+        xdp->link_fd = xdp_bpf (BPF_LINK_CREATE, &attr);
+    }
+
+    if (xdp->link_fd < 0) {
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "Could not attach the XDP program to %s: %s", netdev, g_strerror (errno));
+        goto setup_error;
     }
 
     // BINDING THE SOCKET
+    memset (&address, 0, sizeof (address));
+    address.sxdp_family = AF_XDP;
+    address.sxdp_ifindex = interface_index;
+    address.sxdp_queue_id = queue_id;
+    address.sxdp_flags = XDP_ZEROCOPY;
+    xdp->zero_copy = xdp->native && bind (xdp->fd, (struct sockaddr *) &address, sizeof (address)) == 0;
+
+    if (!xdp->zero_copy) {
+        address.sxdp_flags = XDP_COPY;
+
+        if (bind (xdp->fd, (struct sockaddr *) &address, sizeof (address)) < 0) {
+            g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                         "Could not bind the XDP socket to queue %u of %s: %s", queue_id, netdev, g_strerror (errno));
+            goto setup_error;
+        }
+    }
 
-    // "netdev" is the name of the interface to be used, but here we need the index of this interface:
-    int interface_index = if_nametoindex(netdev);
-    // Configuration of the socket address to be bound to
-    memset(&ll, 0, sizeof(ll));
-    ll.sll_family       = PF_PACKET;
-    ll.sll_protocol     = htons(PROTOCOL);
-    ll.sll_hatype       = 0;
-    ll.sll_pkttype      = 0;
-    ll.sll_halen        = 0;
-    ll.sll_ifindex      = interface_index;
+    memset (&attr, 0, sizeof (attr));
+    attr.map_fd = xdp->map_fd;
+    attr.key = (guint64) (guintptr) &xdp->queue_id;
+    attr.value = (guint64) (guintptr) &xdp->fd;
+
+    if (xdp_bpf (BPF_MAP_UPDATE_ELEM, &attr) < 0) {
+        g_set_error (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                     "Could not insert the XDP socket into the XSKMAP: %s", g_strerror (errno));
+        goto setup_error;
+    }
+
+    g_debug ("AF_XDP reception on %s queue %u: %s mode, %s, %u frames",
+             netdev, queue_id, xdp->native ? "native" : "generic", xdp->zero_copy ? "zero copy" : "copy",
+             xdp->frame_amount);
+
+    return xdp;
+
+setup_error:
+    xdp_teardown (xdp);
+    return NULL;
+}
+
+/**
+ * @brief Receives the data of one frame using the AF_XDP backend
+ *
+ * The payload is appended to the frame directly from the UMEM, from where it is also decoded in place with the zero
+ * copy mode. Afterwards the UMEM frame is handed back to the kernel using the fill ring.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Socket errors and the receive timeout abandon the rest of the frame and set @p error. Only the payload of the
+ * packets is counted as received bytes, as with the packet mmap rings.
+ *
+ * @param priv
+ * @param xdp
+ * @param error
+ */
+static void
+read_ximg_data_xdp (UcaPhantomCameraPrivate *priv, struct xdp_receiver *xdp, GError **error)
+{
+    struct ximg_parser *parser = priv->xg_parser;
+    struct xdp_desc *descriptors = xdp->rx.descriptors;
+    guint64 *fill = xdp->fill.descriptors;
+    guint32 mask = xdp->rx.size - 1;
+    gint64 deadline = g_get_monotonic_time () + XIMG_RECEIVE_TIMEOUT * G_TIME_SPAN_MILLISECOND;
+    struct pollfd poll_fd;
+
+    start_ximg_frame (parser);
+
+    poll_fd.fd = xdp->fd;
+    poll_fd.events = POLLIN;
+
+    while (parser->total < parser->expected) {
+        guint32 consumer = *xdp->rx.consumer;
+        guint32 producer = g_atomic_int_get ((gint *) xdp->rx.producer);
+        guint32 fill_producer;
+
+        if (consumer == producer) {
+            gint socket_error = 0;
+            socklen_t length = sizeof (socket_error);
+
+            poll_fd.revents = 0;
+
+            if (poll (&poll_fd, 1, 100) < 0 && errno != EINTR)
+                socket_error = errno;
+            else if (poll_fd.revents & POLLERR)
+                getsockopt (xdp->fd, SOL_SOCKET, SO_ERROR, &socket_error, &length);
+
+            if (socket_error != 0)
+                abandon_ximg_frame (parser, error, g_strerror (socket_error));
+            else if (g_get_monotonic_time () >= deadline)
+                abandon_ximg_frame (parser, error, XIMG_RECEIVE_TIMEOUT_REASON);
+
+            continue;
+        }
+
+        deadline = g_get_monotonic_time () + XIMG_RECEIVE_TIMEOUT * G_TIME_SPAN_MILLISECOND;
+
+        fill_producer = *xdp->fill.producer;
+
+        while (consumer != producer && parser->total < parser->expected) {
+            struct xdp_desc *descriptor = &descriptors[consumer & mask];
+            guint8 *data = xdp->umem + descriptor->addr;
+
+            if (descriptor->len > XIMG_OVERHEAD && data[12] == (ETH_P_XIMG >> 8) && data[13] == (ETH_P_XIMG & 0xff)) {
+                // A packet, which already belongs to the next frame, stays in the rx ring
+                if (!receive_ximg_packet (parser, data + XIMG_OVERHEAD, descriptor->len - XIMG_OVERHEAD))
+                    break;
+
+                xdp->packets++;
+                xdp->bytes += descriptor->len - XIMG_OVERHEAD;
+            }
+            else {
+                xdp->skipped++;
+            }
+
+            // In the aligned mode the kernel accepts any address within a frame, the offset of the packet is
+            // removed nonetheless.
+            fill[fill_producer & mask] = descriptor->addr - (descriptor->addr % xdp->frame_size);
+            fill_producer++;
+            consumer++;
+        }
+
+        g_atomic_int_set ((gint *) xdp->fill.producer, fill_producer);
+        g_atomic_int_set ((gint *) xdp->rx.consumer, consumer);
+    }
+}
+
+/**
+ * @brief Samples the kernel statistics of the 10G socket(s) and accumulates them in the camera object
+ *
+ * For the packet mmap backend, reading PACKET_STATISTICS resets the kernel counters. That is why only the receiving
+ * thread reads them, after every frame, and the totals are kept in the camera object. Additionally the amount of ring
+ * blocks currently owned by the plugin is determined, to keep track of the highest amount so far. If that reaches the
+ * total amount of blocks, the ring overflows. For the AF_XDP backend the statistics are not reset by reading them, the
+ * full rx ring counts as drop and the empty fill ring as freeze.
+ * Once the first drop has been seen, "xg_drop_state" is set, so that the next "grab" emits the "packets-dropped" signal.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The current fill level of the ring is determined as well and the highest one is kept in "xg_ring_fill_peak".
+ *
+ * @param priv
+ * @param ring The single ring, only used if neither fanout nor xdp is given
+ * @param fanout
+ * @param xdp
+ */
+static void
+sample_ring_statistics (UcaPhantomCameraPrivate *priv,
+                        struct ring *ring,
+                        struct fanout *fanout,
+                        struct xdp_receiver *xdp)
+{
+    struct tpacket_stats_v3 stats;
+    socklen_t length;
+    guint user_blocks = 0;
+    gint fill = 0;
+    gint fill_peak;
+
+    if (xdp != NULL) {
+        struct xdp_statistics xdp_stats;
+
+        length = sizeof (xdp_stats);
+        memset (&xdp_stats, 0, sizeof (xdp_stats));
+
+        if (getsockopt (xdp->fd, SOL_XDP, XDP_STATISTICS, &xdp_stats, &length) == 0) {
+            priv->xg_kernel_drops = xdp_stats.rx_dropped + xdp_stats.rx_ring_full;
+            priv->xg_kernel_freezes = xdp_stats.rx_fill_ring_empty_descs;
+        }
+
+        priv->xg_kernel_packets = xdp->packets + xdp->skipped;
+        user_blocks = g_atomic_int_get ((gint *) xdp->rx.producer) - *xdp->rx.consumer;
+        fill = ((guint64) user_blocks * 1000) / xdp->rx.size;
+    } else if (fanout != NULL) {
+        priv->xg_kernel_packets = 0;
+        priv->xg_kernel_drops = 0;
+        priv->xg_kernel_freezes = 0;
+        priv->xg_losing_blocks = 0;
+
+        for (guint i = 0; i < fanout->ring_amount; i++) {
+            struct fanout_ring *fring = &fanout->rings[i];
+
+            length = sizeof (stats);
+            memset (&stats, 0, sizeof (stats));
+
+            if (getsockopt (fring->fd, SOL_PACKET, PACKET_STATISTICS, &stats, &length) == 0) {
+                fring->kernel_packets += stats.tp_packets;
+                fring->kernel_drops += stats.tp_drops;
+                fring->kernel_freezes += stats.tp_freeze_q_cnt;
+            }
+
+            priv->xg_kernel_packets += fring->kernel_packets;
+            priv->xg_kernel_drops += fring->kernel_drops;
+            priv->xg_kernel_freezes += fring->kernel_freezes;
+            priv->xg_losing_blocks += fring->losing_blocks;
+        }
+
+        user_blocks = g_atomic_int_get (&fanout->user_blocks_max);
+        fill = ((guint64) MAX (g_atomic_int_get (&fanout->user_blocks), 0) * 1000) / priv->xg_geometry.block_amount;
+    } else if (ring->map != NULL) {
+        guint block_amount = ring->req.tp_block_nr;
+
+        length = sizeof (stats);
+        memset (&stats, 0, sizeof (stats));
+
+        if (getsockopt (priv->xg_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &length) == 0) {
+            priv->xg_kernel_packets += stats.tp_packets;
+            priv->xg_kernel_drops += stats.tp_drops;
+            priv->xg_kernel_freezes += stats.tp_freeze_q_cnt;
+        }
+
+        // The blocks owned by the plugin are the ones following the current block, which the kernel has already
+        // released.
+        while (user_blocks < block_amount) {
+            struct block_desc *block = ring->rd[(priv->xg_parser->block_index + user_blocks) % block_amount].iov_base;
+
+            if ((block->h1.block_status & TP_STATUS_USER) == 0)
+                break;
+
+            user_blocks++;
+        }
+
+        fill = ((guint64) user_blocks * 1000) / block_amount;
+    }
+
+    priv->xg_user_blocks_max = MAX (priv->xg_user_blocks_max, user_blocks);
+
+    // The peak fill level is reset by the grabbing thread with every memread chunk, see "MEMREAD FLOW CONTROL".
+    fill_peak = g_atomic_int_get (&priv->xg_ring_fill_peak);
+    while (fill > fill_peak && !g_atomic_int_compare_and_exchange (&priv->xg_ring_fill_peak, fill_peak, fill))
+        fill_peak = g_atomic_int_get (&priv->xg_ring_fill_peak);
+
+    if (priv->xg_kernel_drops > 0 || priv->xg_losing_blocks > 0)
+        g_atomic_int_compare_and_exchange (&priv->xg_drop_state, 0, 1);
+}
+
+/**
+ * @brief Returns a human readable summary of the statistics of every 10G receive ring
+ *
+ * Besides the packets, bytes and blocks counted by the receiver threads, the kernel statistics of each socket are being
+ * reported, as they have been accumulated by "sample_ring_statistics".
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The summary starts with the amount of incomplete frames and missing bytes.
+ *
+ * Changed 17.10.2026
+ * The kernel statistics are not read here anymore, as that would reset the counters of the receiving thread.
+ *
+ * Changed 17.10.2026
+ * Renamed from "get_receive_statistics", which now calls this while holding "xg_backend_mutex".
+ *
+ * @param priv
+ * @return
+ */
+static gchar *
+format_receive_statistics (UcaPhantomCameraPrivate *priv)
+{
+    struct fanout *fanout = priv->xg_fanout;
+    socklen_t length;
+    GString *string;
+
+    // 17.10.2026
+    // The frames, of which packets have been lost (see "receive_ximg_packet"), are counted independent of the backend
+    string = g_string_new ("");
+    g_string_append_printf (string, "%" G_GUINT64_FORMAT " incomplete frames, %" G_GUINT64_FORMAT " missing bytes; ",
+                            priv->xg_incomplete_frames, priv->xg_missing_total);
+
+    // 17.10.2026
+    // The replay backend only knows, how many packets it has read from the file
+    if (priv->xg_replay != NULL) {
+        struct replay *replay = priv->xg_replay;
+
+        g_string_append_printf (string,
+                                "replay: %" G_GUINT64_FORMAT " packets, %" G_GUINT64_FORMAT " bytes, "
+                                "%" G_GUINT64_FORMAT " skipped, %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT " bytes read",
+                                replay->packets, replay->bytes, replay->skipped, replay->offset, replay->size);
+
+        return g_string_free (string, FALSE);
+    }
+
+    // 17.10.2026
+    // The AF_XDP backend has its own kernel statistics
+    if (priv->xg_xdp != NULL) {
+        struct xdp_receiver *xdp = priv->xg_xdp;
+        struct xdp_statistics xdp_stats;
+
+        length = sizeof (xdp_stats);
+        memset (&xdp_stats, 0, sizeof (xdp_stats));
+        getsockopt (xdp->fd, SOL_XDP, XDP_STATISTICS, &xdp_stats, &length);
+
+        g_string_append_printf (string,
+                                "xdp queue %u (%s, %s): %" G_GUINT64_FORMAT " packets, %" G_GUINT64_FORMAT " bytes, "
+                                "%" G_GUINT64_FORMAT " skipped, %llu dropped, %llu rx ring full, "
+                                "%llu fill ring empty",
+                                xdp->queue_id, xdp->native ? "native" : "generic", xdp->zero_copy ? "zero copy" : "copy",
+                                xdp->packets, xdp->bytes, xdp->skipped, (unsigned long long) xdp_stats.rx_dropped,
+                                (unsigned long long) xdp_stats.rx_ring_full,
+                                (unsigned long long) xdp_stats.rx_fill_ring_empty_descs);
+        g_string_append_printf (string, ", %u rx descriptors pending at most", priv->xg_user_blocks_max);
+
+        return g_string_free (string, FALSE);
+    }
 
-    err = bind(fd, (struct sockaddr *) &ll, sizeof(ll));
-    if (err < 0) {
-        g_warning("Error binding the socket to the interface");
+    if (fanout == NULL) {
+        if (priv->xg_fd > 0) {
+            g_string_append_printf (string,
+                                    "ring 0: %" G_GUINT64_FORMAT " packets, %" G_GUINT64_FORMAT " drops, "
+                                    "%" G_GUINT64_FORMAT " freezes, %" G_GUINT64_FORMAT " losing blocks, "
+                                    "%u user blocks at most",
+                                    priv->xg_kernel_packets, priv->xg_kernel_drops, priv->xg_kernel_freezes,
+                                    priv->xg_losing_blocks, priv->xg_user_blocks_max);
+        }
+
+        return g_string_free (string, FALSE);
     }
 
-    return fd;
+    for (guint i = 0; i < fanout->ring_amount; i++) {
+        struct fanout_ring *ring = &fanout->rings[i];
+
+        g_string_append_printf (string,
+                                "%sring %u: %" G_GUINT64_FORMAT " packets, %" G_GUINT64_FORMAT " bytes, "
+                                "%" G_GUINT64_FORMAT " blocks, %" G_GUINT64_FORMAT " skipped, "
+                                "%" G_GUINT64_FORMAT " kernel packets, %" G_GUINT64_FORMAT " drops, "
+                                "%" G_GUINT64_FORMAT " freezes, %" G_GUINT64_FORMAT " losing blocks",
+                                i > 0 ? "; " : "", i, ring->packets, ring->bytes, ring->blocks, ring->skipped,
+                                ring->kernel_packets, ring->kernel_drops, ring->kernel_freezes, ring->losing_blocks);
+    }
+
+    g_string_append_printf (string, "; %u user blocks at most", priv->xg_user_blocks_max);
+
+    return g_string_free (string, FALSE);
 }
 
 /**
- * @brief Porperly closing the used ring buffer and socket at the end of the program
+ * @brief Returns the summary of "format_receive_statistics", while the receive backend cannot be torn down
  *
- * @author Jonas Teufel
+ * CHANGELOG
  *
- * @param ring
- * @param fd
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
  */
-static void teardown_raw_socket(struct ring *ring, int fd) {
-
-    // The complete size of the ring
-    unsigned int ring_size = ring->req.tp_block_size * ring->req.tp_block_nr;
-    // This command will delete the memory mapping for the ring, for that it needs the pointer to the start of the
-    // memory map (ring->map) and the ring
-    munmap(ring->map, ring_size);
+static gchar *
+get_receive_statistics (UcaPhantomCameraPrivate *priv)
+{
+    gchar *statistics;
 
-    // During the setup phase, we dynamically allocated memory (array) to store the information for the starting points
-    // of the blocks inside the ring buffer. This allocated memory has to be free'ed
-    free(ring->rd);
+    g_mutex_lock (&priv->xg_backend_mutex);
+    statistics = format_receive_statistics (priv);
+    g_mutex_unlock (&priv->xg_backend_mutex);
 
-    // Closing the socket properly
-    close(fd);
+    return statistics;
 }
 
 unsigned int create_mask(int length) {
@@ -1542,244 +6379,559 @@ unsigned int process_carry(unsigned int carry_length, unsigned long *carry, unsi
 
 
 
+// ********************
+// MEMREAD FLOW CONTROL
+// ********************
+
+// 17.10.2026
+// The memread chunks used to have the fixed size MEMREAD_CHUNK_SIZE, which had been tuned by hand for a single ROI. Now
+// the first chunk of a readout is derived from the amount of frames the ring can hold, leaving RING_SAFETY_FACTOR as
+// headroom. After every chunk the size of the next one is adapted (additive increase, multiplicative decrease): If the
+// kernel dropped packets or blocks were lost during the last chunk, it is halved. If the ring was filled above
+// MEMREAD_FILL_HIGH, it is shrunk by a quarter and if it stayed below MEMREAD_FILL_LOW, it is grown by a quarter. A
+// chunk never gets larger than MEMREAD_FILL_HIGH of the ring, so that there is always room left when it is requested.
+// The fill levels are in per mille of the ring.
+// 17.10.2026
+// The next chunk is requested, while the previous one is still being transmitted: as soon as no more than the prefetch
+// watermark of its frames are left to be received. By default that is a quarter of the chunk, so the ring holds at most
+// the rest of the previous chunk and the whole next one, i.e. less than all of it. Otherwise the link would be idle for
+// the round trip of the request and the start up of the camera at every chunk.
+// 17.10.2026
+// Without a fixed chunk size the capacity of the ring does not depend on the chunk, the ring locks RING_MEMREAD_MEMORY
+// in memread mode (see "compute_ring_geometry"). So the first chunk really follows the ROI and the transfer format.
+#define MEMREAD_FILL_HIGH   750
+#define MEMREAD_FILL_LOW    500
+
 /**
- * @brief Unpacks the P10-encoded data data from a 10G transmitted image frame
+ * @brief Returns the amount of frames, which the 10G ring(s) of the running readout can hold at most
+ *
+ * The packets are assumed to have the full MTU. 0 is returned, if there is no ring, e.g. for the 1G interface.
  *
  * CHANGELOG
  *
- * Added 25.05.2019
+ * Added 17.10.2026
  *
- * Changed 11.06.2019
- * Now the memread index is being incremented at the end of the function
+ * @param priv
+ * @return
+ */
+static guint
+get_ring_frame_capacity (UcaPhantomCameraPrivate *priv)
+{
+    const struct ring_geometry *geometry = &priv->xg_geometry;
+    guint packet_size;
+    guint payload_size;
+    guint64 packet_amount;
+
+    if (!priv->enable_10ge || geometry->block_amount == 0)
+        return 0;
+
+    packet_size = TPACKET_ALIGN (TPACKET3_HDRLEN + ETH_HLEN + geometry->mtu);
+    payload_size = geometry->mtu + ETH_HLEN - XIMG_OVERHEAD;
+
+    // With the AF_XDP backend every packet takes up a frame of the UMEM, instead of a slot within a ring block.
+    if (priv->xg_xdp != NULL)
+        packet_amount = priv->xg_xdp->frame_amount;
+    else
+        packet_amount = (guint64) geometry->block_amount * (geometry->block_size / packet_size);
+
+    return MAX ((packet_amount * payload_size) / get_buffer_size (priv), 1);
+}
+
+/**
+ * @brief Chooses the size of the first memread chunk of a readout
  *
- * Changed 12.07.2019
- * Added comments
+ * A fixed "memread-chunk-size" is used as is. Otherwise the chunk is half of the frames, which fit into the ring of the
+ * running readout, whose size is given by the memory budget RING_MEMREAD_MEMORY or an explicit "ring-block-count".
+ * MEMREAD_CHUNK_SIZE is only used, if there is no ring (1G).
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
  *
  * @param priv
  */
-void unpack_image_p10(UcaPhantomCameraPrivate *priv) {
+static void
+memread_flow_setup (UcaPhantomCameraPrivate *priv)
+{
+    guint capacity = get_ring_frame_capacity (priv);
+
+    if (priv->memread_chunk_size > 0)
+        priv->xg_memread_chunk = priv->memread_chunk_size;
+    else if (capacity > 0)
+        priv->xg_memread_chunk = MAX (capacity / RING_SAFETY_FACTOR, 1);
+    else
+        priv->xg_memread_chunk = MEMREAD_CHUNK_SIZE;
+
+    priv->xg_memread_drops = priv->xg_kernel_drops + priv->xg_losing_blocks;
+    priv->memread_pending = 0;
+    g_atomic_int_set (&priv->xg_ring_fill_peak, 0);
+}
 
-    int new_length = 0;
-    int usable_length = 0;
-    int limit = 0;
-
-    int i,j;
-
-
-    priv->xg_buffer_index = 0;
-    priv->xg_unpack_index = 0;
-
-    __m128i vector, t0, t1, t2, t3, t4, t5, t6, t7, vector_out, k0, k1, k2, k3, k4, k5, k6;
-    __m128i temp;
-
-    // THE GENERAL IDEA
-    // The general way this unpacking works due to the weird way the SSE Vectors work is two steps:
-    // 1) Shuffle: Specific parts of the input vector are shuffled into a new position (especially new 8 bit units of
-    // the vector, in such a way, that the following shift operation does not transcend inter block separations. and
-    // then the new part-vectors are AND-masked so that they only contain the relevant bits.
-    // 2) Shift: All the part-vectors are shifted according to what their position demands and then they are combined
-    // by OR-ing them into a single output vector.
-
-    // THE SHUFFLE MASKS
-    // these masks shuffle parts of the input vector into new positions, while also reversing the unit switch within
-    // the two byte blocks, so this does not have to be dealt with when saving the vector into the output array again.
-    // We can see, that every vector shuffles the required bytes for two pixels. This is because due to the symmetric
-    // nature, the required shifts to be in the right position repeat after 4 pixels. So because 8 pixels are being
-    // processed there is a pair of 2 pixels each that require the same shift.
-    __m128i sm0 = _mm_setr_epi8(1, 0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 6, 5, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80);
-    __m128i sm1 = _mm_setr_epi8(0x80, 0x80, 2, 1, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 7, 6, 0x80, 0x80, 0x80, 0x80);
-    __m128i sm2 = _mm_setr_epi8(0x80, 0x80, 0x80, 0x80, 3, 2, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 8, 7, 0x80, 0x80);
-    __m128i sm3 = _mm_setr_epi8(0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 4, 3, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 9, 8);
-
-    // THE AND MASKS
-    // These masks will be applied after the shuffle masks. This is important because while the shuffle masks do indeed
-    // already get rid of most the irrelevant bits within all the other irrelevant 8 bit units, we can see, that 4
-    // 8 bit units, 32 bits in total are being persisted in total by the shuffle operation, but every part vector only
-    // contains 2 pixels, 20 bits of information, so the additional bits have to be cropped by the AND masking.
-    uint8_t mb0[16] = {0b11000000, 0b11111111, 0, 0, 0, 0, 0, 0, 0b11000000, 0b11111111, 0, 0, 0, 0, 0, 0};
-    uint8_t mb1[16] = {0, 0, 0b11110000, 0b00111111, 0, 0, 0, 0, 0, 0, 0b11110000, 0b00111111, 0, 0, 0, 0};
-    uint8_t mb2[16] = {0, 0, 0, 0, 0b11111100, 0b00001111, 0, 0, 0, 0, 0, 0, 0b11111100, 0b00001111, 0, 0};
-    uint8_t mb3[16] = {0, 0, 0, 0, 0, 0, 0b11111111, 0b00000011, 0, 0, 0, 0, 0, 0, 0b11111111, 0b00000011};
-    // This is the special mask that is applied to the whole input vector at the beginning, which will only let the
-    // 80 relevant bit stay
-    uint8_t maskb[16] = {0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0, 0, 0, 0, 0, 0};
-
-    __m128i mask2 = _mm_loadu_si128((__m128i*)&maskb);
-    __m128i m0 = _mm_loadu_si128((__m128i*)&mb0);
-    __m128i m1 = _mm_loadu_si128((__m128i*)&mb1);
-    __m128i m2 = _mm_loadu_si128((__m128i*)&mb2);
-    __m128i m3 = _mm_loadu_si128((__m128i*)&mb3);
-
-    uint16_t *buffer_pointer = priv->xg_buffer;
-
-    uint8_t *data_pointer = priv->xg_data_buffer.in;
-    uint16_t *output_pointer = priv->xg_buffer;
+/**
+ * @brief Returns the amount of requested frames, at or below which the next memread chunk is requested
+ *
+ * It is always less than the current chunk, so that a single chunk is requested ahead at most.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static guint
+get_memread_watermark (UcaPhantomCameraPrivate *priv)
+{
+    guint watermark = priv->memread_prefetch > 0 ? priv->memread_prefetch : priv->xg_memread_chunk / 4;
 
-    gsize pixel_count = priv->roi_width * priv->roi_height;
+    return MIN (watermark, priv->xg_memread_chunk - 1);
+}
 
-    int counter = 0;
+/**
+ * @brief Adapts the size of the next memread chunk to the fill level of the ring and the drops during the last one
+ *
+ * Has to be called right before the next chunk is requested, as it also resets the peak fill level.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ */
+static void
+memread_flow_adapt (UcaPhantomCameraPrivate *priv)
+{
+    guint capacity = get_ring_frame_capacity (priv);
+    guint chunk = priv->xg_memread_chunk;
+    guint64 drops = priv->xg_kernel_drops + priv->xg_losing_blocks;
+    gint fill = g_atomic_int_get (&priv->xg_ring_fill_peak);
 
-    g_debug("");
-    while (priv->xg_buffer_index < pixel_count) {
-        new_length = priv->xg_total - priv->xg_unpack_index;
-        usable_length = new_length - (new_length % 10);
-        limit = priv->xg_unpack_index + usable_length;
+    g_atomic_int_set (&priv->xg_ring_fill_peak, 0);
 
-        // This loop iterates through the raw data buffer und the output buffer (where the unpacked 16 bit pixel
-        // representations are being saved) at the same time.
-        // .
-        for (i = priv->xg_unpack_index, j = priv->xg_buffer_index; i<limit ; i+=10, j+=8) {
+    if (priv->memread_chunk_size > 0 || capacity == 0)
+        return;
 
-            // The "data_pointer" variable is a pointer, which points into array, where the raw data from the 10G image
-            // transfer is being buffered.
-            // To process it more effectively the data is loaded into a SSE 128 bit integer vector.
-            vector = _mm_loadu_si128((__m128i*)data_pointer);
+    if (drops > priv->xg_memread_drops)
+        chunk = chunk / 2;
+    else if (fill > MEMREAD_FILL_HIGH)
+        chunk = chunk - chunk / 4;
+    else if (fill < MEMREAD_FILL_LOW)
+        chunk = chunk + MAX (chunk / 4, 1);
 
-            // The P10 transfer format is a 10 bit format, which means that every 10 bit in the data array represent
-            // the information about one pixel. This format has to be unpacked into a 16 bit format, where each pixel
-            // is described by 16 bit.
-            // 128 bit of the 10 bit format have already been loaded into "vector", but we only want to process 80 bit
-            // of these, since these 8 pixels will be unpacked into 8x16=128 Bit output vector.
-            // Thus here the vector is being masked, so that only the 80 relevant bits stay.
-            vector = _mm_and_si128(vector, mask2);
+    chunk = MIN (chunk, ((guint64) capacity * MEMREAD_FILL_HIGH) / 1000);
+    priv->xg_memread_chunk = MAX (chunk, 1);
+    priv->xg_memread_drops = drops;
 
-            // The unpacking process starts with 80 consecutive bits within a 128 bit vector (where the rest besides
-            // the 80 bits is zeros) where each 10 bit block describes one pixel.
-            // The goal is to get a 128 bits of consecutive bits, where each 16 bit block describes one pixel. Example
-            // 111111 110000  --> 111100 111100.
+    g_debug ("Memread chunk of %u frames, ring filled up to %i per mille", priv->xg_memread_chunk, fill);
+}
 
-            t0 = _mm_and_si128(_mm_shuffle_epi8(vector, sm0), m0) >> 6;
-            t1 = _mm_and_si128(_mm_shuffle_epi8(vector, sm1), m1) >> 4;
-            t2 = _mm_and_si128(_mm_shuffle_epi8(vector, sm2), m2) >> 2;
-            t3 = _mm_and_si128(_mm_shuffle_epi8(vector, sm3), m3);
 
 
-            vector_out = _mm_or_si128(_mm_or_si128(t0, t1), _mm_or_si128(t2, t3));
+// *******************
+// PARALLEL DECODING
+// *******************
 
-            _mm_storeu_si128((__m128i*)output_pointer, vector_out);
+// 17.10.2026
+// A single unpack thread cannot keep up with large frames at high frame rates. With the "decode-threads" property the
+// 10G frames are split into stripes of DECODE_STRIPE_GROUPS groups of 8 pixels, which are unpacked by a pool of worker
+// threads together with the unpack thread. The stripes are handed out in the order of the data: whoever is free takes
+// the next stripe and waits until it has been received ("parser->total"), so the decoding still overlaps with the
+// reception. The unpack thread delivers the frame only after all stripes are finished.
+//
+// The state of the current frame is protected by the mutex of the pool, a stripe is taken while holding it. The
+// "generation" is increased for every frame, so that a worker, which has been late for the previous frame, cannot take
+// a stripe of the next one by accident. The pool is only used without zero copy decoding.
 
-            data_pointer += 10;
-            output_pointer += 8;
+// 2048 groups are 16384 pixels, about 20 KiB of P10 and 32 KiB of 16 bit output per stripe. Large enough, that taking
+// a stripe is cheap compared to unpacking it, and small enough for a 4 MP frame to be spread over 8 threads evenly.
+#define DECODE_STRIPE_GROUPS        2048
 
-            priv->xg_buffer_index += 8;
-            priv->xg_unpack_index += 10;
-        }
+struct decode_pool {
+    UcaPhantomCameraPrivate *priv;
+    GThread            **threads;
+    guint                thread_amount;
+    GMutex               mutex;
+    GCond                cond;
+    gboolean             stop;
+    // The frame, which is currently being decoded, protected by the mutex
+    guint                generation;
+    UnpackKernel         kernel;
+    gsize                group_size;
+    guint                stripe_amount;
+    guint                next_stripe;
+    // The stripes, which have been unpacked completely, written atomically
+    volatile gint        finished_stripes;
+    struct progress      finished;
+};
 
+/**
+ * @brief Unpacks a single stripe of the current frame, as soon as its data has been received
+ *
+ * The last stripe also unpacks the incomplete group at the end of the frame, if the amount of pixels is not a multiple
+ * of 8.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Spins and then sleeps on the progress of the receiving thread, instead of yielding in a loop.
+ *
+ * @param pool
+ * @param stripe
+ */
+static void
+decode_stripe (struct decode_pool *pool, guint stripe)
+{
+    UcaPhantomCameraPrivate *priv = pool->priv;
+    struct ximg_decoder *decoder = priv->xg_decoder;
+    gsize pixel_count = priv->roi_width * priv->roi_height;
+    gsize size = get_buffer_size (priv);
+    gsize first_group = (gsize) stripe * DECODE_STRIPE_GROUPS;
+    gsize groups = MIN (DECODE_STRIPE_GROUPS, pixel_count / UNPACK_GROUP_PIXELS - first_group);
+    gsize start = first_group * pool->group_size;
+    gsize end = stripe == pool->stripe_amount - 1 ? size : start + groups * pool->group_size;
+
+    wait_unpack_received (decoder, end);
+
+    unpack_pixels (priv, pool->kernel, decoder->in + start, decoder->out,
+                   first_group * UNPACK_GROUP_PIXELS, groups);
+
+    start += groups * pool->group_size;
+    if (start < end) {
+        unpack_tail (priv, pool->kernel, decoder->in + start, end - start, decoder->out,
+                     (first_group + groups) * UNPACK_GROUP_PIXELS,
+                     pixel_count - (first_group + groups) * UNPACK_GROUP_PIXELS);
     }
-    // For some reason it really does not work without this ???
-    g_debug("");
+}
 
-    // 11.06.2019
-    // Incrementing the memread unpack index, after the image has been received
-    priv->memread_unpack_index += 1;
+/**
+ * @brief The condition of "decode_pool_unpack", all stripes of the current frame have been unpacked
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param pool
+ * @return
+ */
+static gboolean
+has_finished_stripes (struct decode_pool *pool)
+{
+    return (guint) g_atomic_int_get (&pool->finished_stripes) >= pool->stripe_amount;
 }
 
 /**
+ * @brief Takes and unpacks stripes of the frame with the given @p generation, until there are none left
  *
  * CHANGELOG
  *
- * Added 14.07.2019
+ * Added 17.10.2026
  *
- * @param priv
+ * Changed 17.10.2026
+ * Wakes up the unpack thread, which is waiting for the stripes.
+ *
+ * @param pool
+ * @param generation
  */
-void unpack_image_p12l(UcaPhantomCameraPrivate *priv) {
-    int new_length = 0;
-    int usable_length = 0;
-    int limit = 0;
+static void
+decode_pool_work (struct decode_pool *pool, guint generation)
+{
+    guint stripe;
+
+    while (TRUE) {
+        g_mutex_lock (&pool->mutex);
+
+        if (pool->generation != generation || pool->next_stripe >= pool->stripe_amount) {
+            g_mutex_unlock (&pool->mutex);
+            return;
+        }
+
+        stripe = pool->next_stripe++;
+        g_mutex_unlock (&pool->mutex);
 
-    int i,j;
+        decode_stripe (pool, stripe);
+        g_atomic_int_inc (&pool->finished_stripes);
+        progress_signal (&pool->finished);
+    }
+}
+
+/**
+ * @brief The worker thread of the decode pool, which helps with every new frame
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param pool
+ * @return
+ */
+static gpointer
+decode_pool_thread (struct decode_pool *pool)
+{
+    guint generation = 0;
 
+    g_mutex_lock (&pool->mutex);
 
-    priv->xg_buffer_index = 0;
-    priv->xg_unpack_index = 0;
+    while (!pool->stop) {
+        if (pool->generation == generation) {
+            g_cond_wait (&pool->cond, &pool->mutex);
+            continue;
+        }
 
-    __m128i vector, t0, t1, t2, t3, t4, t5, t6, t7, vector_out, k0, k1, k2, k3, k4, k5, k6;
-    __m128i temp;
+        generation = pool->generation;
+        g_mutex_unlock (&pool->mutex);
+        decode_pool_work (pool, generation);
+        g_mutex_lock (&pool->mutex);
+    }
 
-    // THE GENERAL IDEA
-    // The general way this unpacking works due to the weird way the SSE Vectors work is two steps:
-    // 1) Shuffle: Specific parts of the input vector are shuffled into a new position (especially new 8 bit units of
-    // the vector, in such a way, that the following shift operation does not transcend inter block separations. and
-    // then the new part-vectors are AND-masked so that they only contain the relevant bits.
-    // 2) Shift: All the part-vectors are shifted according to what their position demands and then they are combined
-    // by OR-ing them into a single output vector.
+    g_mutex_unlock (&pool->mutex);
+    return NULL;
+}
 
-    // THE SHUFFLE MASKS
-    __m128i sm0 = _mm_setr_epi8(1, 0, 0x80, 0x80, 4, 3, 0x80, 0x80, 7, 6, 0x80, 0x80, 10, 9, 0x80, 0x80);
-    __m128i sm1 = _mm_setr_epi8(0x80, 0x80, 2, 1, 0x80, 0x80, 5, 4, 0x80, 0x80, 8, 7, 0x80, 0x80, 11, 10);
+/**
+ * @brief Starts the worker threads of a decode pool
+ *
+ * The unpack thread decodes as well, so @p thread_amount is one less than the "decode-threads" property.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @param thread_amount
+ * @return
+ */
+static struct decode_pool *
+decode_pool_setup (UcaPhantomCameraPrivate *priv, guint thread_amount)
+{
+    struct decode_pool *pool;
 
-    // THE AND MASKS
-    uint8_t mb0[16] = {0b11110000, 0b11111111, 0, 0, 0b11110000, 0b11111111, 0, 0, 0b11110000, 0b11111111, 0, 0, 0b11110000, 0b11111111, 0, 0};
-    uint8_t mb1[16] = {0, 0, 0b11111111, 0b00001111, 0, 0,  0b11111111, 0b00001111, 0, 0,  0b11111111, 0b00001111, 0, 0,  0b11111111, 0b00001111,};
+    pool = g_new0 (struct decode_pool, 1);
+    pool->priv = priv;
+    pool->thread_amount = thread_amount;
+    pool->threads = g_new0 (GThread *, thread_amount);
+    g_mutex_init (&pool->mutex);
+    g_cond_init (&pool->cond);
 
-    uint8_t maskb[16] = {0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0, 0, 0, 0};
+    for (guint i = 0; i < thread_amount; i++)
+        pool->threads[i] = g_thread_new ("ximg-decode", (GThreadFunc) decode_pool_thread, pool);
 
-    __m128i mask2 = _mm_loadu_si128((__m128i*)&maskb);
-    __m128i m0 = _mm_loadu_si128((__m128i*)&mb0);
-    __m128i m1 = _mm_loadu_si128((__m128i*)&mb1);
+    return pool;
+}
 
-    uint16_t *buffer_pointer = priv->xg_buffer;
+/**
+ * @brief Stops the worker threads of the decode pool and frees it
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param pool
+ */
+static void
+decode_pool_teardown (struct decode_pool *pool)
+{
+    g_mutex_lock (&pool->mutex);
+    pool->stop = TRUE;
+    g_cond_broadcast (&pool->cond);
+    g_mutex_unlock (&pool->mutex);
+
+    for (guint i = 0; i < pool->thread_amount; i++)
+        g_thread_join (pool->threads[i]);
+
+    g_mutex_clear (&pool->mutex);
+    g_cond_clear (&pool->cond);
+    g_free (pool->threads);
+    g_free (pool);
+}
 
-    uint8_t *data_pointer = priv->xg_data_buffer.in;
-    uint16_t *output_pointer = priv->xg_buffer;
+/**
+ * @brief Unpacks the current 10G frame with all the threads of the pool, while it is being received
+ *
+ * Returns after all stripes of the frame have been unpacked.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Spins and then sleeps until the stripes are finished, instead of yielding in a loop.
+ *
+ * @param pool
+ * @param kernel
+ * @param group_size
+ */
+static void
+decode_pool_unpack (struct decode_pool *pool, UnpackKernel kernel, gsize group_size)
+{
+    UcaPhantomCameraPrivate *priv = pool->priv;
+    gsize groups = priv->roi_width * priv->roi_height / UNPACK_GROUP_PIXELS;
+    guint generation;
+
+    g_mutex_lock (&pool->mutex);
+    generation = ++pool->generation;
+    pool->kernel = kernel;
+    pool->group_size = group_size;
+    pool->stripe_amount = MAX (1, (groups + DECODE_STRIPE_GROUPS - 1) / DECODE_STRIPE_GROUPS);
+    pool->next_stripe = 0;
+    g_atomic_int_set (&pool->finished_stripes, 0);
+    g_cond_broadcast (&pool->cond);
+    g_mutex_unlock (&pool->mutex);
+
+    decode_pool_work (pool, generation);
+
+    progress_wait (&pool->finished, pool->priv->wait_spin_time, (ProgressCondition) has_finished_stripes, pool);
+}
 
+/**
+ * @brief Unpacks the raw data of the current 10G frame with the given kernel, while it is being received
+ *
+ * The receiving thread appends the data to "decoder->in" and increases "parser->total". Every time there are new
+ * complete groups of 8 pixels, these are unpacked into "decoder->out", until all pixels of the frame are unpacked.
+ * If the amount of pixels is not a multiple of 8, the last incomplete group is unpacked after the whole frame has been
+ * received.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * The pixels are corrected as well, if enabled.
+ *
+ * Changed 17.10.2026
+ * With more than one decode thread, the frame is unpacked by the decode pool.
+ *
+ * Changed 17.10.2026
+ * The received byte count is read with "get_unpack_received", since the receiving thread may be ahead by a few frames.
+ *
+ * Changed 17.10.2026
+ * Waits for at least one more group with "wait_unpack_received", instead of spinning on the byte count.
+ *
+ * @param decoder
+ * @param kernel
+ * @param group_size The amount of bytes of 8 pixels in the transfer format
+ */
+static void
+unpack_image_groups (struct ximg_decoder *decoder, UnpackKernel kernel, gsize group_size)
+{
+    UcaPhantomCameraPrivate *priv = decoder->priv;
     gsize pixel_count = priv->roi_width * priv->roi_height;
+    gsize size = get_buffer_size (priv);
+    gsize received;
+    gsize groups;
 
-    int counter = 0;
-
-    g_debug("");
-    while (priv->xg_buffer_index < pixel_count) {
-        new_length = priv->xg_total - priv->xg_unpack_index;
-        usable_length = new_length - (new_length % 12);
-        limit = priv->xg_unpack_index + usable_length;
+    if (priv->xg_decode_pool != NULL) {
+        decode_pool_unpack (priv->xg_decode_pool, kernel, group_size);
+        return;
+    }
 
-        // This loop iterates through the raw data buffer und the output buffer (where the unpacked 16 bit pixel
-        // representations are being saved) at the same time.
-        // .
-        for (i = priv->xg_unpack_index, j = priv->xg_buffer_index; i<limit ; i+=12, j+=8) {
+    decoder->buffer_index = 0;
+    decoder->unpack_index = 0;
 
-            // The "data_pointer" variable is a pointer, which points into array, where the raw data from the 10G image
-            // transfer is being buffered.
-            // To process it more effectively the data is loaded into a SSE 128 bit integer vector.
-            vector = _mm_loadu_si128((__m128i*)data_pointer);
+    while (decoder->buffer_index < pixel_count) {
+        // "parser->total" is written by the receiving thread, after the data has been copied into the buffer. At least
+        // one more group (or the rest of the frame) is waited for.
+        received = wait_unpack_received (decoder, MIN (decoder->unpack_index + group_size, size));
+        groups = (received - decoder->unpack_index) / group_size;
 
-            // The P10 transfer format is a 10 bit format, which means that every 10 bit in the data array represent
-            // the information about one pixel. This format has to be unpacked into a 16 bit format, where each pixel
-            // is described by 16 bit.
-            // 128 bit of the 10 bit format have already been loaded into "vector", but we only want to process 80 bit
-            // of these, since these 8 pixels will be unpacked into 8x16=128 Bit output vector.
-            // Thus here the vector is being masked, so that only the 80 relevant bits stay.
-            vector = _mm_and_si128(vector, mask2);
+        if (groups == 0 && received == size && received > decoder->unpack_index) {
+            unpack_tail (priv, kernel, decoder->in + decoder->unpack_index,
+                         received - decoder->unpack_index, decoder->out, decoder->buffer_index,
+                         pixel_count - decoder->buffer_index);
+            break;
+        }
 
-            // The unpacking process starts with 80 consecutive bits within a 128 bit vector (where the rest besides
-            // the 80 bits is zeros) where each 10 bit block describes one pixel.
-            // The goal is to get a 128 bits of consecutive bits, where each 16 bit block describes one pixel. Example
-            // 111111 110000  --> 111100 111100.
+        if (groups == 0)
+            continue;
 
-            t0 = _mm_and_si128(_mm_shuffle_epi8(vector, sm0), m0) >> 4;
-            t1 = _mm_and_si128(_mm_shuffle_epi8(vector, sm1), m1);
+        unpack_pixels (priv, kernel, decoder->in + decoder->unpack_index, decoder->out,
+                       decoder->buffer_index, groups);
 
+        decoder->buffer_index += groups * UNPACK_GROUP_PIXELS;
+        decoder->unpack_index += groups * group_size;
+    }
+}
 
-            vector_out = _mm_or_si128(t0, t1);
+/**
+ * @brief Unpacks the P10-encoded data data from a 10G transmitted image frame
+ *
+ * CHANGELOG
+ *
+ * Added 25.05.2019
+ *
+ * Changed 11.06.2019
+ * Now the memread index is being incremented at the end of the function
+ *
+ * Changed 12.07.2019
+ * Added comments
+ *
+ * Changed 17.10.2026
+ * The actual unpacking is done by the P10 kernel selected by CPUID (SSSE3, AVX2, AVX-512 or scalar), see
+ * "UNPACKING KERNELS". The received byte count is read atomically, which makes the g_debug calls obsolete, that
+ * were needed before to keep the compiler from caching it.
+ *
+ * @param priv
+ */
+void unpack_image_p10(UcaPhantomCameraPrivate *priv) {
 
-            _mm_storeu_si128((__m128i*)output_pointer, vector_out);
+    unpack_image_groups (priv->xg_decoder, priv->xg_unpack->p10, 10);
 
-            data_pointer += 12;
-            output_pointer += 8;
+    // 11.06.2019
+    // Incrementing the memread unpack index, after the image has been received
+    priv->memread_unpack_index += 1;
+}
 
-            priv->xg_buffer_index += 8;
-            priv->xg_unpack_index += 12;
-        }
+/**
+ *
+ * CHANGELOG
+ *
+ * Added 14.07.2019
+ *
+ * Changed 17.10.2026
+ * The actual unpacking is done by the P12L kernel selected by CPUID, see "unpack_image_p10".
+ *
+ * @param priv
+ */
+void unpack_image_p12l(UcaPhantomCameraPrivate *priv) {
 
-    }
-    // For some reason it really does not work without this ???
-    g_debug("");
+    unpack_image_groups (priv->xg_decoder, priv->xg_unpack->p12l, 12);
 
     // 11.06.2019
     // Incrementing the memread unpack index, after the image has been received
     priv->memread_unpack_index += 1;
 }
 
+/**
+ * @brief Unpacks the P8 data of a 10G transmitted image frame
+ *
+ * With 8 bit output the received data already is the image, which is copied by "finalize_receiving_image". Then this
+ * only waits until the frame has been received completely.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * Waits with "wait_unpack_received" instead of spinning.
+ *
+ * @param priv
+ */
+static void
+unpack_image_p8 (UcaPhantomCameraPrivate *priv)
+{
+    // "parser->expected" is set by the receiving thread, which may not have started the frame yet
+    if (has_8bit_output (priv)) {
+        gsize size = get_buffer_size (priv);
+
+        wait_unpack_received (priv->xg_decoder, size);
+    } else {
+        unpack_image_groups (priv->xg_decoder, priv->xg_unpack->p8, 8);
+    }
+
+    priv->memread_unpack_index += 1;
+}
+
 
 /**
  *
@@ -1791,32 +6943,45 @@ void unpack_image_p12l(UcaPhantomCameraPrivate *priv) {
  * Added a switch statement which checks the used image format and according to the format different unpacking functions
  * are being called. At the moment the supported formats for 10G transfer are "P10" and "P12L"
  *
+ * Changed 17.10.2026
+ * Added "P8".
+ *
+ * Changed 17.10.2026
+ * Every frame is unpacked in its frame slot, the frames are counted.
+ *
+ * Changed 17.10.2026
+ * The messages and results are handed over by value, nothing is allocated per frame anymore.
+ *
+ * Changed 17.10.2026
+ * The result carries the lost bytes and the error of the reception, which are taken from the frame slot.
+ *
  * @param priv
  * @return
  */
 static gpointer
 unpack_ximg_data (UcaPhantomCameraPrivate *priv)
 {
-    Result *result;
-    gint fd;
+    struct ximg_decoder *decoder = priv->xg_decoder;
+    struct frame_slot *slot;
+    Result result;
     gboolean stop = FALSE;
 
-    result = g_new0(Result, 1);
-    result->type = RESULT_READY;
-    result->success = FALSE;
-
     while (!stop) {
-        InternalMessage *message;
+        InternalMessage message;
 
-        result = g_new0 (Result, 1);
-        message = g_async_queue_pop (priv->message_queue);
+        handoff_pop (priv->unpack_queue, &message);
 
-        switch (message->type) {
+        switch (message.type) {
             case MESSAGE_UNPACK_IMAGE:
                 
                 //g_warning("Init the unpacking");
                 // IMPLEMENT THE UNPACKING
-                priv->xg_unpack_index = 0;
+                decoder->unpack_index = 0;
+
+                // 17.10.2026
+                // The frames are unpacked in order, each one from and into its own frame slot
+                decoder->in = priv->xg_slots[decoder->unpack_frame % priv->xg_slot_amount].data;
+                decoder->out = priv->xg_slots[decoder->unpack_frame % priv->xg_slot_amount].image;
 
                 // 14.07.2019
                 // Added the switch case here. Because previously the default was the the P10 unpacking. Which was
@@ -1829,19 +6994,34 @@ unpack_ximg_data (UcaPhantomCameraPrivate *priv)
                     case IMAGE_FORMAT_P12L:
                         unpack_image_p12l(priv);
                         break;
+                    case IMAGE_FORMAT_P8:
+                        unpack_image_p8(priv);
+                        break;
                 }
 
-                result->type = RESULT_IMAGE;
-                result->success = TRUE;
+                // 17.10.2026
+                // The receiving thread may still be finishing the frame, after all of its bytes have been unpacked.
+                // Only then the lost bytes and the error of the reception are in the frame slot.
+                wait_unpack_finished (decoder);
+                slot = &priv->xg_slots[decoder->unpack_frame % priv->xg_slot_amount];
+                decoder->unpack_frame++;
+
+                memset (&result, 0, sizeof (result));
+                result.type = RESULT_IMAGE;
+                result.error = slot->error;
+                result.success = result.error == NULL;
+                result.missing = slot->missing;
+                result.expected = slot->expected;
+                slot->error = NULL;
 
                 // g_warning("ERROR: %s", result->error);
-                g_async_queue_push (priv->result_queue, result);
+                handoff_push (priv->result_queue, &result);
                 //g_warning("PUSHED RESULT ");
                 break;
 
+            // 17.10.2026
+            // Only the receiving thread gets these
             case MESSAGE_READ_IMAGE:
-                g_async_queue_push(priv->message_queue, message);
-
             case MESSAGE_READ_TIMESTAMP:
                 // Not implemented
                 break;
@@ -1867,6 +7047,9 @@ unpack_ximg_data (UcaPhantomCameraPrivate *priv)
  * Removed the hardcoded usage of the defined INTERFACE makro and instead using the interface string in the priv->iface
  * property to bind the socket now.
  *
+ * Changed 17.10.2026
+ * The messages and results are handed over by value, nothing is allocated per frame anymore.
+ *
  * @author Jonas Teufel
  *
  * @param priv
@@ -1876,22 +7059,85 @@ static gpointer
 accept_ximg_data (UcaPhantomCameraPrivate *priv)
 {
     //g_warning("START ACCEPTING");
-    Result *result;
+    struct ximg_parser *parser = priv->xg_parser;
+    Result result;
     gint fd;
     gboolean stop = FALSE;
 
     struct ifreq if_opts = {0,};
 
-    result = g_new0(Result, 1);
-    result->type = RESULT_READY;
-    result->success = FALSE;
+    memset (&result, 0, sizeof (result));
+    result.type = RESULT_READY;
+    result.success = FALSE;
 
     struct ring ring;
     struct pollfd poll_fd;
+    struct fanout *fanout = NULL;
+    struct xdp_receiver *xdp = NULL;
+    struct replay *replay = NULL;
+    guint8 source_mac[6];
+    gboolean has_source_mac;
+
+    // This function completely configures the raw socket to be used.
+    // 17.10.2026
+    // With more than one receive thread, the rings of a PACKET_FANOUT group are created instead. The MAC address can
+    // then be taken from the socket of any of these rings.
+    // 17.10.2026
+    // The geometry of the ring(s) is computed from the current configuration and kept, so that it can be read back.
+    // 17.10.2026
+    // Only the packets coming from the camera are accepted by the sockets. If its MAC address cannot be determined,
+    // only the ethertype is checked.
+    memset(&ring, 0, sizeof(ring));
+    compute_ring_geometry(priv, &priv->xg_geometry);
+    has_source_mac = get_ximg_source_mac(priv, source_mac);
+    if (!has_source_mac)
+        g_debug("MAC address of the camera unknown, accepting ximg packets from any source");
+
+    // 17.10.2026
+    // With the AF_XDP backend a XDP socket is used instead of the packet mmap ring(s).
+    // 17.10.2026
+    // The replay backend does not use a socket at all, its ring buffer is read just like the single packet mmap ring.
+    if (priv->receive_backend == RECEIVE_BACKEND_REPLAY) {
+        replay = replay_setup(priv->ximg_capture_file, &priv->xg_geometry, &result.error);
+        fd = -1;
+        g_mutex_lock(&priv->xg_backend_mutex);
+        priv->xg_replay = replay;
+        g_mutex_unlock(&priv->xg_backend_mutex);
+    } else if (priv->receive_backend == RECEIVE_BACKEND_AF_XDP) {
+        xdp = xdp_setup(priv->iface, priv->xdp_queue, &priv->xg_geometry, has_source_mac ? source_mac : NULL,
+                        &result.error);
+        fd = xdp != NULL ? xdp->fd : -1;
+        g_mutex_lock(&priv->xg_backend_mutex);
+        priv->xg_xdp = xdp;
+        g_mutex_unlock(&priv->xg_backend_mutex);
+    } else if (priv->xg_geometry.ring_amount > 1) {
+        fanout = fanout_setup(priv->iface, &priv->xg_geometry, has_source_mac ? source_mac : NULL, &result.error);
+        fd = fanout != NULL ? fanout->rings[0].fd : -1;
+        g_mutex_lock(&priv->xg_backend_mutex);
+        priv->xg_fanout = fanout;
+        g_mutex_unlock(&priv->xg_backend_mutex);
+    } else {
+        fd = setup_raw_socket(&ring, priv->iface, &priv->xg_geometry, has_source_mac ? source_mac : NULL);
+        priv->xg_fd = fd;
+    }
+
+    // 17.10.2026
+    // Without a receive backend there is nothing to wait for. The error is handed over with the READY result and the
+    // thread ends right away, "start_readout" tears down the rest of the readout then.
+    if (result.error != NULL) {
+        priv->xg_geometry.block_amount = 0;
+        handoff_push (priv->result_queue, &result);
+        return NULL;
+    }
 
-    // This function completely configures the raw socket to be used.
-    memset(&ring, 0, sizeof(ring));
-    fd = setup_raw_socket(&ring, priv->iface);
+    // 17.10.2026
+    // Capturing the received blocks is only possible with the single packet mmap ring
+    if (priv->receive_backend == RECEIVE_BACKEND_PACKET_MMAP && priv->ximg_capture_file[0] != '\0') {
+        if (fanout != NULL)
+            g_warning("Capturing the 10G packets is not supported with more than one receive thread");
+        else if ((priv->xg_capture = capture_open(priv->ximg_capture_file)) == NULL)
+            g_warning("Could not create the capture file %s: %s", priv->ximg_capture_file, g_strerror(errno));
+    }
 
     memset(&poll_fd, 0, sizeof(poll_fd));
     poll_fd.fd      = fd;
@@ -1900,8 +7146,10 @@ accept_ximg_data (UcaPhantomCameraPrivate *priv)
 
     // The ximg command to send to the phantom needs the MAC address of the ethernet interface to send to (the one this
     // program is using) as a parameter. So we are getting this here.
-    strncpy (if_opts.ifr_name, priv->iface, strlen (priv->iface));
-    ioctl (fd, SIOCGIFHWADDR, &if_opts);
+    if (fd >= 0) {
+        strncpy (if_opts.ifr_name, priv->iface, strlen (priv->iface));
+        ioctl (fd, SIOCGIFHWADDR, &if_opts);
+    }
 
     priv->mac_address[0] = if_opts.ifr_hwaddr.sa_data[0];
     priv->mac_address[1] = if_opts.ifr_hwaddr.sa_data[1];
@@ -1910,29 +7158,71 @@ accept_ximg_data (UcaPhantomCameraPrivate *priv)
     priv->mac_address[4] = if_opts.ifr_hwaddr.sa_data[4];
     priv->mac_address[5] = if_opts.ifr_hwaddr.sa_data[5];
     
-    result->success = TRUE;
-    g_async_queue_push (priv->result_queue, result);
+    result.success = result.error == NULL;
+    handoff_push (priv->result_queue, &result);
 
     //g_warning("10G setup complete");
 
-    priv->xg_packet_index = 0;
-    priv->xg_block_index = 0;
-    priv->xg_block_finished = TRUE;
+    parser->packet_index = 0;
+    parser->block_index = 0;
+    parser->block_finished = TRUE;
+    parser->max_payload = 0;
+    parser->offset_trusted = FALSE;
+    parser->offset_matches = 0;
+    priv->xg_incomplete_frames = 0;
+    priv->xg_missing_total = 0;
+    priv->xg_kernel_packets = 0;
+    priv->xg_kernel_drops = 0;
+    priv->xg_kernel_freezes = 0;
+    priv->xg_losing_blocks = 0;
+    priv->xg_user_blocks_max = 0;
+    g_atomic_int_set(&priv->xg_drop_state, 0);
 
     while (!stop) {
-        InternalMessage *message;
+        InternalMessage message;
 
-        result = g_new0 (Result, 1);
-        message = g_async_queue_pop (priv->message_queue);
+        memset (&result, 0, sizeof (result));
+        handoff_pop (priv->message_queue, &message);
 
-        switch (message->type) {
+        switch (message.type) {
             case MESSAGE_READ_IMAGE:
                 
                 //g_warning("Receiving the actual image");
                 // Here we are calling the function, which actually uses the socket to receive the image piece by piece
                 // The actual image will be saved in the buffer of the camra object's "priv" internal buffer
                 // "priv->buffer".
-                read_ximg_data(priv, fd, &ring, &poll_fd, &result->error);
+                // 17.10.2026
+                // With zero copy decoding there is no unpack thread involved. The packets are decoded into the buffer,
+                // which has been passed with the message, while they are being read. Thus this thread also has to
+                // publish the result.
+                if (priv->xg_zero_copy)
+                    start_ximg_decoding(parser, message.data);
+
+                if (xdp != NULL)
+                    read_ximg_data_xdp(priv, xdp, &result.error);
+                else if (fanout != NULL)
+                    read_ximg_data_fanout(priv, fanout, &result.error);
+                else if (replay != NULL)
+                    read_ximg_data(priv, &replay->ring, &poll_fd, &result.error);
+                else
+                    read_ximg_data(priv, &ring, &poll_fd, &result.error);
+
+                finish_ximg_frame(parser, &result.error);
+                sample_ring_statistics(priv, &ring, fanout, xdp);
+
+                if (priv->xg_capture != NULL)
+                    fflush(priv->xg_capture);
+
+                if (priv->xg_zero_copy) {
+                    finish_ximg_decoding(parser);
+                    priv->memread_unpack_index += 1;
+
+                    result.type = RESULT_IMAGE;
+                    result.success = result.error == NULL;
+                    result.missing = parser->missing;
+                    result.expected = parser->expected;
+                    handoff_push (priv->result_queue, &result);
+                }
 
                 // Once the image was completely received we push a new message, indicating that image reception was a
                 // success, into the queue, so that the main thread which is watching the queue can retrieve the image
@@ -1945,9 +7235,9 @@ accept_ximg_data (UcaPhantomCameraPrivate *priv)
                 //g_warning("PUSHED RESULT ");
                 break;
 
+            // 17.10.2026
+            // Only the unpack thread gets these
             case MESSAGE_UNPACK_IMAGE:
-                g_async_queue_push(priv->message_queue, message);
-
             case MESSAGE_READ_TIMESTAMP:
                 // Not implemented
                 break;
@@ -1961,7 +7251,45 @@ accept_ximg_data (UcaPhantomCameraPrivate *priv)
 
     // Closing socket connection and freeing dynamically allocated memory etc
     //g_warning("TEARING DOWN");
-    teardown_raw_socket(&ring, fd);
+    sample_ring_statistics(priv, &ring, fanout, xdp);
+
+    if (priv->xg_capture != NULL) {
+        fclose(priv->xg_capture);
+        priv->xg_capture = NULL;
+    }
+
+    if (replay != NULL) {
+        gchar *statistics = get_receive_statistics(priv);
+        g_debug("10G receive statistics: %s", statistics);
+        g_free(statistics);
+
+        g_mutex_lock(&priv->xg_backend_mutex);
+        priv->xg_replay = NULL;
+        g_mutex_unlock(&priv->xg_backend_mutex);
+        replay_teardown(replay);
+    } else if (xdp != NULL) {
+        gchar *statistics = get_receive_statistics(priv);
+        g_debug("10G receive statistics: %s", statistics);
+        g_free(statistics);
+
+        g_mutex_lock(&priv->xg_backend_mutex);
+        priv->xg_xdp = NULL;
+        g_mutex_unlock(&priv->xg_backend_mutex);
+        xdp_teardown(xdp);
+    } else if (fanout != NULL) {
+        gchar *statistics = get_receive_statistics(priv);
+        g_debug("10G receive statistics: %s", statistics);
+        g_free(statistics);
+
+        g_mutex_lock(&priv->xg_backend_mutex);
+        priv->xg_fanout = NULL;
+        g_mutex_unlock(&priv->xg_backend_mutex);
+        fanout_teardown(fanout);
+    } else if (ring.map != NULL) {
+        priv->xg_fd = -1;
+        teardown_raw_socket(&ring, fd);
+    }
+    priv->xg_geometry.block_amount = 0;
     return NULL;
 }
 
@@ -2066,15 +7394,15 @@ static void
 _accept_ximg_data (UcaPhantomCameraPrivate *priv)
 {
     //g_warning("ACCEPTING 10G DATA");
-    Result *result;
+    Result result;
     gint fd;
     gint sock_opt;
     struct ifreq if_opts = {0,};
     gboolean stop = FALSE;
 
-    result = g_new0 (Result, 1);
-    result->type = RESULT_READY;
-    result->success = FALSE;
+    memset (&result, 0, sizeof (result));
+    result.type = RESULT_READY;
+    result.success = FALSE;
 
     // Before htons was 0x88B7
     // htons(ETH_P_ALL) simply tells the socket, that it is supposed to receive all ethernet frames, regardless of what
@@ -2083,9 +7411,9 @@ _accept_ximg_data (UcaPhantomCameraPrivate *priv)
     fd = socket (PF_PACKET, SOCK_RAW, htons (ETH_P_ALL));
 
     if (fd == -1) {
-        g_set_error_literal (&result->error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+        g_set_error_literal (&result.error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
                              "Could not open raw socket");
-        g_async_queue_push (priv->result_queue, result);
+        handoff_push (priv->result_queue, &result);
         return;
     }
 
@@ -2104,47 +7432,47 @@ _accept_ximg_data (UcaPhantomCameraPrivate *priv)
     /* re-use socket */
     /* re-use socket */
     if (setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &sock_opt, sizeof (sock_opt)) == -1) {
-        g_set_error_literal (&result->error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+        g_set_error_literal (&result.error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
                              "Could not set socket mode to reuse");
-        g_async_queue_push (priv->result_queue, result);
+        handoff_push (priv->result_queue, &result);
         close (fd);
         return;
     }
 
     /* bind to device */
     if (setsockopt (fd, SOL_SOCKET, SO_BINDTODEVICE, priv->iface, strlen (priv->iface)) == -1) {
-        g_set_error (&result->error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+        g_set_error (&result.error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
                      "Could not bind socket to %s", priv->iface);
-        g_async_queue_push (priv->result_queue, result);
+        handoff_push (priv->result_queue, &result);
         close (fd);
         return;
     }
 
     g_warning ("Accepting raw ethernet frames ...");
-    result->success = TRUE;
-    g_async_queue_push (priv->result_queue, result);
+    result.success = TRUE;
+    handoff_push (priv->result_queue, &result);
 
     while (!stop) {
-        InternalMessage *message;
+        InternalMessage message;
 
-        result = g_new0 (Result, 1);
-        message = g_async_queue_pop (priv->message_queue);
+        memset (&result, 0, sizeof (result));
+        handoff_pop (priv->message_queue, &message);
 
-        switch (message->type) {
+        switch (message.type) {
             case MESSAGE_READ_IMAGE:
 
                 // Here we are calling the function, which actually uses the socket to receive the image piece by piece
                 // The actual image will be saved in the buffer of the camra object's "priv" internal buffer
                 // "priv->buffer".
-                _read_ximg_data (priv, fd, &result->error);
+                _read_ximg_data (priv, fd, &result.error);
 
                 // Once the image was completely received we push a new message, indicating that image reception was a
                 // success, into the queue, so that the main thread which is watching the queue can retrieve the image
                 // from the buffer.
-                result->type = RESULT_IMAGE;
-                result->success = TRUE;
+                result.type = RESULT_IMAGE;
+                result.success = TRUE;
                 // g_warning("ERROR: %s", result->error);
-                g_async_queue_push (priv->result_queue, result);
+                handoff_push (priv->result_queue, &result);
                 break;
 
             case MESSAGE_READ_TIMESTAMP:
@@ -2155,8 +7483,6 @@ _accept_ximg_data (UcaPhantomCameraPrivate *priv)
                 stop = TRUE;
                 break;
         }
-
-        g_free (message);
     }
 
     // At the end we properly close the socket.
@@ -2392,6 +7718,138 @@ prepare_trigger(UcaPhantomCameraPrivate *priv) {
     g_free(reply);
 }
 
+// **********************
+// WATCHING THE RECORDING
+// **********************
+
+// 17.10.2026
+// Waiting for the camera to record enough frames for a memread chunk used to query "c1.frcount" in a loop without any
+// pause, which floods the control connection while the camera is recording. The frame count and the state of the cine
+// are now queried through a watcher instead: A value is queried again at the earliest after "status-poll-interval"
+// microseconds, until then the last reply is reused. This also limits applications, which poll the "trigger-released"
+// property in a loop. While waiting for frames, the time until the missing frames have been recorded is predicted from
+// "defc.rate", as long as the frame count grows. If it does not (e.g. because the trigger has not arrived yet), the
+// interval between the queries is doubled every time, up to "status-poll-max-interval". The first query is sent right
+// away, so waiting for frames, which have been recorded already, adds no latency. A new recording resets the watcher.
+
+/**
+ * @brief Forgets the values of the watcher, so that the next ones are queried right away
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ */
+static void
+watch_reset (UcaPhantomCameraPrivate *priv)
+{
+    priv->watch_frames_time = 0;
+    priv->watch_released_time = 0;
+}
+
+/**
+ * @brief Returns the amount of frames recorded by the camera, queried at most once per poll interval
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static guint
+watch_recorded_frames (UcaPhantomCameraPrivate *priv)
+{
+    GValue value = G_VALUE_INIT;
+    gint64 now = g_get_monotonic_time ();
+
+    if (priv->watch_frames_time > 0 && now - priv->watch_frames_time < priv->status_poll_interval)
+        return priv->watch_frames;
+
+    g_value_init (&value, G_TYPE_UINT);
+    phantom_get (priv, phantom_lookup_by_id (PROP_RECORDED_FRAMES), &value);
+    priv->watch_frames = g_value_get_uint (&value);
+    priv->watch_frames_time = now;
+
+    return priv->watch_frames;
+}
+
+/**
+ * @brief Returns TRUE, when the cine has been stored, queried at most once per poll interval
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @return
+ */
+static gboolean
+watch_trigger_released (UcaPhantomCameraPrivate *priv)
+{
+    const gchar *request = "get c1.state\r\n";
+    gchar *reply;
+    gint64 now = g_get_monotonic_time ();
+
+    if (priv->watch_released_time > 0 && now - priv->watch_released_time < priv->status_poll_interval)
+        return priv->watch_released;
+
+    reply = phantom_talk (priv, request, NULL, 0, NULL);
+    if (reply == NULL)
+        return FALSE;
+
+    priv->watch_released = strstr (reply, "STR") != NULL;
+    priv->watch_released_time = now;
+    g_free (reply);
+
+    return priv->watch_released;
+}
+
+/**
+ * @brief Blocks until the camera has recorded at least the given amount of frames
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param priv
+ * @param amount
+ */
+static void
+watch_wait_frames (UcaPhantomCameraPrivate *priv, guint amount)
+{
+    GValue value = G_VALUE_INIT;
+    guint64 min_interval = priv->status_poll_interval;
+    guint64 max_interval = MAX (priv->status_poll_max_interval, priv->status_poll_interval);
+    guint64 backoff = MAX (min_interval, 1);
+    guint64 interval;
+    gfloat rate = -1.0f;
+    guint frames;
+    guint previous_frames = 0;
+
+    g_value_init (&value, G_TYPE_FLOAT);
+
+    for (frames = watch_recorded_frames (priv); frames < amount; frames = watch_recorded_frames (priv)) {
+        if (frames > previous_frames) {
+            // The frame rate is only queried, once it is actually needed, and then kept for the rest of the wait
+            if (rate < 0.0f) {
+                phantom_get (priv, phantom_lookup_by_id (PROP_FRAMES_PER_SECOND), &value);
+                rate = g_value_get_float (&value);
+            }
+
+            backoff = MAX (min_interval, 1);
+            interval = rate > 0.0f ? (guint64) ((amount - frames) / rate * G_USEC_PER_SEC) : backoff;
+        } else {
+            interval = backoff;
+            backoff = MIN (backoff * 2, max_interval);
+        }
+
+        previous_frames = frames;
+        g_usleep (CLAMP (interval, min_interval, max_interval));
+    }
+}
+
 // ******************************
 // ACQUISITION OF MULTIPLE FRAMES
 // ******************************
@@ -2427,6 +7885,9 @@ prepare_trigger(UcaPhantomCameraPrivate *priv) {
  * This method will simply send the "trig" command itself to the camera. If there is not currently a recording running
  * in the camera, then that is the problem of the user.
  *
+ * Changed 17.10.2026
+ * Resets the watcher of the recording, so that the frame count and the state of the new recording are queried.
+ *
  * @param camera
  * @param error
  */
@@ -2445,6 +7906,10 @@ uca_phantom_camera_trigger (UcaCamera *camera,
     reply = phantom_talk (priv, trigger_request, NULL, 0, error);
     g_free(reply);
 
+    // 17.10.2026
+    // The trigger starts a new recording, see "WATCHING THE RECORDING"
+    watch_reset(priv);
+
     g_return_if_fail (UCA_IS_PHANTOM_CAMERA (camera));
 }
 
@@ -2455,28 +7920,98 @@ uca_phantom_camera_trigger (UcaCamera *camera,
  *
  * Added 29.05.2019
  *
+ * Changed 17.10.2026
+ * The state is queried at most once per "status-poll-interval".
+ *
  * @param priv
  * @return
  */
 static gboolean
 check_trigger_status(UcaPhantomCameraPrivate *priv) {
-    const gchar *request = "get c1.state\r\n";
-    gchar *reply;
-    gboolean status;
-    // Actually sending the request to the camera and receiving its reply.
-    reply = phantom_talk (priv, request, NULL, 0, NULL);
-    if (strstr(reply, "STR") != NULL) {
-        status = TRUE;
-    } else {
-        status = FALSE;
-    }
-    return status;
+    // 17.10.2026
+    // The state is queried through the watcher, which limits the rate of the requests (see "WATCHING THE RECORDING")
+    return watch_trigger_released(priv);
 }
 
 // *********************************
 // STARTING AND STOPPING THE READOUT
 // *********************************
 
+// 17.10.2026
+// The streaming thread is started and stopped along with the recording. It grabs the same way "grab" does, thus it is
+// defined further below (see "STREAMING").
+static struct stream *stream_setup (UcaCamera *camera, gboolean transfer_async);
+static void stream_teardown (struct stream *stream);
+
+/**
+ * @brief Stops the threads of the readout and frees everything, which "uca_phantom_camera_start_readout" has set up
+ *
+ * This is used by "uca_phantom_camera_stop_readout" and, if the readout could not be started, by
+ * "uca_phantom_camera_start_readout" itself. The receiving thread may have exited on its own already, if its setup has
+ * failed. The message to stop it is then discarded along with everything else left in the queues.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ * Split off "uca_phantom_camera_stop_readout".
+ *
+ * @param priv
+ */
+static void
+readout_teardown (UcaPhantomCameraPrivate *priv)
+{
+    InternalMessage message = { .type = MESSAGE_STOP };
+
+    pipeline_teardown (priv);
+
+    /* stop accept thread */
+    if (priv->accept_thread != NULL)
+        handoff_push (priv->message_queue, &message);
+
+    // 17.10.2026
+    // Only the 10G unpack thread needs a message of its own. Otherwise it would be left in the queue and stop the accept
+    // thread of the next readout right away.
+    // 17.10.2026
+    // The message goes into the queue of the unpack thread.
+    if (priv->unpack_thread != NULL)
+        handoff_push (priv->unpack_queue, &message);
+
+    /* stop listener */
+    g_cancellable_cancel (priv->accept);
+    g_socket_listener_close (priv->listener);
+
+    if (priv->accept_thread != NULL) {
+        g_thread_join (priv->accept_thread);
+        g_thread_unref (priv->accept_thread);
+        priv->accept_thread = NULL;
+    }
+
+    // 17.10.2026
+    // With normal transmission there is no unpack thread, the image is unpacked by the accept thread
+    if (priv->unpack_thread != NULL) {
+        g_thread_join(priv->unpack_thread);
+        g_thread_unref(priv->unpack_thread);
+        priv->unpack_thread = NULL;
+    }
+
+    // No thread is left to take the messages, which have not been handled (e.g. by an accept thread, which has been
+    // cancelled before the camera connected), they must not stop the threads of the next readout.
+    handoff_clear (priv->message_queue);
+    handoff_clear (priv->unpack_queue);
+
+    // 17.10.2026
+    // The workers of the decode pool are idle, since the unpack thread has stopped
+    if (priv->xg_decode_pool != NULL) {
+        decode_pool_teardown (priv->xg_decode_pool);
+        priv->xg_decode_pool = NULL;
+    }
+
+    // 17.10.2026
+    // No thread is decoding anymore
+    stop_correction (priv);
+    frame_slots_teardown (priv);
+}
+
 /**
  * @brief This method starts the readout for the camera.
  *
@@ -2485,13 +8020,32 @@ check_trigger_status(UcaPhantomCameraPrivate *priv) {
  * CHANGELOG
  *
  * Added ??
+ *
+ * Changed 17.10.2026
+ * The zero copy mode is fixed for the duration of the readout here. In that mode the intermediate buffers for 10G are
+ * not allocated.
+ *
+ * Changed 17.10.2026
+ * The reference frames of the dark/flat correction are loaded here.
+ *
+ * Changed 17.10.2026
+ * The frame slots are allocated here, instead of the single intermediate buffers.
+ *
+ * Changed 17.10.2026
+ * The buffers are taken from the frame buffer pool instead of being allocated for every readout.
+ *
+ * Changed 17.10.2026
+ * The depth of the request pipeline is fixed here.
+ *
+ * Changed 17.10.2026
+ * If the readout cannot be started, the threads are stopped and everything set up so far is freed again.
  */
 static void
 uca_phantom_camera_start_readout (UcaCamera *camera,
                                   GError **error)
 {
     UcaPhantomCameraPrivate *priv;
-    Result *result;
+    Result result;
 
     priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
 
@@ -2505,59 +8059,104 @@ uca_phantom_camera_start_readout (UcaCamera *camera,
         return;
     }
 
-    g_free (priv->buffer);
-    priv->buffer = g_malloc0 (get_buffer_size (priv));
+    // 17.10.2026
+    // The replay backend cannot do anything without a capture file, there is no need to start the threads then.
+    if (priv->enable_10ge && priv->receive_backend == RECEIVE_BACKEND_REPLAY && priv->ximg_capture_file[0] == '\0') {
+        g_set_error_literal (error, UCA_CAMERA_ERROR, UCA_CAMERA_ERROR_DEVICE,
+                             "The replay backend needs a capture file to be given by \"ximg-capture-file\"");
+        return;
+    }
+
+    // 17.10.2026
+    // The buffers are taken from the frame buffer pool, which keeps them across the readouts
+    priv->xg_numa_node = priv->enable_10ge ? get_interface_numa_node (priv->iface) : -1;
+
+    if (priv->buffer != NULL)
+        buffer_pool_give (priv->buffer_pool, priv->buffer);
+
+    priv->buffer = buffer_pool_take (priv->buffer_pool, get_buffer_size (priv), priv->xg_numa_node);
     //priv->buffer = g_malloc0(9000000);
 
+    // 17.10.2026
+    // The correction stays the same for the whole readout, even if the reference frames are changed meanwhile
+    if (!start_correction (priv, error))
+        return;
+
     if (priv->enable_10ge) {
         // 06.04.2019
         // Using the 10G connection, the transfer format is being unpacked inside the actual receive loop (in-time
         // unpacking). The data is being unpacked into a uint16 buffer already for the actual pixel values. This buffer
         // needs to be init here with the resolution of the picture.
         //g_free(priv->xg_buffer);
-        priv->xg_buffer = g_malloc0(priv->roi_height * priv->roi_width * 4);
-        priv->xg_data_buffer.in = g_malloc(priv->roi_height * priv->roi_width * 4);
+        // 17.10.2026
+        // With zero copy decoding (P10, P12L and P8) neither of the intermediate buffers is needed.
+        // 17.10.2026
+        // Otherwise each of the frame slots has both of them.
+        priv->xg_zero_copy = priv->zero_copy && priv->format != IMAGE_FORMAT_P16;
+        frame_slots_setup (priv);
+        pipeline_setup (priv);
+
+        // 17.10.2026
+        // The unpack thread is one of the decode threads itself
+        if (!priv->xg_zero_copy && priv->decode_threads > 1)
+            priv->xg_decode_pool = decode_pool_setup (priv, priv->decode_threads - 1);
         
-        priv->accept_thread = g_thread_new (NULL, (GThreadFunc) accept_ximg_data, priv);
-        priv->unpack_thread = g_thread_new (NULL, (GThreadFunc) unpack_ximg_data, priv);
+        // 17.10.2026
+        // The threads are named, so that the CPU time of every stage can be told apart (top -H, perf, the benchmark)
+        priv->accept_thread = g_thread_new ("ximg-accept", (GThreadFunc) accept_ximg_data, priv);
+        priv->unpack_thread = g_thread_new ("ximg-unpack", (GThreadFunc) unpack_ximg_data, priv);
 
-        result = (Result *) g_async_queue_pop (priv->result_queue);
-        g_assert (result->type == RESULT_READY);
+        handoff_pop (priv->result_queue, &result);
+        g_assert (result.type == RESULT_READY);
 
-        if (result->error != NULL) {
-            g_propagate_error (error, result->error);
-            g_free (result);
+        if (result.error != NULL) {
+            g_propagate_error (error, result.error);
+            readout_teardown (priv);
             return;
         }
 
-        g_free (result);
-
         /* no startdata necessary for ximg */
     }
     else {
         gchar *reply;
-        g_warning("DATA CONNECTION STARTED");
         const gchar *request = "startdata {port:7116}\r\n";
 
+        frame_slots_setup (priv);
+        pipeline_setup (priv);
+
         /* set up listener */
-        g_socket_listener_add_inet_port (priv->listener, 7116, G_OBJECT (camera), error);
+        // 17.10.2026
+        // A new cancellable is needed for every readout, the one of the previous readout has been cancelled
+        if (priv->accept != NULL)
+            g_object_unref (priv->accept);
+
         priv->accept = g_cancellable_new ();
+
+        if (!g_socket_listener_add_inet_port (priv->listener, 7116, G_OBJECT (camera), error)) {
+            readout_teardown (priv);
+            return;
+        }
+
         priv->accept_thread = g_thread_new (NULL, (GThreadFunc) accept_img_data, priv);
 
         /* wait for listener to become ready */
-        result = (Result *) g_async_queue_pop (priv->result_queue);
-        g_assert (result->type == RESULT_READY);
+        handoff_pop (priv->result_queue, &result);
+        g_assert (result.type == RESULT_READY);
 
-        if (result->error != NULL) {
-            g_propagate_error (error, result->error);
-            g_free (result);
+        if (result.error != NULL) {
+            g_propagate_error (error, result.error);
+            readout_teardown (priv);
             return;
         }
 
-        g_free (result);
-
         /* send startdata command */
         reply = phantom_talk (priv, request, NULL, 0, error);
+
+        if (reply == NULL) {
+            readout_teardown (priv);
+            return;
+        }
+
         g_free (reply);
     }
     g_return_if_fail (UCA_IS_PHANTOM_CAMERA (camera));
@@ -2568,31 +8167,32 @@ uca_phantom_camera_stop_readout (UcaCamera *camera,
                                  GError **error)
 {
     UcaPhantomCameraPrivate *priv;
-    InternalMessage *message;
 
     priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
 
-    /* stop accept thread */
-    message = g_new0 (InternalMessage, 1);
-    message->type = MESSAGE_STOP;
-    g_async_queue_push (priv->message_queue, message);
-    message = g_new0 (InternalMessage, 1);
-    message->type = MESSAGE_STOP;
-    g_async_queue_push (priv->message_queue, message);
+    // 17.10.2026
+    // The frames, which have been received ahead in memread mode, are discarded. They have been requested from the
+    // camera already, so the threads are waiting for them anyway.
+    // 17.10.2026
+    // The same goes for the pipelined live frames.
+    while (priv->xg_frames_in_flight > 0) {
+        Result result;
 
-    /* stop listener */
-    g_cancellable_cancel (priv->accept);
-    g_socket_listener_close (priv->listener);
+        handoff_pop (priv->result_queue, &result);
 
-    g_thread_join (priv->accept_thread);
-    g_thread_unref (priv->accept_thread);
+        if (result.error != NULL)
+            g_error_free (result.error);
+
+        priv->xg_frames_in_flight--;
+    }
 
-    g_thread_join(priv->unpack_thread);
-    g_thread_unref(priv->unpack_thread);
-    
     //g_free(priv->xg_data_buffer.in);
     //g_free(priv->xg_buffer);
 
+    // 17.10.2026
+    // The threads are stopped and the buffers freed the same way, when starting the readout fails
+    readout_teardown (priv);
+
     g_return_if_fail (UCA_IS_PHANTOM_CAMERA (camera));
 
 }
@@ -2627,6 +8227,14 @@ uca_phantom_camera_stop_readout (UcaCamera *camera,
  * invoked, which will send a "rec" command to the camera, which will tell the camera into which cine (internal memory
  * partition the frames are supposed to be saved into)
  *
+ * Changed 17.10.2026
+ * If the readout could not be started, the error is returned right away. The streaming thread is started at the end,
+ * if streaming is enabled. "transfer-asynchronously" without streaming is warned about, as the grab callback would
+ * never be called.
+ *
+ * Changed 17.10.2026
+ * Resets the watcher of the recording.
+ *
  * @param camera
  * @param error
  */
@@ -2635,17 +8243,28 @@ uca_phantom_camera_start_recording (UcaCamera *camera,
                                     GError **error)
 {
     UcaPhantomCameraPrivate *priv;
+    GError *tmp_error = NULL;
+    gboolean transfer_async;
     priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
 
     prepare_trigger(priv);
 
+    // 17.10.2026
+    // The frame count and the state of the previous recording are not valid anymore (see "WATCHING THE RECORDING")
+    watch_reset(priv);
+
     priv->memread_index = -1;
     // 06.11.2019
     // Getting the trigger source from the parent instance of the camera
     UcaCameraTriggerSource trigger_source;
     g_object_get(camera, "trigger-source", &trigger_source, NULL);
 
-    uca_phantom_camera_start_readout(camera, error);
+    uca_phantom_camera_start_readout(camera, &tmp_error);
+
+    if (tmp_error != NULL) {
+        g_propagate_error(error, tmp_error);
+        return;
+    }
 
     // 06.07.2019
     // Using the priv->externally_triggered deprecated
@@ -2665,13 +8284,32 @@ uca_phantom_camera_start_recording (UcaCamera *camera,
     if (trigger_source == UCA_CAMERA_TRIGGER_SOURCE_AUTO) {
         uca_phantom_camera_trigger(camera, error);
     }
+
+    // 17.10.2026
+    // The live frames are requested in the background from now on, see "STREAMING"
+    g_object_get(camera, "transfer-asynchronously", &transfer_async, NULL);
+
+    if (priv->enable_streaming && !priv->enable_memread)
+        priv->stream = stream_setup(camera, transfer_async);
+    else if (transfer_async)
+        g_warning ("The grab callback is only called with \"enable-streaming\" outside of memread mode");
 }
 
 static void
 uca_phantom_camera_stop_recording (UcaCamera *camera,
                                    GError **error)
 {
+    UcaPhantomCameraPrivate *priv;
+
     g_return_if_fail (UCA_IS_PHANTOM_CAMERA (camera));
+    priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
+
+    // 17.10.2026
+    // The streaming thread grabs from the readout, thus it is stopped first
+    if (priv->stream != NULL) {
+        stream_teardown(priv->stream);
+        priv->stream = NULL;
+    }
 
     // Stop the readout
     uca_phantom_camera_stop_readout(camera, error);
@@ -2689,55 +8327,6 @@ uca_phantom_camera_write (UcaCamera *camera,
 }
 
 
-static void
-unpack_p10 (guint16 *output,
-             const guint8 *input,
-             const guint num_pixels)
-{
-    guint i, j, h, k;
-
-    // guint16 current;
-
-    guint64 temp;
-
-    for (i = 0, j = 0; j < num_pixels; i += 5, j += 4) {
-
-        // Assemble the long number
-        temp = 0;
-        for (k = 0; k < 5; k++) {
-            temp |= input[i + k];
-            temp <<= 8;
-        }
-        temp >>= 8;
-
-        // Extract the bytes from that big number
-        for (h = 0; h < 4; h++) {
-            const guint16 current = (guint16) (temp & 0b1111111111);
-            temp >>= 10;
-            output[j + (3 - h)] = current;
-        }
-    }
-    // g_warning("i:%i j:%i", i, j);
-}
-
-
-static void
-unpack_p12l (guint16 *output,
-             const guint8 *input,
-             const guint num_pixels)
-{
-    guint i, j;
-
-    for (i = 0, j = 0; i < num_pixels; i += 2, j += 3) {
-        const guint16 tmp0 = (guint16) input[j + 0];
-        const guint16 tmp1 = (guint16) input[j + 1];
-        const guint16 tmp2 = (guint16) input[j + 2];
-
-        output[i + 0] = tmp0 << 4 | (tmp1 >> 4);
-        output[i + 1] = ((tmp1 & 0xF) << 8) | tmp2;
-    }
-}
-
 int a = 0;
 
 
@@ -2769,6 +8358,9 @@ int a = 0;
  * Added the "P12L" format to the switch case, so it can be used.
  * The P12L format can be used for 1G and 10G transmission. It is a 12 bit raw transfer format
  *
+ * Changed 17.10.2026
+ * Added the "P8" format.
+ *
  * @param priv
  * @param cine
  * @param frame_count
@@ -2813,6 +8405,10 @@ create_grab_request(UcaPhantomCameraPrivate *priv,
         case IMAGE_FORMAT_P12L:
             format = "P12L";
             break;
+        // 17.10.2026
+        case IMAGE_FORMAT_P8:
+            format = "P8";
+            break;
     }
 
     // The camera expects different commands, based on whether it is supposed to transfer over the "normal" ethernet
@@ -2849,32 +8445,45 @@ create_grab_request(UcaPhantomCameraPrivate *priv,
  *
  * Added 10.05.2019
  *
+ * Changed 17.10.2026
+ * The output buffer is passed along with the message to the receiving thread now, which needs it for zero copy
+ * decoding. In that case there is no need to start the unpack thread.
+ *
+ * Changed 17.10.2026
+ * The received byte count is not reset here, as the receiving thread may still be busy with a previous frame. The
+ * unpack thread tells the frames apart by their number (see "FRAME SLOTS"). The frames in flight are counted.
+ * The message for the unpack thread goes into its own queue.
+ *
+ * Changed 17.10.2026
+ * The messages are handed over by value.
+ *
  * @param priv
+ * @param data
  */
 static void
-start_receiving_image(UcaPhantomCameraPrivate *priv)
+start_receiving_image(UcaPhantomCameraPrivate *priv, gpointer data)
 {
     // The way the image reception works with the phantom camera is, that there is the main program execution, which
     // maintains a TCP connection with the camera. And over this connection the command requests and replys are send.
     // But for the transmission of a image a secondary channel is being opened. And this connection is being handled
     // in a separate thread. When receiving an image we need to tell these threads to initiate the data transmission
     // connections. This communication with the threads is being done using an async message queue
-    InternalMessage *message;
+    InternalMessage message;
+
+    priv->xg_frames_in_flight++;
 
     // This message tells the thread to start listening for new incoming data.
-    message = g_new0 (InternalMessage, 1);
-    //message->data = data;
-    message->type = MESSAGE_READ_IMAGE;
-    g_async_queue_push (priv->message_queue, message);
+    message.data = data;
+    message.type = MESSAGE_READ_IMAGE;
+    handoff_push (priv->message_queue, &message);
 
     // With 10G there is also a thread to read the data, but there is also yet ANOTHER thread, which decodes the
     // transfer format of the data as it is being received. And we need to tell this thread to start working too, but
     // of course only if 10G transfer is enabled.
-    if (priv->enable_10ge) {
-        message = g_new0 (InternalMessage, 1);
-        //message->data = data;
-        message->type = MESSAGE_UNPACK_IMAGE;
-        g_async_queue_push (priv->message_queue, message);
+    if (priv->enable_10ge && !priv->xg_zero_copy) {
+        message.data = NULL;
+        message.type = MESSAGE_UNPACK_IMAGE;
+        handoff_push (priv->unpack_queue, &message);
     }
 
 }
@@ -2892,32 +8501,75 @@ start_receiving_image(UcaPhantomCameraPrivate *priv)
  *
  * Added 10.05.2019
  *
+ * Changed 17.10.2026
+ * With zero copy decoding the image does not have to be copied anymore.
+ *
+ * Changed 17.10.2026
+ * If packets of a 10G frame have been lost, the image is still being delivered (with the missing parts set to zero),
+ * but the error UCA_PHANTOM_CAMERA_ERROR_MAYBE_CORRUPTED is set and FALSE is returned.
+ *
+ * Changed 17.10.2026
+ * With normal transmission the image is unpacked by "read_data" already, while it is being received.
+ *
+ * Changed 17.10.2026
+ * P8 images with 8 bit output are copied with one byte per pixel.
+ *
+ * Changed 17.10.2026
+ * Without zero copy decoding the image is copied from the frame slot of the oldest frame in flight.
+ *
+ * Changed 17.10.2026
+ * The result is handed over by value.
+ *
+ * Changed 17.10.2026
+ * While a frame is lent (see "uca_phantom_camera_lend_frame"), the buffer of the slot is swapped with @p data instead
+ * of copying the image.
+ *
+ * Changed 17.10.2026
+ * The lost bytes are taken from the result, instead of reading them from the receiving thread before it is done.
+ *
+ * Changed 17.10.2026
+ * Whether the frame is lent is decided by the caller with @p lent, instead of a flag shared by all the callers.
+ *
  * @param priv
  * @param data
+ * @param lent If not NULL, the buffer with the image is returned in it and @p data belongs to the camera afterwards.
+ *             Unless the image is in a frame slot, this is @p data itself.
  * @return
  */
 static gboolean
 finalize_receiving_image(UcaPhantomCameraPrivate *priv,
                             gpointer data,
+                            gpointer *lent,
                             GError **error)
 {
-    Result *result;
+    Result result;
     gboolean is_success;
+    struct frame_slot *slot = NULL;
 
     
     // This is a blocking call, which will wait until a new "result" has been put into the async queue by the worker
     // thread, which he will do, when the image transmission is finished.
-    result = g_async_queue_pop (priv->result_queue);
+    handoff_pop (priv->result_queue, &result);
+
+    if (lent != NULL)
+        *lent = data;
+
+    // 17.10.2026
+    // The results arrive in the order of the frames. Once this one has been copied out, its slot can be reused.
+    if (priv->xg_slots != NULL)
+        slot = &priv->xg_slots[priv->xg_delivered_frames % priv->xg_slot_amount];
+
+    priv->xg_frames_in_flight--;
+    priv->xg_delivered_frames++;
 
     // If the result is indeed an image and the transmission was a success, then the finalized image just needs to be
     // copied into the data buffer, thus returning it to whatever instance made the call to "grab" in the first place
-    g_assert (result->type == RESULT_IMAGE);
-    is_success = result->success;
+    g_assert (result.type == RESULT_IMAGE);
+    is_success = result.success;
 
     // In case it was no success, we propagate the error and return FALSE to indicate a transmission failure.
     if (!is_success) {
-        g_propagate_error (error, result->error);
-        g_free(result);
+        g_propagate_error (error, result.error);
         return FALSE;
     }
 
@@ -2925,22 +8577,96 @@ finalize_receiving_image(UcaPhantomCameraPrivate *priv,
     // normally or with 10G. Since in 10G there already is a separate unpack thread, that runs concurrent with the
     // reception, the contents of that threads buffer just have to be copied to the output buffer, but for normal
     // transmission there needs to be a decoding step based on what transfer format was used
-    if (priv->enable_10ge) {
-        // NOTE
-        // priv->xg_buffer contains the decoded image. priv->buffer contains the raw data
-        memcpy (data, priv->xg_buffer, priv->roi_width * priv->roi_height * 2);
-    } else {
-        switch (priv->format) {
-            case IMAGE_FORMAT_P10:
-                unpack_p10(data, priv->buffer, priv->roi_width * priv->roi_height);
-                break;
-            case IMAGE_FORMAT_P16:
-                memcpy (data, priv->buffer, priv->roi_width * priv->roi_height * 2);
-                break;
+    // 17.10.2026
+    // With zero copy decoding the image has already been decoded into the output buffer by the receiving thread. With
+    // normal transmission it has already been unpacked into the output buffer by "read_data".
+    if (priv->enable_10ge && !priv->xg_zero_copy) {
+        if (lent != NULL) {
+            // 17.10.2026
+            // Instead of copying the image, the buffer of the slot is lent and the buffer passed to "grab" takes its
+            // place in the slot. The slot is not used by any thread, until the next frame is started for it.
+            if (has_8bit_output (priv)) {
+                *lent = slot->data;
+                slot->data = data;
+            } else {
+                *lent = slot->image;
+                slot->image = data;
+            }
+        } else if (has_8bit_output (priv)) {
+            // 17.10.2026
+            // The received P8 data is the image already
+            memcpy (data, slot->data, priv->roi_width * priv->roi_height);
+        } else {
+            // NOTE
+            // priv->xg_buffer contains the decoded image. priv->buffer contains the raw data
+            // 17.10.2026
+            // With float output the decoded image has 4 bytes per pixel.
+            memcpy (data, slot->image, priv->roi_width * priv->roi_height * get_output_pixel_size (priv));
         }
     }
 
-    g_free(result);
+    // 17.10.2026
+    // The amount of missing bytes has been taken, after the receiving thread has finished the frame
+    if (priv->enable_10ge && result.missing > 0) {
+        g_set_error (error, UCA_PHANTOM_CAMERA_ERROR, UCA_PHANTOM_CAMERA_ERROR_MAYBE_CORRUPTED,
+                     "%" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT " bytes of the frame have been lost",
+                     result.missing, result.expected);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Starts receiving a live frame into @p target and requests it from the camera
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ * Split off "camera_grab_single", which calls it for every frame of the request pipeline.
+ *
+ * @param priv
+ * @param target
+ * @param error
+ * @return
+ */
+static gboolean
+request_live_frame (UcaPhantomCameraPrivate *priv,
+                    gpointer target,
+                    GError **error)
+{
+    // When using the camera in single frame mode, the grab command will issue the acquisition of the CURRENT frame,
+    // which means the image, the camera sees in just that moment. This is done by using the cine index -1.
+    // And obviously just a single image will be transmitted.
+    const gchar *cine = "-1";
+    const guint frame_count = 1;
+    const guint frame_start = 0;
+
+    gchar *request;
+    gchar *reply;
+
+    // Before we send the actual request to the camera, we need to tell the worker threads that actually receive the
+    // image to start working
+    start_receiving_image(priv, target);
+
+    // 17.10.2026
+    // With the replay backend the image data comes from the capture file, so the camera is not asked for it.
+    if (priv->enable_10ge && priv->receive_backend == RECEIVE_BACKEND_REPLAY)
+        return TRUE;
+
+    // Given the frame count and the cine source, this function will generate a request string for the camera, that is
+    // based on the configuration of the camera object (10G/1G, transfer format etc..).
+    // The final string will be put into the given request pointer.
+    request = create_grab_request(priv, cine, frame_start, frame_count);
+
+    // Sending the request to the camera. In case there is not reply we will return FALSE to indicate that the grab
+    // process was not successful. The reply content itself is not relevant. It is only important (just an "OK!")
+    reply = phantom_talk (priv, request, NULL, 0, error);
+    g_free (request);
+    if (reply == NULL)
+        return FALSE;
+    g_free (reply);
+
     return TRUE;
 }
 
@@ -2957,48 +8683,47 @@ finalize_receiving_image(UcaPhantomCameraPrivate *priv,
  *
  * Added 10.05.2019
  *
+ * Changed 17.10.2026
+ * Keeps "xg_pipeline_depth" live frames requested, see "REQUEST PIPELINING". The request itself is sent by
+ * "request_live_frame".
+ *
+ * Changed 17.10.2026
+ * Lends the frame, if @p lent is given (see "finalize_receiving_image").
+ *
  * @param priv
  * @param data
+ * @param lent
  * @param error
  * @return
  */
 static gboolean
 camera_grab_single (UcaPhantomCameraPrivate *priv,
                     gpointer data,
+                    gpointer *lent,
                     GError **error)
 {
-    // When using the camera in single frame mode, the grab command will issue the acquisition of the CURRENT frame,
-    // which means the image, the camera sees in just that moment. This is done by using the cine index -1.
-    // And obviously just a single image will be transmitted.
-    const gchar *cine = "-1";
-    const guint frame_count = 1;
-    const guint frame_start = 0;
-
-    gchar *request;
-    gchar *reply;
     gboolean is_success;
 
-    // Given the frame count and the cine source, this function will generate a request string for the camera, that is
-    // based on the configuration of the camera object (10G/1G, transfer format etc..).
-    // The final string will be put into the given request pointer.
-    request = create_grab_request(priv, cine, frame_start, frame_count);
-
-    // Before we send the actual request to the camera, we need to tell the worker threads that actually receive the
-    // image to start working
-    start_receiving_image(priv);
+    // 17.10.2026
+    // The first call of a readout requests as many frames as the pipeline is deep, every following one a single frame
+    // to replace the one it delivers. Without a pipeline this is exactly one frame, which is received into "data".
+    while (priv->xg_frames_in_flight < priv->xg_pipeline_depth) {
+        gpointer target = priv->xg_pipeline_buffered ? pipeline_push (priv) : data;
 
-    // Sending the request to the camera. In case there is not reply we will return FALSE to indicate that the grab
-    // process was not successful. The reply content itself is not relevant. It is only important (just an "OK!")
-    reply = phantom_talk (priv, request, NULL, 0, error);
-    g_free (request);
-    if (reply == NULL)
-        return FALSE;
-    g_free (reply);
+        if (!request_live_frame (priv, target, error))
+            return FALSE;
+    }
 
     // This function will wait (blocking call) until the worker thread has published its results into the internal
     // result queue and then decode the image based on the used image format before copying the results into the
     // return buffer "data"
-    is_success = finalize_receiving_image(priv, data, error);
+    // 17.10.2026
+    // The pipelined frames are not received into "data", they are delivered from the pipeline
+    is_success = finalize_receiving_image(priv, data, priv->xg_pipeline_buffered ? NULL : lent, error);
+
+    if (priv->xg_pipeline_buffered)
+        pipeline_pop (priv, data, lent);
+
     return is_success;
 }
 
@@ -3055,64 +8780,502 @@ get_memread_start(UcaPhantomCameraPrivate *priv) {
  * This method will block the program execution for as long as the count of recorded frames within the camera is not
  * sufficient to request another chunk of images.
  *
- * CHANGELOG
+ * CHANGELOG
+ *
+ * Added 05.11.2019
+ *
+ * Changed 06.11.2019
+ * Added a differentiation of cases for the edge case of the next request to be sent not being the full chunk size,
+ * but a few remaining frames instead. In such a case the program would hang, when waiting for the camera to suffice
+ * for the transmission of a full chunk.
+ *
+ * Changed 17.10.2026
+ * The size of the chunk is the adaptive one (see "MEMREAD FLOW CONTROL").
+ *
+ * Changed 17.10.2026
+ * Waits using the rate limited watcher of the recording instead of polling the frame count in a busy loop.
+ *
+ * @param priv
+ * @return
+ */
+static void
+wait_for_frames(UcaPhantomCameraPrivate *priv) {
+    // 06.11.2019
+    // Here we have to differentiate if the next request will request the full chunk size or if the remaining frames
+    // for a full transmission is smaller than the chunk size
+    guint request_size = MIN (priv->xg_memread_chunk, priv->memread_remaining);
+    // Waiting for as long as the recorded frames do not suffice for the request of one "chunk"
+    // 17.10.2026
+    // The frame count is not queried in a busy loop anymore, but by the watcher (see "WATCHING THE RECORDING")
+    watch_wait_frames(priv, request_size);
+}
+
+/**
+ * @brief memread mode: Reads out the cameras internal memory as configured with the camera object
+ *
+ * The configuration for the memread mode can be made by setting a value to the "memread_count" property of the camera
+ * object.
+ * The first call to the grab function will then send a command to the camera, which will cause it to send out a
+ * continuous stream of data, which contains exactly as many frames as specified. Each successive call to "grab" will
+ * not send another request, but simply receive and decode additional frames from that data stream.
+ *
+ * @author Jonas Teufel
+ *
+ * CHANGELOG
+ *
+ * Added 10.05.2019
+ *
+ * Changed 29.05.2019
+ *
+ * Changed 21.07.2019
+ * A negative memread_index now indicates the start of the readout for a new recording. In such a case the initial
+ * offset of the recording-frames within the cine of the camera is being calculated.
+ *
+ * Changed 05.11.2019
+ * Removed the call to the get_memread_start function, as it is not necessary to compute that.
+ *
+ * Changed 17.10.2026
+ * With more than one frame slot, the following frames of the chunk are received and decoded, while the current one is
+ * being delivered. The chunks are counted with "memread_pending" instead of the unpack index.
+ *
+ * Changed 17.10.2026
+ * The chunks do not have the fixed size MEMREAD_CHUNK_SIZE anymore, but are adapted to the ring (see
+ * "MEMREAD FLOW CONTROL").
+ *
+ * Changed 17.10.2026
+ * The next chunk is requested ahead, once the frames left of the previous ones reach the prefetch watermark.
+ * "memread_pending" now counts the requested frames of all chunks, which have not been started yet.
+ *
+ * Changed 17.10.2026
+ * Lends the frame, if @p lent is given (see "finalize_receiving_image").
+ *
+ * @param priv
+ * @param data
+ * @param lent
+ * @param error
+ * @return
+ */
+static gboolean
+camera_grab_memread (UcaPhantomCameraPrivate *priv,
+                     gpointer data,
+                     gpointer *lent,
+                     GError **error)
+{
+    // When using the camera in memread mode, the first grab command will send a request to the camera, that will
+    // prompt it to send multiple frames in succession (as many as the camera is configured for) and then successive
+    // calls to grab will not send any more requests to the camera, but just read all the received frames from the
+    // buffer.
+    const gchar *cine = "1";
+    guint frame_count;
+    guint request_index;
+
+    gchar *request;
+    gchar *reply;
+    gboolean is_success;
+
+    // 21.07.2019
+    // When the memread mode is enabled and this is the first "grab" call to a new readout then the memread index will
+    // have a negative number. A negative memread index indicates, that the readout for a new recording has begun.
+    // In this case the starting index offset for the first frame of the recording within the cine of the camera
+    // is being calculated by the "get_memread_start" function.
+    if (priv->memread_index == -1) {
+
+        // 05.11.2019
+        // It turns out the get memread start method is not necessary, as the internal index within the camera will
+        // always reference the first frame after the trigger with index 0
+        priv->memread_index = 0;
+
+        // 17.10.2026
+        // The size of the first chunk is derived from the ring of the running readout
+        memread_flow_setup(priv);
+    }
+
+    // 17.10.2026
+    // As many frames as there are frame slots are kept in flight. The first call starts that many, every following one
+    // starts a single frame to replace the one being delivered.
+    // 17.10.2026
+    // The next chunk is not requested only once every frame of the current one has been delivered anymore, but as soon
+    // as no more than the prefetch watermark of requested frames are left (see "MEMREAD FLOW CONTROL"). Thus it is sent
+    // while the camera is still transmitting and its frames follow the current chunk without a gap.
+    while (TRUE) {
+        if (priv->memread_remaining > 0 &&
+            priv->memread_pending + priv->xg_frames_in_flight <= get_memread_watermark(priv)) {
+            // 17.10.2026
+            // The frames requested so far are the ones of all previous chunks, the first frame of this chunk follows
+            // them. Every following chunk is adapted to how full the ring got during the previous one.
+            request_index = priv->memread_count - priv->memread_remaining;
+            if (request_index > 0)
+                memread_flow_adapt(priv);
+
+            // The frame count to be calculated is either the chunk size or the remaining amount, if the remaining
+            // amount is less than the chunk size. We also need to the update the remaining count afterwards
+            frame_count = MIN (priv->xg_memread_chunk, priv->memread_remaining);
+            priv->memread_remaining -= frame_count;
+
+            // 05.11.2019
+            // This function will block the program execution for as long as the amount of recorded frames within the
+            // camera is not sufficient to request another chunk
+            wait_for_frames(priv);
+
+            // Here we have to send a new request
+            // Given the frame count and the cine source, this function will generate a request string for the camera,
+            // that is based on the configuration of the camera object (10G/1G, transfer format etc..).
+            // The final string will be put into the given request pointer.
+            request = create_grab_request(priv, cine, request_index, frame_count);
+
+            // Sending the request to the camera. In case there is not reply we will return FALSE to indicate that the
+            // grab process was not successful. The reply content itself is not relevant. It is only important (just
+            // an "OK!")
+            // 17.10.2026
+            // With the replay backend the image data comes from the capture file, so the camera is not asked for it.
+            if (!(priv->enable_10ge && priv->receive_backend == RECEIVE_BACKEND_REPLAY)) {
+                reply = phantom_talk (priv, request, NULL, 0, error);
+
+                if (reply == NULL) {
+                    g_free (request);
+                    return FALSE;
+                }
+                g_free (reply);
+            }
+
+            g_free (request);
+
+            // After the request has been sent we set the flag to TRUE to prevent any more requests from being sent.
+            priv->memread_request_sent = TRUE;
+            priv->memread_pending += frame_count;
+        }
+
+        if (priv->memread_pending == 0 || priv->xg_frames_in_flight >= priv->xg_slot_amount)
+            break;
+
+        // Before we receive the image, we need to tell the worker threads that actually receive the image to start
+        // working
+        start_receiving_image(priv, data);
+        priv->memread_pending--;
+    }
+
+    // At the end of each memread grab, we increment the index to know at which position we are
+    priv->memread_index ++;
+
+    // 21.07.2019
+    // If this is the last grab call (unpack index has reached the specified count), then we obviously have to reset
+    // the memread index to a negative number to indicate for the next first grab call to recalculate the initial
+    // index offset.
+    // 17.10.2026
+    // The frames may be unpacked ahead of the grab calls, thus the memread index itself is compared.
+    if (priv->memread_index == priv->memread_count) {
+        priv->memread_index = -1;
+    }
+
+    // This function will wait (blocking call) until the worker thread has published its results into the internal
+    // result queue and then decode the image based on the used image format before copying the results into the
+    // return buffer "data"
+    is_success = finalize_receiving_image(priv, data, lent, error);
+    return is_success;
+
+}
+
+// *********
+// STREAMING
+// *********
+
+// 17.10.2026
+// With the "enable-streaming" property, the live frames are not requested by "grab" anymore. A streaming thread keeps
+// grabbing them in the background (the same way "camera_grab_single" does for "grab") and puts them into a frame
+// queue of "streaming-queue-length" frames. "grab" takes the oldest frame from the queue, so it only waits for the
+// camera, if the application is faster than the link. When the queue is full, "streaming-policy" decides whether the
+// oldest frame is dropped (the default, for a live view the newest frames matter) or the streaming thread waits.
+//
+// With "transfer-asynchronously" as well, there is no queue. Every frame is passed to the grab callback of libuca
+// (uca_camera_set_grab_func) right from the streaming thread. The streaming thread is only started with
+// "enable-streaming", nothing else calls the callback. Thus "transfer-asynchronously" alone has no effect, which
+// "start_recording" warns about. In memread mode there is no streaming.
+//
+// The frames are lent from the frame slots by the streaming thread (see "FRAME BUFFER POOL"), so a frame is copied
+// once at most, by "grab". "uca_phantom_camera_lend_frame" hands out the queued frames themselves.
+
+struct stream_frame {
+    gpointer             data;
+    GError              *error;
+};
+
+struct stream {
+    UcaCamera           *camera;
+    UcaPhantomCameraPrivate *priv;
+    UcaCameraGrabFunc    grab_func;
+    gpointer             user_data;
+    StreamingPolicy      policy;
+    GThread             *thread;
+    volatile gint        running;
+    // The queue and "finished" are protected by the mutex. "cond" is signalled, whenever a frame has been added or
+    // taken and when the streaming thread has finished.
+    GMutex               mutex;
+    GCond                cond;
+    struct stream_frame *frames;
+    guint                length;
+    guint                head;
+    guint                amount;
+    gboolean             finished;
+};
+
+/**
+ * @brief Emits the "packets-dropped" signal, if the receiving thread has flagged the first drop of the readout
+ *
+ * The receiving thread only flags the first drop, the signal is emitted in the thread, which grabs.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param camera
+ * @param priv
+ */
+static void
+emit_packets_dropped (UcaCamera *camera, UcaPhantomCameraPrivate *priv)
+{
+    if (g_atomic_int_compare_and_exchange (&priv->xg_drop_state, 1, 2))
+        g_signal_emit (camera, phantom_signals[SIGNAL_PACKETS_DROPPED], 0, priv->xg_kernel_drops);
+}
+
+/**
+ * @brief Puts a frame into the queue of the stream, applying the streaming policy if it is full
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param stream
+ * @param frame
+ */
+static void
+stream_push (struct stream *stream, struct stream_frame *frame)
+{
+    UcaPhantomCameraPrivate *priv = stream->priv;
+
+    g_mutex_lock (&stream->mutex);
+
+    while (stream->amount == stream->length && stream->policy == STREAMING_POLICY_BLOCK &&
+           g_atomic_int_get (&stream->running))
+        g_cond_wait (&stream->cond, &stream->mutex);
+
+    // With the block policy, the queue is only still full, if the stream is being stopped
+    if (stream->amount == stream->length) {
+        struct stream_frame *oldest = &stream->frames[stream->head];
+
+        if (oldest->data != NULL)
+            buffer_pool_give (priv->buffer_pool, oldest->data);
+
+        g_clear_error (&oldest->error);
+        stream->head = (stream->head + 1) % stream->length;
+        stream->amount--;
+        priv->streaming_dropped_frames++;
+    }
+
+    stream->frames[(stream->head + stream->amount) % stream->length] = *frame;
+    stream->amount++;
+    g_cond_broadcast (&stream->cond);
+    g_mutex_unlock (&stream->mutex);
+}
+
+/**
+ * @brief Takes the oldest frame from the queue of the stream, waiting for one if it is empty
+ *
+ * Like "grab", a possibly corrupted frame is returned along with the error UCA_PHANTOM_CAMERA_ERROR_MAYBE_CORRUPTED.
+ * Otherwise @p data is NULL, if FALSE is returned. Once the streaming thread has stopped because of an error and the
+ * queue is empty, the error UCA_PHANTOM_CAMERA_ERROR_NO_DATA is returned. The frame belongs to the caller and has to
+ * be given back to the frame buffer pool.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param stream
+ * @param data
+ * @param error
+ * @return
+ */
+static gboolean
+stream_take (struct stream *stream, gpointer *data, GError **error)
+{
+    struct stream_frame frame;
+
+    *data = NULL;
+
+    if (stream->grab_func != NULL) {
+        g_set_error_literal (error, UCA_PHANTOM_CAMERA_ERROR, UCA_PHANTOM_CAMERA_ERROR_NO_DATA,
+                             "The frames are passed to the grab callback with \"transfer-asynchronously\"");
+        return FALSE;
+    }
+
+    g_mutex_lock (&stream->mutex);
+
+    while (stream->amount == 0 && !stream->finished)
+        g_cond_wait (&stream->cond, &stream->mutex);
+
+    if (stream->amount == 0) {
+        g_mutex_unlock (&stream->mutex);
+        g_set_error_literal (error, UCA_PHANTOM_CAMERA_ERROR, UCA_PHANTOM_CAMERA_ERROR_NO_DATA,
+                             "Streaming has stopped, no more frames will arrive");
+        return FALSE;
+    }
+
+    frame = stream->frames[stream->head];
+    stream->head = (stream->head + 1) % stream->length;
+    stream->amount--;
+    g_cond_broadcast (&stream->cond);
+    g_mutex_unlock (&stream->mutex);
+
+    *data = frame.data;
+
+    if (frame.error != NULL) {
+        g_propagate_error (error, frame.error);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief The streaming thread, which grabs live frames until the stream is stopped
+ *
+ * If a frame does not arrive at all (as opposed to an incomplete one), the error is queued for "grab" and the thread
+ * stops. The camera or the connection are most likely gone then.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param stream
+ * @return
+ */
+static gpointer
+stream_frames (struct stream *stream)
+{
+    UcaPhantomCameraPrivate *priv = stream->priv;
+    struct stream_frame frame;
+    gsize size = get_frame_buffer_size (priv);
+    gboolean is_success;
+
+    while (g_atomic_int_get (&stream->running)) {
+        // Only this thread grabs while streaming, thus the frames are always lent from the frame slots
+        frame.error = NULL;
+        frame.data = buffer_pool_take (priv->buffer_pool, size, priv->xg_numa_node);
+        is_success = camera_grab_single (priv, frame.data, &frame.data, &frame.error);
+        emit_packets_dropped (stream->camera, priv);
+
+        if (!is_success &&
+            !g_error_matches (frame.error, UCA_PHANTOM_CAMERA_ERROR, UCA_PHANTOM_CAMERA_ERROR_MAYBE_CORRUPTED)) {
+            buffer_pool_give (priv->buffer_pool, frame.data);
+            frame.data = NULL;
+
+            if (stream->grab_func != NULL) {
+                g_warning ("Streaming has stopped: %s", frame.error->message);
+                g_error_free (frame.error);
+            } else {
+                stream_push (stream, &frame);
+            }
+
+            break;
+        }
+
+        if (stream->grab_func != NULL) {
+            // libuca's callback has no way to report a possibly corrupted frame, "packets-dropped" is emitted though.
+            // Like "grab", it gets float frames as 16 bit.
+            copy_frame (priv, frame.data, frame.data);
+            stream->grab_func (frame.data, stream->user_data);
+            buffer_pool_give (priv->buffer_pool, frame.data);
+            g_clear_error (&frame.error);
+        } else {
+            stream_push (stream, &frame);
+        }
+    }
+
+    g_mutex_lock (&stream->mutex);
+    stream->finished = TRUE;
+    g_cond_broadcast (&stream->cond);
+    g_mutex_unlock (&stream->mutex);
+    return NULL;
+}
+
+/**
+ * @brief Starts the streaming thread for a running readout
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param camera
+ * @param transfer_async Whether the frames are passed to the grab callback of @p camera instead of being queued
+ * @return
+ */
+static struct stream *
+stream_setup (UcaCamera *camera, gboolean transfer_async)
+{
+    UcaPhantomCameraPrivate *priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
+    struct stream *stream = g_new0 (struct stream, 1);
+
+    stream->camera = camera;
+    stream->priv = priv;
+    stream->grab_func = transfer_async ? camera->grab_func : NULL;
+    stream->user_data = camera->user_data;
+    stream->policy = priv->streaming_policy;
+    stream->length = priv->streaming_queue_length;
+    stream->frames = g_new0 (struct stream_frame, stream->length);
+    stream->running = 1;
+    g_mutex_init (&stream->mutex);
+    g_cond_init (&stream->cond);
+
+    priv->streaming_dropped_frames = 0;
+    stream->thread = g_thread_new ("phantom-stream", (GThreadFunc) stream_frames, stream);
+    return stream;
+}
+
+/**
+ * @brief Stops the streaming thread and gives the frames, which are left in the queue, back to the buffer pool
+ *
+ * The frame, which is being grabbed by the streaming thread, is still waited for.
  *
- * Added 05.11.2019
+ * CHANGELOG
  *
- * Changed 06.11.2019
- * Added a differentiation of cases for the edge case of the next request to be sent not being the full chunk size,
- * but a few remaining frames instead. In such a case the program would hang, when waiting for the camera to suffice
- * for the transmission of a full chunk.
+ * Added 17.10.2026
  *
- * @param priv
- * @return
+ * @param stream
  */
 static void
-wait_for_frames(UcaPhantomCameraPrivate *priv) {
-    // Setting up the requesting of a value from the phantom camera
-    UnitVariable *var;
-    guint recorded_frames_count = 0;
+stream_teardown (struct stream *stream)
+{
+    UcaPhantomCameraPrivate *priv = stream->priv;
 
-    GValue value = G_VALUE_INIT;
-    g_value_init(&value, G_TYPE_UINT);
+    g_atomic_int_set (&stream->running, 0);
 
-    // 06.11.2019
-    // Here we have to differentiate if the next request will request the full chunk size or if the remaining frames
-    // for a full transmission is smaller than the chunk size
-    guint request_size = (MEMREAD_CHUNK_SIZE < priv->memread_remaining) ?  MEMREAD_CHUNK_SIZE : priv->memread_remaining;
-    // Waiting for as long as the recorded frames do not suffice for the request of one "chunk"
-    while (recorded_frames_count < request_size) {
+    g_mutex_lock (&stream->mutex);
+    g_cond_broadcast (&stream->cond);
+    g_mutex_unlock (&stream->mutex);
+
+    g_thread_join (stream->thread);
 
-        // Getting the frame count
-        var = phantom_lookup_by_id (PROP_RECORDED_FRAMES);
-        phantom_get(priv, var, &value);
-        recorded_frames_count = g_value_get_uint(&value);
+    for (; stream->amount > 0; stream->amount--) {
+        struct stream_frame *frame = &stream->frames[stream->head];
+
+        if (frame->data != NULL)
+            buffer_pool_give (priv->buffer_pool, frame->data);
+
+        g_clear_error (&frame->error);
+        stream->head = (stream->head + 1) % stream->length;
     }
+
+    g_cond_clear (&stream->cond);
+    g_mutex_clear (&stream->mutex);
+    g_free (stream->frames);
+    g_free (stream);
 }
 
 /**
- * @brief memread mode: Reads out the cameras internal memory as configured with the camera object
- *
- * The configuration for the memread mode can be made by setting a value to the "memread_count" property of the camera
- * object.
- * The first call to the grab function will then send a command to the camera, which will cause it to send out a
- * continuous stream of data, which contains exactly as many frames as specified. Each successive call to "grab" will
- * not send another request, but simply receive and decode additional frames from that data stream.
- *
- * @author Jonas Teufel
+ * @brief Takes the next frame from the stream and copies it into @p data
  *
  * CHANGELOG
  *
- * Added 10.05.2019
- *
- * Changed 29.05.2019
- *
- * Changed 21.07.2019
- * A negative memread_index now indicates the start of the readout for a new recording. In such a case the initial
- * offset of the recording-frames within the cine of the camera is being calculated.
- *
- * Changed 05.11.2019
- * Removed the call to the get_memread_start function, as it is not necessary to compute that.
+ * Added 17.10.2026
  *
  * @param priv
  * @param data
@@ -3120,95 +9283,31 @@ wait_for_frames(UcaPhantomCameraPrivate *priv) {
  * @return
  */
 static gboolean
-camera_grab_memread (UcaPhantomCameraPrivate *priv,
-                     gpointer data,
-                     GError **error)
+stream_grab (UcaPhantomCameraPrivate *priv, gpointer data, GError **error)
 {
-    // When using the camera in memread mode, the first grab command will send a request to the camera, that will
-    // prompt it to send multiple frames in succession (as many as the camera is configured for) and then successive
-    // calls to grab will not send any more requests to the camera, but just read all the received frames from the
-    // buffer.
-    const gchar *cine = "1";
-    guint frame_count;
-
-    gchar *request;
-    gchar *reply;
+    gpointer frame;
     gboolean is_success;
 
-    // Before we send the actual request to the camera, we need to tell the worker threads that actually receive the
-    // image to start working
-    start_receiving_image(priv);
-
-    // 21.07.2019
-    // When the memread mode is enabled and this is the first "grab" call to a new readout then the memread index will
-    // have a negative number. A negative memread index indicates, that the readout for a new recording has begun.
-    // In this case the starting index offset for the first frame of the recording within the cine of the camera
-    // is being calculated by the "get_memread_start" function.
-    if (priv->memread_index == -1) {
-
-        // 05.11.2019
-        // It turns out the get memread start method is not necessary, as the internal index within the camera will
-        // always reference the first frame after the trigger with index 0
-        priv->memread_index = 0;
-    }
-
-    if (!priv->memread_request_sent || priv->memread_unpack_index % MEMREAD_CHUNK_SIZE == 0) {
-        // The frame count to be calculated is either the chunk size or the remaining amount, if the remaining amount
-        // is less than the chunk size. We also need to the update the remaining count afterwards
-        if (priv->memread_remaining < MEMREAD_CHUNK_SIZE) {
-            frame_count = priv->memread_remaining;
-            priv->memread_remaining = 0;
-        } else {
-            frame_count = MEMREAD_CHUNK_SIZE;
-            priv->memread_remaining -= MEMREAD_CHUNK_SIZE;
-        }
-
-        // 05.11.2019
-        // This function will block the program execution for as long as the amount of recorded frames within the
-        // camera is not sufficient to request another chunk
-        wait_for_frames(priv);
-
-        // Here we have to send a new request
-        // Given the frame count and the cine source, this function will generate a request string for the camera,
-        // that is based on the configuration of the camera object (10G/1G, transfer format etc..).
-        // The final string will be put into the given request pointer.
-        request = create_grab_request(priv, cine, priv->memread_index, frame_count);
-        //g_warning("REQUEST %s 10G %i", request, priv->enable_10ge);
-
-        // Sending the request to the camera. In case there is not reply we will return FALSE to indicate that the grab
-        // process was not successful. The reply content itself is not relevant. It is only important (just an "OK!")
-        reply = phantom_talk (priv, request, NULL, 0, error);
-        //g_warning("REPLY %s", reply);
-
-        g_free (request);
-        if (reply == NULL)
-            return FALSE;
-        g_free (reply);
-
-        // After the request has been sent we set the flag to TRUE to prevent any more requests from being sent.
-        priv->memread_request_sent = TRUE;
-    }
+    is_success = stream_take (priv->stream, &frame, error);
 
-
-    // At the end of each memread grab, we increment the index to know at which position we are
-    priv->memread_index ++;
-
-    // 21.07.2019
-    // If this is the last grab call (unpack index has reached the specified count), then we obviously have to reset
-    // the memread index to a negative number to indicate for the next first grab call to recalculate the initial
-    // index offset.
-    if (priv->memread_unpack_index == priv->memread_count) {
-        priv->memread_index = -1;
+    if (frame != NULL) {
+        copy_frame (priv, frame, data);
+        buffer_pool_give (priv->buffer_pool, frame);
     }
 
-    // This function will wait (blocking call) until the worker thread has published its results into the internal
-    // result queue and then decode the image based on the used image format before copying the results into the
-    // return buffer "data"
-    is_success = finalize_receiving_image(priv, data, error);
     return is_success;
-
 }
 
+// ****************************
+// GRABBING AND LENDING FRAMES
+// ****************************
+
+// 17.10.2026
+// "uca_phantom_camera_lend_frame" grabs through "uca_camera_grab", which does not know about lending. The variable,
+// which receives the lent buffer, is passed to "grab" through this thread local pointer, so that a caller can only ever
+// lend the frames, which it grabs itself.
+static GPrivate lend_target = G_PRIVATE_INIT (NULL);
+
 /**
  * @brief Sends the instruction to transmit an image to the phantom and receives the image in separate thread
  *
@@ -3228,6 +9327,20 @@ camera_grab_memread (UcaPhantomCameraPrivate *priv,
  * Introduced "memread" mode. If the according flag is set in the configuration of the camera object, successive calls
  * to the grab function will read out the internal memory of the camera instead of getting the current frame.
  *
+ * Changed 17.10.2026
+ * Emitting the "packets-dropped" signal after the first drop of the 10G reception. Also actually returning the result
+ * of the grab, which was missing.
+ *
+ * Changed 17.10.2026
+ * While streaming, the frame is taken from the frame queue of the streaming thread.
+ *
+ * Changed 17.10.2026
+ * Lends the frame, if called by "uca_phantom_camera_lend_frame" in the same thread.
+ *
+ * Changed 17.10.2026
+ * Float frames are grabbed into a buffer of the frame buffer pool and delivered as 16 bit (see "copy_frame"), as the
+ * buffer passed to "grab" is sized by "sensor-bitdepth".
+ *
  * @param camera
  * @param data
  * @param error
@@ -3239,13 +9352,130 @@ uca_phantom_camera_grab (UcaCamera *camera,
                          GError **error)
 {
     UcaPhantomCameraPrivate *priv;
+    gboolean is_success;
+    gpointer *lent;
+    gpointer frame = NULL;
+    priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
+    lent = g_private_get (&lend_target);
+
+    // 17.10.2026
+    // The float frame is lent to this function, the way "uca_phantom_camera_lend_frame" does it
+    if (priv->correction_float && lent == NULL && priv->stream == NULL) {
+        frame = buffer_pool_take (priv->buffer_pool, get_frame_buffer_size (priv), priv->xg_numa_node);
+        lent = &frame;
+    }
+
+    if (priv->stream != NULL) {
+        is_success = stream_grab(priv, data, error);
+    } else if (priv->enable_memread) {
+        is_success = camera_grab_memread(priv, frame != NULL ? frame : data, lent, error);
+    } else {
+        is_success = camera_grab_single(priv, frame != NULL ? frame : data, lent, error);
+    }
+
+    if (frame != NULL) {
+        copy_frame (priv, frame, data);
+        buffer_pool_give (priv->buffer_pool, frame);
+    }
+
+    // 17.10.2026
+    // The receiving thread only flags the first drop, the signal is emitted here in the thread of the caller
+    emit_packets_dropped(camera, priv);
+
+    return is_success;
+}
+
+/**
+ * @brief Grabs the next frame like "uca_camera_grab", but lends the buffer of the decoded image instead of copying it
+ *
+ * The buffer is taken from the frame buffer pool of the camera and has to be given back with
+ * "uca_phantom_camera_return_frame", once the caller is done with it. With 10G transmission and frame slots, the
+ * decoded image is not copied at all: the buffer of the slot is lent and a buffer of the pool takes its place. In every
+ * other mode the image is grabbed into the pool buffer directly, which costs the same as "grab".
+ *
+ * A possibly corrupted frame (UCA_PHANTOM_CAMERA_ERROR_MAYBE_CORRUPTED) is lent as well, even though FALSE is returned.
+ * If no frame could be grabbed at all, @p frame is set to NULL.
+ *
+ * The frames can be returned in any order and from any thread. They stay valid across the readouts, until the camera
+ * object is destroyed.
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * Changed 17.10.2026
+ * While streaming, the frames of the frame queue are lent.
+ *
+ * Changed 17.10.2026
+ * The lent buffer is passed to "grab" per thread (see "lend_target"), instead of through the camera object.
+ *
+ * Changed 17.10.2026
+ * With "has-float-output" the lent frames are float, while "grab" delivers them as 16 bit.
+ *
+ * @param camera
+ * @param frame The lent buffer with the image in the format, which "grab" would have delivered, or as float
+ * @param error
+ * @return
+ */
+gboolean
+uca_phantom_camera_lend_frame (UcaPhantomCamera *camera,
+                               gpointer *frame,
+                               GError **error)
+{
+    UcaPhantomCameraPrivate *priv;
+    GError *tmp_error = NULL;
+    gboolean is_success;
+    gpointer lent;
+
+    g_return_val_if_fail (UCA_IS_PHANTOM_CAMERA (camera), FALSE);
+    g_return_val_if_fail (frame != NULL, FALSE);
     priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
 
-    if (priv->enable_memread) {
-        camera_grab_memread(priv, data, error);
+    // The streaming thread has grabbed the frames into buffers of the pool already
+    if (priv->stream != NULL)
+        return stream_take (priv->stream, frame, error);
+
+    lent = buffer_pool_take (priv->buffer_pool, get_frame_buffer_size (priv), priv->xg_numa_node);
+    g_private_set (&lend_target, &lent);
+    is_success = uca_camera_grab (UCA_CAMERA (camera), lent, &tmp_error);
+    g_private_set (&lend_target, NULL);
+
+    // A possibly corrupted frame is delivered by "grab" as well
+    if (is_success ||
+        g_error_matches (tmp_error, UCA_PHANTOM_CAMERA_ERROR, UCA_PHANTOM_CAMERA_ERROR_MAYBE_CORRUPTED)) {
+        *frame = lent;
     } else {
-        camera_grab_single(priv, data, error);
+        buffer_pool_give (priv->buffer_pool, lent);
+        *frame = NULL;
     }
+
+    if (tmp_error != NULL)
+        g_propagate_error (error, tmp_error);
+
+    return is_success;
+}
+
+/**
+ * @brief Gives a frame, which has been lent by "uca_phantom_camera_lend_frame", back to the camera
+ *
+ * CHANGELOG
+ *
+ * Added 17.10.2026
+ *
+ * @param camera
+ * @param frame
+ */
+void
+uca_phantom_camera_return_frame (UcaPhantomCamera *camera,
+                                 gpointer frame)
+{
+    UcaPhantomCameraPrivate *priv;
+
+    g_return_if_fail (UCA_IS_PHANTOM_CAMERA (camera));
+    priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (camera);
+
+    if (frame != NULL)
+        buffer_pool_give (priv->buffer_pool, frame);
 }
 
 // ****************
@@ -3387,11 +9617,21 @@ uca_phantom_camera_set_property (GObject *object,
                 g_free (val);
             }
             break;
+        // 17.10.2026
+        // The reference frames of the correction have been loaded for the ROI of the running readout
         case PROP_ROI_WIDTH:
+            if (is_correcting (priv) && g_value_get_uint (value) != priv->roi_width) {
+                g_warning ("The ROI cannot be changed, while the images are being corrected");
+                break;
+            }
             priv->roi_width = g_value_get_uint (value);
             phantom_set_resolution_by_name (priv, "defc.res", priv->roi_width, priv->roi_height);
             break;
         case PROP_ROI_HEIGHT:
+            if (is_correcting (priv) && g_value_get_uint (value) != priv->roi_height) {
+                g_warning ("The ROI cannot be changed, while the images are being corrected");
+                break;
+            }
             priv->roi_height = g_value_get_uint (value);
             phantom_set_resolution_by_name (priv, "defc.res", priv->roi_width, priv->roi_height);
             break;
@@ -3470,6 +9710,160 @@ uca_phantom_camera_set_property (GObject *object,
         case PROP_EXTERNAL_TRIGGER:
             priv->triggered_externally = g_value_get_boolean(value);
             break;
+        // 17.10.2026
+        // The amount of receive threads is only used when the next readout is started
+        case PROP_RECEIVE_THREADS:
+            priv->receive_threads = g_value_get_uint(value);
+            break;
+        // 17.10.2026
+        // Just like the amount of receive threads, the ring geometry only takes effect with the next readout
+        // 17.10.2026
+        // The kernel only accepts blocks, which consist of whole pages. A block, which cannot hold a single packet of
+        // the interface MTU, would truncate the packets.
+        case PROP_RING_BLOCK_SIZE:
+            {
+                guint block_size = g_value_get_uint(value);
+                guint page_size = sysconf(_SC_PAGESIZE);
+                guint packet_size = TPACKET_ALIGN(TPACKET3_HDRLEN + ETH_HLEN + get_interface_mtu(priv->iface));
+
+                if (block_size != 0 && (block_size % page_size != 0 || block_size < packet_size)) {
+                    g_warning("A ring block size of %u bytes is not a multiple of the page size (%u) or cannot hold a "
+                              "packet of %u bytes", block_size, page_size, packet_size);
+                    break;
+                }
+
+                priv->ring_block_size = block_size;
+            }
+            break;
+        case PROP_RING_BLOCK_COUNT:
+            priv->ring_block_amount = g_value_get_uint(value);
+            break;
+        case PROP_RING_RETIRE_TIMEOUT:
+            priv->ring_retire_timeout = g_value_get_uint(value);
+            break;
+        // 17.10.2026
+        // Takes effect with the next readout
+        case PROP_ZERO_COPY:
+            priv->zero_copy = g_value_get_boolean(value);
+            break;
+        // 17.10.2026
+        // Used for the packet filter of the next readout
+        case PROP_XIMG_SOURCE_MAC:
+            {
+                guint8 mac[6];
+                const gchar *string = g_value_get_string(value);
+
+                if (string != NULL && string[0] != '\0' && !parse_mac_address(string, mac)) {
+                    g_warning("`%s' is not a valid MAC address", string);
+                    break;
+                }
+
+                g_free(priv->ximg_source_mac);
+                priv->ximg_source_mac = g_strdup(string != NULL ? string : "");
+            }
+            break;
+        // 17.10.2026
+        // Both take effect with the next readout
+        case PROP_RECEIVE_BACKEND:
+            priv->receive_backend = g_value_get_enum(value);
+            break;
+        case PROP_XDP_QUEUE:
+            priv->xdp_queue = g_value_get_uint(value);
+            break;
+        // 17.10.2026
+        // Takes effect with the next readout as well
+        case PROP_XIMG_CAPTURE_FILE:
+            g_free(priv->ximg_capture_file);
+            priv->ximg_capture_file = g_value_dup_string(value);
+            if (priv->ximg_capture_file == NULL)
+                priv->ximg_capture_file = g_strdup("");
+            break;
+        // 17.10.2026
+        // Selecting the unpacking kernels explicitly, for example to compare them. Kernels, which the CPU does not
+        // support, are refused.
+        case PROP_UNPACK_KERNEL:
+            {
+                const UnpackKernels *kernels = find_unpack_kernels(g_value_get_string(value));
+
+                if (kernels != NULL)
+                    priv->xg_unpack = kernels;
+                else
+                    g_warning("The unpack kernel \"%s\" is not supported by this CPU", g_value_get_string(value));
+            }
+            break;
+        // 17.10.2026
+        // Takes effect with the next readout, only if the image format is P8
+        case PROP_ENABLE_8BIT_OUTPUT:
+            priv->enable_8bit_output = g_value_get_boolean(value);
+            break;
+        // 17.10.2026
+        // The reference frames are loaded with the next readout
+        case PROP_DARK_FRAME_FILE:
+            g_free(priv->dark_frame_file);
+            priv->dark_frame_file = g_value_dup_string(value);
+            if (priv->dark_frame_file == NULL)
+                priv->dark_frame_file = g_strdup("");
+            break;
+        case PROP_FLAT_FRAME_FILE:
+            g_free(priv->flat_frame_file);
+            priv->flat_frame_file = g_value_dup_string(value);
+            if (priv->flat_frame_file == NULL)
+                priv->flat_frame_file = g_strdup("");
+            break;
+        // 17.10.2026
+        // The frame buffers of the running readout have been allocated for its pixel size
+        case PROP_ENABLE_FLOAT_OUTPUT:
+            if (is_correcting (priv) && g_value_get_boolean (value) != priv->enable_float_output) {
+                g_warning ("The float output cannot be changed, while the images are being corrected");
+                break;
+            }
+            priv->enable_float_output = g_value_get_boolean(value);
+            break;
+        // 17.10.2026
+        // The decode pool is started with the next readout
+        case PROP_DECODE_THREADS:
+            priv->decode_threads = g_value_get_uint(value);
+            break;
+        // 17.10.2026
+        // The frame slots are allocated with the next readout
+        case PROP_FRAME_SLOTS:
+            priv->frame_slots = g_value_get_uint(value);
+            break;
+        // 17.10.2026
+        // Read by the waiting threads every time they start to wait, so it takes effect right away
+        case PROP_WAIT_SPIN_TIME:
+            priv->wait_spin_time = g_value_get_uint(value);
+            break;
+        // 17.10.2026
+        // The streaming thread is started with the next recording
+        case PROP_ENABLE_STREAMING:
+            priv->enable_streaming = g_value_get_boolean(value);
+            break;
+        case PROP_STREAMING_QUEUE_LENGTH:
+            priv->streaming_queue_length = g_value_get_uint(value);
+            break;
+        case PROP_STREAMING_POLICY:
+            priv->streaming_policy = g_value_get_enum(value);
+            break;
+        // 17.10.2026
+        // Takes effect with the next readout
+        case PROP_REQUEST_PIPELINE_DEPTH:
+            priv->request_pipeline_depth = g_value_get_uint(value);
+            break;
+        // 17.10.2026
+        // Takes effect with the next readout, 0 adapts the chunks to the ring
+        case PROP_MEMREAD_CHUNK_SIZE:
+            priv->memread_chunk_size = g_value_get_uint(value);
+            break;
+        case PROP_MEMREAD_PREFETCH:
+            priv->memread_prefetch = g_value_get_uint(value);
+            break;
+        case PROP_STATUS_POLL_INTERVAL:
+            priv->status_poll_interval = g_value_get_uint(value);
+            break;
+        case PROP_STATUS_POLL_MAX_INTERVAL:
+            priv->status_poll_max_interval = g_value_get_uint(value);
+            break;
         // 22.07.2019
         // A boolean flag, with which the memgate function can be disabled. The memgate function is when a HIGH signal
         // on the first programmable IO port of the camera interrupts the saving of all frames to the cine memory.
@@ -3559,8 +9953,12 @@ uca_phantom_camera_get_property (GObject *object,
     }
 
     switch (property_id) {
+        // 17.10.2026
+        // The size of the grab buffers is derived from the bit depth, thus it has to match the output format
+        // 17.10.2026
+        // The float output is reported by "has-float-output", the bit depth stays the one of the pixels.
         case PROP_SENSOR_BITDEPTH:
-            g_value_set_uint (value, 12);
+            g_value_set_uint (value, has_8bit_output (priv) ? 8 : 12);
             break;
         case PROP_ROI_WIDTH:
             g_value_set_uint (value, priv->roi_width);
@@ -3622,8 +10020,10 @@ uca_phantom_camera_get_property (GObject *object,
             else
                 g_value_set_string (value, priv->iface);
             break;
+        // 17.10.2026
+        // Live frames can be streamed, see "STREAMING"
         case PROP_HAS_STREAMING:
-            g_value_set_boolean (value, FALSE);
+            g_value_set_boolean (value, TRUE);
             break;
         case PROP_HAS_CAMRAM_RECORDING:
             g_value_set_boolean (value, TRUE);
@@ -3655,6 +10055,119 @@ uca_phantom_camera_get_property (GObject *object,
         case PROP_TRIGGER_SOURCE:
             g_value_set_enum(value, priv->uca_trigger_source);
             break;
+        // 17.10.2026
+        case PROP_RECEIVE_THREADS:
+            g_value_set_uint(value, priv->receive_threads);
+            break;
+        case PROP_RECEIVE_STATISTICS:
+            g_value_take_string(value, get_receive_statistics(priv));
+            break;
+        case PROP_RING_BLOCK_SIZE:
+            g_value_set_uint(value, priv->ring_block_size);
+            break;
+        case PROP_RING_BLOCK_COUNT:
+            g_value_set_uint(value, priv->ring_block_amount);
+            break;
+        case PROP_RING_RETIRE_TIMEOUT:
+            g_value_set_uint(value, priv->ring_retire_timeout);
+            break;
+        case PROP_RING_GEOMETRY:
+            g_value_take_string(value, get_ring_geometry_description(priv));
+            break;
+        case PROP_RING_PACKETS:
+            g_value_set_uint64(value, priv->xg_kernel_packets);
+            break;
+        case PROP_RING_DROPS:
+            g_value_set_uint64(value, priv->xg_kernel_drops);
+            break;
+        case PROP_RING_FREEZE_COUNT:
+            g_value_set_uint64(value, priv->xg_kernel_freezes);
+            break;
+        case PROP_RING_LOSING_BLOCKS:
+            g_value_set_uint64(value, priv->xg_losing_blocks);
+            break;
+        case PROP_RING_USER_BLOCKS_MAX:
+            g_value_set_uint(value, priv->xg_user_blocks_max);
+            break;
+        case PROP_RING_LOCKED_MEMORY:
+            {
+                struct ring_geometry geometry = priv->xg_geometry;
+
+                if (geometry.block_amount == 0)
+                    compute_ring_geometry(priv, &geometry);
+
+                g_value_set_uint64(value, get_ring_locked_memory(&geometry));
+            }
+            break;
+        case PROP_ZERO_COPY:
+            g_value_set_boolean(value, priv->zero_copy);
+            break;
+        case PROP_XIMG_SOURCE_MAC:
+            g_value_set_string(value, priv->ximg_source_mac);
+            break;
+        case PROP_RECEIVE_BACKEND:
+            g_value_set_enum(value, priv->receive_backend);
+            break;
+        case PROP_XDP_QUEUE:
+            g_value_set_uint(value, priv->xdp_queue);
+            break;
+        case PROP_XIMG_CAPTURE_FILE:
+            g_value_set_string(value, priv->ximg_capture_file);
+            break;
+        case PROP_UNPACK_KERNEL:
+            g_value_set_string(value, priv->xg_unpack->name);
+            break;
+        case PROP_ENABLE_8BIT_OUTPUT:
+            g_value_set_boolean(value, priv->enable_8bit_output);
+            break;
+        case PROP_DARK_FRAME_FILE:
+            g_value_set_string(value, priv->dark_frame_file);
+            break;
+        case PROP_FLAT_FRAME_FILE:
+            g_value_set_string(value, priv->flat_frame_file);
+            break;
+        case PROP_ENABLE_FLOAT_OUTPUT:
+            g_value_set_boolean(value, priv->enable_float_output);
+            break;
+        case PROP_HAS_FLOAT_OUTPUT:
+            g_value_set_boolean(value, has_float_output(priv));
+            break;
+        case PROP_DECODE_THREADS:
+            g_value_set_uint(value, priv->decode_threads);
+            break;
+        case PROP_FRAME_SLOTS:
+            g_value_set_uint(value, priv->frame_slots);
+            break;
+        case PROP_WAIT_SPIN_TIME:
+            g_value_set_uint(value, priv->wait_spin_time);
+            break;
+        case PROP_ENABLE_STREAMING:
+            g_value_set_boolean(value, priv->enable_streaming);
+            break;
+        case PROP_STREAMING_QUEUE_LENGTH:
+            g_value_set_uint(value, priv->streaming_queue_length);
+            break;
+        case PROP_STREAMING_POLICY:
+            g_value_set_enum(value, priv->streaming_policy);
+            break;
+        case PROP_STREAMING_DROPPED_FRAMES:
+            g_value_set_uint64(value, priv->streaming_dropped_frames);
+            break;
+        case PROP_REQUEST_PIPELINE_DEPTH:
+            g_value_set_uint(value, priv->request_pipeline_depth);
+            break;
+        case PROP_MEMREAD_CHUNK_SIZE:
+            g_value_set_uint(value, priv->memread_chunk_size);
+            break;
+        case PROP_MEMREAD_PREFETCH:
+            g_value_set_uint(value, priv->memread_prefetch);
+            break;
+        case PROP_STATUS_POLL_INTERVAL:
+            g_value_set_uint(value, priv->status_poll_interval);
+            break;
+        case PROP_STATUS_POLL_MAX_INTERVAL:
+            g_value_set_uint(value, priv->status_poll_max_interval);
+            break;
         // 05.11.2019
         // This property will return the maximum number of frames that can be fit into the primary cine memory.
         case PROP_MAX_FRAMES:
@@ -3733,8 +10246,11 @@ uca_phantom_camera_dispose (GObject *object)
         g_object_unref (priv->listener);
 
     g_object_unref (priv->client);
-    g_async_queue_unref (priv->message_queue);
-    g_async_queue_unref (priv->result_queue);
+    handoff_teardown (priv->message_queue);
+    handoff_teardown (priv->result_queue);
+    handoff_teardown (priv->unpack_queue);
+    g_free (priv->xg_progress);
+    ximg_stages_teardown (priv);
 
     G_OBJECT_CLASS (uca_phantom_camera_parent_class)->dispose (object);
 }
@@ -3747,8 +10263,15 @@ uca_phantom_camera_finalize (GObject *object)
     priv = UCA_PHANTOM_CAMERA_GET_PRIVATE (object);
     g_regex_unref (priv->response_pattern);
     g_regex_unref (priv->res_pattern);
-    g_free (priv->buffer);
+    buffer_pool_teardown (priv->buffer_pool);
+    g_mutex_clear (&priv->talk_mutex);
+    g_mutex_clear (&priv->xg_backend_mutex);
     g_free (priv->features);
+    g_free (priv->ximg_source_mac);
+    g_free (priv->ximg_capture_file);
+    g_free (priv->dark_frame_file);
+    g_free (priv->flat_frame_file);
+    stop_correction (priv);
 
     // This causes the segmentation fault at the end
     //g_free (priv->iface);
@@ -4096,6 +10619,266 @@ uca_phantom_camera_class_init (UcaPhantomCameraClass *klass)
                                "The maximum number of frames fitting into the primary cine partition",
                                0, G_MAXUINT, 0, G_PARAM_READABLE);
 
+    // 17.10.2026
+    // The amount of receiver threads for the 10G reception. Every thread drains one ring of a PACKET_FANOUT group.
+    phantom_properties[PROP_RECEIVE_THREADS] =
+            g_param_spec_uint ("receive-threads",
+                               "Number of 10G receive threads, each draining one ring of a packet fanout group",
+                               "Number of 10G receive threads, each draining one ring of a packet fanout group",
+                               1, 16, 1, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_RECEIVE_STATISTICS] =
+            g_param_spec_string ("receive-statistics",
+                                 "Packet, byte, block and drop counts of each 10G receive ring",
+                                 "Packet, byte, block and drop counts of each 10G receive ring",
+                                 "", G_PARAM_READABLE);
+
+    // 17.10.2026
+    // The geometry of the 10G ring buffer. For block size and block count 0 means, that the value is derived from the
+    // image size, the memread chunk size and the MTU of the interface.
+    phantom_properties[PROP_RING_BLOCK_SIZE] =
+            g_param_spec_uint ("ring-block-size",
+                               "Size of a 10G ring buffer block in bytes, 0 for automatic sizing",
+                               "Size of a 10G ring buffer block in bytes, 0 for automatic sizing",
+                               0, 1 << 30, 0, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_RING_BLOCK_COUNT] =
+            g_param_spec_uint ("ring-block-count",
+                               "Total number of 10G ring buffer blocks, 0 for automatic sizing",
+                               "Total number of 10G ring buffer blocks, 0 for automatic sizing",
+                               0, G_MAXUINT, 0, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_RING_RETIRE_TIMEOUT] =
+            g_param_spec_uint ("ring-retire-timeout",
+                               "Time in ms after which the kernel hands a partially filled ring block to the plugin",
+                               "Time in ms after which the kernel hands a partially filled ring block to the plugin",
+                               1, 1000, 1, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_RING_GEOMETRY] =
+            g_param_spec_string ("ring-geometry",
+                                 "Geometry of the 10G ring buffer used by the current or next readout",
+                                 "Geometry of the 10G ring buffer used by the current or next readout",
+                                 "", G_PARAM_READABLE);
+
+    phantom_properties[PROP_RING_LOCKED_MEMORY] =
+            g_param_spec_uint64 ("ring-locked-memory",
+                                 "Bytes of memory locked by the 10G ring buffer of the current or next readout",
+                                 "Bytes of memory locked by the 10G ring buffer of the current or next readout",
+                                 0, G_MAXUINT64, 0, G_PARAM_READABLE);
+
+    // 17.10.2026
+    // Decoding the 10G packets directly from the ring buffer into the grab buffer
+    phantom_properties[PROP_ZERO_COPY] =
+            g_param_spec_boolean ("zero-copy",
+                                  "Decode 10G P10/P12L/P8 packets directly into the grab buffer",
+                                  "Decode 10G P10/P12L/P8 packets directly into the grab buffer",
+                                  FALSE, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // Only the ximg packets from this MAC address are accepted by the 10G reception
+    phantom_properties[PROP_XIMG_SOURCE_MAC] =
+            g_param_spec_string ("ximg-source-mac",
+                                 "MAC address of the camera's 10G port, looked up in the ARP table if empty",
+                                 "MAC address of the camera's 10G port, looked up in the ARP table if empty",
+                                 "", G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // Choosing between the packet mmap and the AF_XDP backend for the 10G reception
+    phantom_properties[PROP_RECEIVE_BACKEND] =
+            g_param_spec_enum ("receive-backend",
+                               "Backend used to receive the 10G packets",
+                               "Backend used to receive the 10G packets",
+                               g_enum_register_static ("receive-backend", receive_backend_values),
+                               RECEIVE_BACKEND_PACKET_MMAP, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_XDP_QUEUE] =
+            g_param_spec_uint ("xdp-queue",
+                               "Receive queue of the 10G interface served by the AF_XDP backend",
+                               "Receive queue of the 10G interface served by the AF_XDP backend",
+                               0, 1023, 0, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The kernel statistics of the 10G reception. They are sampled after every frame and reset, when the next readout
+    // sets up the receiving socket.
+    phantom_properties[PROP_RING_PACKETS] =
+            g_param_spec_uint64 ("ring-packets",
+                                 "Packets received by the 10G socket(s) according to the kernel",
+                                 "Packets received by the 10G socket(s) according to the kernel",
+                                 0, G_MAXUINT64, 0, G_PARAM_READABLE);
+
+    phantom_properties[PROP_RING_DROPS] =
+            g_param_spec_uint64 ("ring-drops",
+                                 "Packets dropped by the kernel, because the 10G ring buffer was full",
+                                 "Packets dropped by the kernel, because the 10G ring buffer was full",
+                                 0, G_MAXUINT64, 0, G_PARAM_READABLE);
+
+    phantom_properties[PROP_RING_FREEZE_COUNT] =
+            g_param_spec_uint64 ("ring-freeze-count",
+                                 "Number of times the kernel froze the 10G ring buffer queue",
+                                 "Number of times the kernel froze the 10G ring buffer queue",
+                                 0, G_MAXUINT64, 0, G_PARAM_READABLE);
+
+    phantom_properties[PROP_RING_LOSING_BLOCKS] =
+            g_param_spec_uint64 ("ring-losing-blocks",
+                                 "Number of 10G ring buffer blocks flagged with TP_STATUS_LOSING",
+                                 "Number of 10G ring buffer blocks flagged with TP_STATUS_LOSING",
+                                 0, G_MAXUINT64, 0, G_PARAM_READABLE);
+
+    phantom_properties[PROP_RING_USER_BLOCKS_MAX] =
+            g_param_spec_uint ("ring-user-blocks-max",
+                               "Highest number of 10G ring buffer blocks waiting to be processed by the plugin",
+                               "Highest number of 10G ring buffer blocks waiting to be processed by the plugin",
+                               0, G_MAXUINT, 0, G_PARAM_READABLE);
+
+    // 17.10.2026
+    // Emitted with the amount of dropped packets by the first "grab" after the kernel has dropped packets
+    phantom_signals[SIGNAL_PACKETS_DROPPED] =
+            g_signal_new ("packets-dropped",
+                          G_TYPE_FROM_CLASS (klass), G_SIGNAL_RUN_LAST,
+                          0, NULL, NULL, NULL,
+                          G_TYPE_NONE, 1, G_TYPE_UINT64);
+
+    // 17.10.2026
+    // The packets of the single packet mmap ring are captured into this file, the replay backend reads them from it
+    phantom_properties[PROP_XIMG_CAPTURE_FILE] =
+            g_param_spec_string ("ximg-capture-file",
+                                 "Pcap file to capture the 10G packets into, or to replay them from",
+                                 "Pcap file to capture the 10G packets into, or to replay them from",
+                                 "", G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The instruction set used to unpack P10 and P12L, see "UNPACKING KERNELS"
+    phantom_properties[PROP_UNPACK_KERNEL] =
+            g_param_spec_string ("unpack-kernel",
+                                 "Kernel to unpack P10/P12L/P8 with (avx512, avx2, ssse3 or scalar)",
+                                 "Kernel to unpack P10/P12L/P8 with (avx512, avx2, ssse3 or scalar)",
+                                 "", G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // Delivering P8 images with one byte per pixel
+    phantom_properties[PROP_ENABLE_8BIT_OUTPUT] =
+            g_param_spec_boolean ("enable-8bit-output",
+                                  "Deliver P8 images with 8 bits per pixel, sensor-bitdepth is 8 then",
+                                  "Deliver P8 images with 8 bits per pixel, sensor-bitdepth is 8 then",
+                                  FALSE, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The dark/flat correction while unpacking, see "DARK/FLAT CORRECTION"
+    phantom_properties[PROP_DARK_FRAME_FILE] =
+            g_param_spec_string ("dark-frame-file",
+                                 "File with raw 16 bit dark frames, which are subtracted from every image",
+                                 "File with raw 16 bit dark frames, which are subtracted from every image",
+                                 "", G_PARAM_READWRITE);
+
+    phantom_properties[PROP_FLAT_FRAME_FILE] =
+            g_param_spec_string ("flat-frame-file",
+                                 "File with raw 16 bit flat frames, with which every image is normalized",
+                                 "File with raw 16 bit flat frames, with which every image is normalized",
+                                 "", G_PARAM_READWRITE);
+
+    phantom_properties[PROP_ENABLE_FLOAT_OUTPUT] =
+            g_param_spec_boolean ("enable-float-output",
+                                  "Lend the corrected images as float, if the format allows it, grab stays 16 bit",
+                                  "Lend the corrected images as float, if the format allows it, grab stays 16 bit",
+                                  FALSE, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // Whether the lent frames have 4 bytes per pixel, because the images are actually delivered as float
+    phantom_properties[PROP_HAS_FLOAT_OUTPUT] =
+            g_param_spec_boolean ("has-float-output",
+                                  "Whether the lent images are float with 4 bytes per pixel",
+                                  "Whether the lent images are float with 4 bytes per pixel",
+                                  FALSE, G_PARAM_READABLE);
+
+    // 17.10.2026
+    // The amount of threads unpacking a 10G frame, see "PARALLEL DECODING"
+    phantom_properties[PROP_DECODE_THREADS] =
+            g_param_spec_uint ("decode-threads",
+                               "Number of threads unpacking each 10G frame in stripes, without zero copy decoding",
+                               "Number of threads unpacking each 10G frame in stripes, without zero copy decoding",
+                               1, 64, 1, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The amount of 10G frames in flight in memread mode, see "FRAME SLOTS"
+    phantom_properties[PROP_FRAME_SLOTS] =
+            g_param_spec_uint ("frame-slots",
+                               "Number of 10G frames in flight in memread mode, without zero copy decoding",
+                               "Number of 10G frames in flight in memread mode, without zero copy decoding",
+                               1, 16, 1, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // How long the unpack thread spins, before it sleeps until more data has been received, see "WAITING FOR PROGRESS"
+    phantom_properties[PROP_WAIT_SPIN_TIME] =
+            g_param_spec_uint ("wait-spin-time",
+                               "Time in microseconds to spin while waiting for 10G data, before sleeping",
+                               "Time in microseconds to spin while waiting for 10G data, before sleeping",
+                               0, 1000000, PROGRESS_SPIN_TIME, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The streaming mode, see "STREAMING"
+    phantom_properties[PROP_ENABLE_STREAMING] =
+            g_param_spec_boolean ("enable-streaming",
+                                  "Grab live frames in the background into a frame queue, needed for transfer-asynchronously",
+                                  "Grab live frames in the background into a frame queue, needed for transfer-asynchronously",
+                                  FALSE, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_STREAMING_QUEUE_LENGTH] =
+            g_param_spec_uint ("streaming-queue-length",
+                               "Number of frames the frame queue of the streaming mode holds",
+                               "Number of frames the frame queue of the streaming mode holds",
+                               1, 256, 4, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_STREAMING_POLICY] =
+            g_param_spec_enum ("streaming-policy",
+                               "What the streaming mode does with a new frame, when the frame queue is full",
+                               "What the streaming mode does with a new frame, when the frame queue is full",
+                               g_enum_register_static ("streaming-policy", streaming_policy_values),
+                               STREAMING_POLICY_DROP_OLDEST, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_STREAMING_DROPPED_FRAMES] =
+            g_param_spec_uint64 ("streaming-dropped-frames",
+                                 "Frames dropped from the full frame queue in the current recording",
+                                 "Frames dropped from the full frame queue in the current recording",
+                                 0, G_MAXUINT64, 0, G_PARAM_READABLE);
+
+    // 17.10.2026
+    // The amount of live frames requested ahead, see "REQUEST PIPELINING"
+    phantom_properties[PROP_REQUEST_PIPELINE_DEPTH] =
+            g_param_spec_uint ("request-pipeline-depth",
+                               "Number of live frames requested ahead outside of memread mode",
+                               "Number of live frames requested ahead outside of memread mode",
+                               1, PIPELINE_MAX_DEPTH, 1, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The amount of frames requested at once in memread mode, see "MEMREAD FLOW CONTROL"
+    phantom_properties[PROP_MEMREAD_CHUNK_SIZE] =
+            g_param_spec_uint ("memread-chunk-size",
+                               "Frames per memread request, 0 to adapt them to the 10G ring",
+                               "Frames per memread request, 0 to adapt them to the 10G ring",
+                               0, G_MAXUINT, 0, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The frames left of the requested chunks, when the next one is requested, see "MEMREAD FLOW CONTROL"
+    phantom_properties[PROP_MEMREAD_PREFETCH] =
+            g_param_spec_uint ("memread-prefetch",
+                               "Frames left when the next memread chunk is requested, 0 for a quarter chunk",
+                               "Frames left when the next memread chunk is requested, 0 for a quarter chunk",
+                               0, G_MAXUINT, 0, G_PARAM_READWRITE);
+
+    // 17.10.2026
+    // The rate limit of the frame count and cine state queries, see "WATCHING THE RECORDING"
+    phantom_properties[PROP_STATUS_POLL_INTERVAL] =
+            g_param_spec_uint ("status-poll-interval",
+                               "Minimum time between two frame count or cine state queries in us",
+                               "Minimum time between two frame count or cine state queries in us",
+                               0, G_USEC_PER_SEC, 2000, G_PARAM_READWRITE);
+
+    phantom_properties[PROP_STATUS_POLL_MAX_INTERVAL] =
+            g_param_spec_uint ("status-poll-max-interval",
+                               "Maximum time between two frame count queries in us, while no frames are recorded",
+                               "Maximum time between two frame count queries in us, while no frames are recorded",
+                               0, 10 * G_USEC_PER_SEC, 100000, G_PARAM_READWRITE);
+
     for (guint i = 0; i < base_overrideables[i]; i++)
         g_object_class_override_property (oclass, base_overrideables[i], uca_camera_props[base_overrideables[i]]);
 
@@ -4141,14 +10924,79 @@ uca_phantom_camera_init (UcaPhantomCamera *self)
     priv->format = IMAGE_FORMAT_P12L;
     priv->acquisition_mode = ACQUISITION_MODE_HS;
     priv->enable_10ge = FALSE;
-    priv->xg_packet_skipped = FALSE;
     priv->iface = NULL;
     priv->ip_address = "";
     priv->have_ximg = TRUE;
-    priv->xg_packet_amount = 0;
     priv->connected = FALSE;
-    priv->message_queue = g_async_queue_new ();
-    priv->result_queue = g_async_queue_new ();
+    priv->receive_threads = 1;
+    priv->xg_fanout = NULL;
+    priv->xg_fd = -1;
+    g_mutex_init (&priv->xg_backend_mutex);
+    priv->ring_block_size = 0;
+    priv->ring_block_amount = 0;
+    priv->ring_retire_timeout = 1;
+    memset (&priv->xg_geometry, 0, sizeof (priv->xg_geometry));
+    priv->zero_copy = FALSE;
+    priv->xg_zero_copy = FALSE;
+    priv->ximg_source_mac = g_strdup ("");
+    priv->receive_backend = RECEIVE_BACKEND_PACKET_MMAP;
+    priv->xdp_queue = 0;
+    priv->xg_xdp = NULL;
+    priv->xg_incomplete_frames = 0;
+    priv->xg_missing_total = 0;
+    priv->xg_kernel_packets = 0;
+    priv->xg_kernel_drops = 0;
+    priv->xg_kernel_freezes = 0;
+    priv->xg_losing_blocks = 0;
+    priv->xg_user_blocks_max = 0;
+    priv->xg_drop_state = 0;
+    priv->ximg_capture_file = g_strdup ("");
+    priv->xg_capture = NULL;
+    priv->xg_replay = NULL;
+    priv->xg_unpack = find_unpack_kernels (NULL);
+    priv->enable_8bit_output = FALSE;
+    priv->dark_frame_file = g_strdup ("");
+    priv->flat_frame_file = g_strdup ("");
+    priv->enable_float_output = FALSE;
+    priv->correction_dark = NULL;
+    priv->correction_gain = NULL;
+    priv->correction_float = FALSE;
+    priv->decode_threads = 1;
+    priv->xg_decode_pool = NULL;
+    priv->frame_slots = 1;
+    priv->xg_slots = NULL;
+    priv->xg_slot_amount = 1;
+    priv->xg_frames_in_flight = 0;
+    priv->memread_pending = 0;
+    priv->xg_progress = g_new0 (struct progress, 1);
+    ximg_stages_setup (priv);
+    priv->wait_spin_time = PROGRESS_SPIN_TIME;
+    priv->message_queue = handoff_setup (sizeof (InternalMessage));
+    priv->result_queue = handoff_setup (sizeof (Result));
+    priv->unpack_queue = handoff_setup (sizeof (InternalMessage));
+    priv->buffer_pool = buffer_pool_setup ();
+    priv->xg_numa_node = -1;
+    priv->enable_streaming = FALSE;
+    priv->streaming_queue_length = 4;
+    priv->streaming_policy = STREAMING_POLICY_DROP_OLDEST;
+    priv->streaming_dropped_frames = 0;
+    priv->stream = NULL;
+    g_mutex_init (&priv->talk_mutex);
+    priv->request_pipeline_depth = 1;
+    priv->xg_pipeline_depth = 1;
+    priv->xg_pipeline_buffered = FALSE;
+    priv->xg_pipeline_amount = 0;
+    priv->memread_chunk_size = 0;
+    priv->memread_prefetch = 0;
+    priv->status_poll_interval = 2000;
+    priv->status_poll_max_interval = 100000;
+    priv->watch_frames = 0;
+    priv->watch_frames_time = 0;
+    priv->watch_released = FALSE;
+    priv->watch_released_time = 0;
+    priv->xg_memread_chunk = MEMREAD_CHUNK_SIZE;
+    priv->xg_memread_drops = 0;
+    priv->xg_ring_fill_peak = 0;
 
     // 26.06.2019
     // The g_getenv functions return the string value of the specified environmental variable name if it exists and
@@ -72,6 +72,12 @@ struct _UcaPhantomCameraClass {
 
 GType uca_phantom_camera_get_type(void);
 
+gboolean uca_phantom_camera_lend_frame (UcaPhantomCamera *camera,
+                                        gpointer *frame,
+                                        GError **error);
+void uca_phantom_camera_return_frame (UcaPhantomCamera *camera,
+                                      gpointer frame);
+
 G_END_DECLS
 
 #endif